@@ -109,6 +109,12 @@ public:
     }
     std::string getEscMeta () const;
     std::string getRawMeta () const;
+
+    /** The serialized metadata, empty if the transaction was not applied. */
+    Blob const& getMetaBlob () const
+    {
+        return mRawMeta;
+    }
     Json::Value getJson ()
     {
         if (mJson == Json::nullValue)
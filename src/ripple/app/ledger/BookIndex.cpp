@@ -0,0 +1,223 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/app/ledger/BookIndex.h>
+#include <ripple/basics/Log.h>
+#include <ripple/ledger/Sandbox.h>
+#include <ripple/ledger/View.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/STAccount.h>
+
+namespace ripple {
+
+BookIndex::Snapshot::Snapshot (
+    std::shared_ptr<ReadView const> const& ledger, beast::Journal j)
+    : ledger_ (ledger)
+    , j_ (j)
+{
+}
+
+BookIndex::Snapshot::Snapshot (
+    std::shared_ptr<ReadView const> const& ledger,
+        Snapshot& parent, beast::Journal j)
+    : Snapshot (ledger, j)
+{
+    auto const& view = *parent.ledger_;
+    if (ledger_->open () || view.open () ||
+            ledger_->info ().parentHash != view.info ().hash)
+        return;
+
+    // The books holding an offer and the accounts holding an entry
+    // that the ledger's transactions created, modified or deleted
+    hash_set<Book> books;
+    hash_set<AccountID> accounts;
+    for (auto const& item : ledger_->txs)
+    {
+        if (! item.second)
+            return;
+
+        for (auto const& node : item.second->getFieldArray (sfAffectedNodes))
+        {
+            auto const& name = (node.getFName () == sfCreatedNode) ?
+                sfNewFields : sfFinalFields;
+            std::shared_ptr<SLE const> sle;
+            if (! node.isFieldPresent (name))
+            {
+                sle = ledger_->read (keylet::unchecked (
+                    node.getFieldH256 (sfLedgerIndex)));
+                if (! sle)
+                    return;
+            }
+            STObject const& fields = sle ? *sle : node.getFieldObject (name);
+
+            if (node.getFieldU16 (sfLedgerEntryType) == ltOFFER)
+                books.insert (Book (
+                    fields.getFieldAmount (sfTakerPays).issue (),
+                    fields.getFieldAmount (sfTakerGets).issue ()));
+
+            for (auto const& field : fields)
+            {
+                if (auto const account = dynamic_cast<STAccount const*> (&field))
+                    accounts.insert (account->value ());
+                else if (field.getFName () == sfLowLimit ||
+                        field.getFName () == sfHighLimit)
+                    accounts.insert (static_cast<STAmount const&> (
+                        field).getIssuer ());
+            }
+        }
+    }
+
+    // What an owner can spend of XRP depends on the reserve
+    bool const sameFees =
+        ledger_->fees ().reserve == view.fees ().reserve &&
+        ledger_->fees ().increment == view.fees ().increment;
+
+    std::lock_guard<std::mutex> lock (parent.mutex_);
+    for (auto const& entry : parent.books_)
+    {
+        if (books.count (entry.first) == 0)
+            books_.emplace (entry);
+    }
+    if (sameFees)
+    {
+        for (auto const& entry : parent.funds_)
+        {
+            // What an asset line holds depends on the close time through
+            // its release schedule, so compute those again every ledger
+            if (entry.first.second.currency == assetCurrency ())
+                continue;
+
+            if (accounts.count (entry.first.first) == 0 &&
+                    accounts.count (entry.first.second.account) == 0)
+                funds_.emplace_hint (funds_.end (), entry);
+        }
+    }
+
+    JLOG (j_.debug) << "Ledger " << ledger_->info ().seq << " keeps " <<
+        books_.size () << " books, drops " << books.size ();
+}
+
+std::shared_ptr<std::vector<BookIndex::Offer> const>
+BookIndex::Snapshot::offers (Book const& book, std::size_t limit)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto& entry = books_[book];
+    if (! entry.offers ||
+            (! entry.complete && entry.offers->size () < limit))
+        entry.offers = walk (book, limit, entry.complete);
+    return entry.offers;
+}
+
+STAmount
+BookIndex::Snapshot::ownerFunds (AccountID const& owner, Issue const& issue)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto const key = std::make_pair (owner, issue);
+    auto const iter = funds_.find (key);
+    if (iter != funds_.end ())
+        return iter->second;
+
+    Sandbox view (&*ledger_, tapNONE);
+    auto funds = accountHolds (view, owner, issue.currency,
+        issue.account, fhZERO_IF_FROZEN, j_);
+
+    // Treat negative funds as zero.
+    if (funds < zero)
+        funds.clear ();
+
+    funds_.emplace (key, funds);
+    return funds;
+}
+
+std::shared_ptr<std::vector<BookIndex::Offer> const>
+BookIndex::Snapshot::walk (
+    Book const& book, std::size_t limit, bool& complete) const
+{
+    auto result = std::make_shared<std::vector<Offer>> ();
+    auto const& view = *ledger_;
+    uint256 const bookEnd = getQualityNext (getBookBase (book));
+    uint256 tip = getBookBase (book);
+
+    complete = false;
+    while (auto const dirIndex = view.succ (tip, bookEnd))
+    {
+        tip = *dirIndex;
+        auto dir = view.read (keylet::page (tip));
+        if (! dir)
+            break;
+
+        auto const quality = amountFromQuality (getQuality (tip));
+        unsigned int entry;
+        uint256 offerIndex;
+        bool more = cdirFirst (view, tip, dir, entry, offerIndex, j_);
+        while (more)
+        {
+            if (result->size () >= limit)
+                return result;
+
+            if (auto sle = view.read (keylet::offer (offerIndex)))
+            {
+                auto json = sle->getJson (0);
+                result->push_back ({std::move (sle), quality, std::move (json)});
+            }
+            else
+            {
+                JLOG (j_.warning) << "Missing offer " << offerIndex;
+            }
+
+            more = cdirNext (view, tip, dir, entry, offerIndex, j_);
+        }
+    }
+
+    complete = true;
+    return result;
+}
+
+//------------------------------------------------------------------------------
+
+std::shared_ptr<BookIndex::Snapshot>
+BookIndex::get (std::shared_ptr<ReadView const> const& ledger)
+{
+    if (ledger->open ())
+        return std::make_shared<Snapshot> (ledger, j_);
+
+    auto const& info = ledger->info ();
+    auto const key = std::make_pair (info.seq, info.hash);
+
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto const iter = snapshots_.find (key);
+    if (iter != snapshots_.end ())
+        return iter->second;
+
+    std::shared_ptr<Snapshot> snapshot;
+    auto const parent = snapshots_.find (
+        std::make_pair (info.seq - 1, info.parentHash));
+    if (parent != snapshots_.end ())
+        snapshot = std::make_shared<Snapshot> (ledger, *parent->second, j_);
+    else
+        snapshot = std::make_shared<Snapshot> (ledger, j_);
+
+    snapshots_.emplace (key, snapshot);
+    while (snapshots_.size () > maxLedgers)
+        snapshots_.erase (snapshots_.begin ());
+    return snapshot;
+}
+
+} // ripple
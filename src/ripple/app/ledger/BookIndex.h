@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_BOOKINDEX_H_INCLUDED
+#define RIPPLE_APP_LEDGER_BOOKINDEX_H_INCLUDED
+
+#include <ripple/ledger/ReadView.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/json/json_value.h>
+#include <ripple/protocol/Book.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/STLedgerEntry.h>
+#include <beast/utility/Journal.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+/** Quality ordered offers and owner funds for the books of recent ledgers.
+
+    book_offers reads the same few books over and over. Each snapshot
+    remembers the offers it walked, with their rendered JSON, and the
+    funds of the owners it looked up. The snapshot of a closed ledger
+    starts from the snapshot of its parent, dropping only the books and
+    owners touched by the ledger's transactions.
+*/
+class BookIndex
+{
+public:
+    struct Offer
+    {
+        std::shared_ptr<SLE const> sle;
+        STAmount quality;
+        Json::Value json;
+    };
+
+    class Snapshot
+    {
+    public:
+        explicit
+        Snapshot (std::shared_ptr<ReadView const> const& ledger,
+            beast::Journal j);
+
+        Snapshot (std::shared_ptr<ReadView const> const& ledger,
+            Snapshot& parent, beast::Journal j);
+
+        Snapshot (Snapshot const&) = delete;
+        Snapshot& operator= (Snapshot const&) = delete;
+
+        std::shared_ptr<ReadView const> const&
+        ledger () const
+        {
+            return ledger_;
+        }
+
+        /** Returns at least the first limit offers of a book, best first.
+            Fewer are returned only if the book holds fewer.
+        */
+        std::shared_ptr<std::vector<Offer> const>
+        offers (Book const& book, std::size_t limit);
+
+        /** Returns what an owner holds of an issue, never negative. */
+        STAmount
+        ownerFunds (AccountID const& owner, Issue const& issue);
+
+    private:
+        struct Entry
+        {
+            std::shared_ptr<std::vector<Offer> const> offers;
+            bool complete = false;
+        };
+
+        std::shared_ptr<std::vector<Offer> const>
+        walk (Book const& book, std::size_t limit, bool& complete) const;
+
+        std::shared_ptr<ReadView const> ledger_;
+        beast::Journal j_;
+        std::mutex mutex_;
+        hash_map<Book, Entry> books_;
+        std::map<std::pair<AccountID, Issue>, STAmount> funds_;
+    };
+
+    explicit
+    BookIndex (beast::Journal j)
+        : j_ (j)
+    {
+    }
+
+    BookIndex (BookIndex const&) = delete;
+    BookIndex& operator= (BookIndex const&) = delete;
+
+    /** Returns the snapshot for a ledger.
+        Closed ledgers are remembered, open ones get a private snapshot.
+    */
+    std::shared_ptr<Snapshot>
+    get (std::shared_ptr<ReadView const> const& ledger);
+
+private:
+    // Number of closed ledgers we keep snapshots for
+    static std::size_t const maxLedgers = 8;
+
+    beast::Journal j_;
+    std::mutex mutex_;
+    std::map<std::pair<LedgerIndex, uint256>,
+        std::shared_ptr<Snapshot>> snapshots_;
+};
+
+} // ripple
+
+#endif
@@ -36,10 +36,8 @@ void BookListeners::removeSubscriber (std::uint64_t seq)
     mListeners.erase (seq);
 }
 
-void BookListeners::publish (Json::Value const& jvObj)
+void BookListeners::publish (StreamMessage& message)
 {
-    std::string sObj = to_string (jvObj);
-
     std::lock_guard <std::recursive_mutex> sl (mLock);
     auto it = mListeners.cbegin ();
 
@@ -49,7 +47,7 @@ void BookListeners::publish (Json::Value const& jvObj)
 
         if (p)
         {
-            p->send (jvObj, sObj, true);
+            message.send (*p, true);
             ++it;
         }
         else
@@ -21,6 +21,7 @@
 #define RIPPLE_APP_LEDGER_BOOKLISTENERS_H_INCLUDED
 
 #include <ripple/net/InfoSub.h>
+#include <ripple/net/StreamMessage.h>
 #include <memory>
 #include <mutex>
 
@@ -36,7 +37,7 @@ public:
 
     void addSubscriber (InfoSub::ref sub);
     void removeSubscriber (std::uint64_t sub);
-    void publish (Json::Value const& jvObj);
+    void publish (StreamMessage& message);
 
 private:
     std::recursive_mutex mLock;
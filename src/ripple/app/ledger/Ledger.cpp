@@ -22,6 +22,7 @@
 #include <ripple/app/ledger/AcceptedLedger.h>
 #include <ripple/app/ledger/InboundLedgers.h>
 #include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/LedgerPersister.h>
 #include <ripple/app/ledger/LedgerTiming.h>
 #include <ripple/app/ledger/LedgerToJson.h>
 #include <ripple/app/ledger/OrderBookDB.h>
@@ -46,12 +47,14 @@
 #include <ripple/protocol/JsonFields.h>
 #include <ripple/protocol/PublicKey.h>
 #include <ripple/protocol/SecretKey.h>
+#include <ripple/protocol/TxFormats.h>
 #include <ripple/protocol/HashPrefix.h>
 #include <ripple/protocol/types.h>
 #include <beast/module/core/text/LexicalCast.h>
 #include <beast/unit_test/suite.h>
 #include <boost/optional.hpp>
 #include <cassert>
+#include <chrono>
 #include <utility>
 
 namespace ripple {
@@ -272,6 +275,7 @@ Ledger::Ledger (open_ledger_t, Ledger const& prevLedger,
         prevLedger.stateMap_->family()))
     , stateMap_ (prevLedger.stateMap_->snapShot (true))
     , fees_(prevLedger.fees_)
+    , rules_(prevLedger.rules_.presets())
 {
     info_.open = true;
     info_.seq = prevLedger.info_.seq + 1;
@@ -734,7 +738,7 @@ Ledger::setup (Config const& config)
 
     try
     {
-        rules_ = Rules(*this);
+        rules_ = Rules(*this, config.features);
     }
     catch (SHAMapMissingNode &)
     {
@@ -792,6 +796,27 @@ void Ledger::visitStateItems (std::function<void (SLE::ref)> callback) const
     }
 }
 
+void Ledger::visitStateViews (
+    std::function<void (SLEView const&)> callback) const
+{
+    try
+    {
+        if (stateMap_)
+        {
+            stateMap_->visitLeaves(
+                [&callback](std::shared_ptr<SHAMapItem const> const& item)
+                {
+                    callback (SLEView (item, item->slice(), item->key()));
+                });
+        }
+    }
+    catch (SHAMapMissingNode&)
+    {
+        stateMap_->family().missing_node (info_.hash);
+        Throw();
+    }
+}
+
 bool Ledger::walkLedger (beast::Journal j) const
 {
     std::vector <SHAMapMissingNode> missingNodes1;
@@ -930,39 +955,21 @@ void Ledger::updateSkipList ()
 }
 
 static bool saveValidatedLedger (
-    Application& app, std::shared_ptr<Ledger> const& ledger, bool current)
+    Application& app, std::shared_ptr<Ledger> const& ledger, bool current,
+    bool claimed = false)
 {
     auto j = app.journal ("Ledger");
 
-     if (! app.pendingSaves().startWork (ledger->info().seq))
+     if (! claimed && ! app.pendingSaves().startWork (ledger->info().seq))
      {
          // The save was completed synchronously
          JLOG (j.debug) << "Save aborted";
          return true;
      }
 
-    // TODO(tom): Fix this hard-coded SQL!
     JLOG (j.trace)
         << "saveValidatedLedger "
         << (current ? "" : "fromAcquire ") << ledger->info().seq;
-    static boost::format deleteLedger (
-        "DELETE FROM Ledgers WHERE LedgerSeq = %u;");
-    static boost::format deleteTrans1 (
-        "DELETE FROM Transactions WHERE LedgerSeq = %u;");
-    static boost::format deleteTrans2 (
-        "DELETE FROM AccountTransactions WHERE LedgerSeq = %u;");
-    static boost::format deleteAcctTrans (
-        "DELETE FROM AccountTransactions WHERE TransID = '%s';");
-    static boost::format transExists (
-        "SELECT Status FROM Transactions WHERE TransID = '%s';");
-    static boost::format updateTx (
-        "UPDATE Transactions SET LedgerSeq = %u, Status = '%c', TxnMeta = %s "
-        "WHERE TransID = '%s';");
-    static boost::format addLedger (
-        "INSERT OR REPLACE INTO Ledgers "
-        "(LedgerHash,LedgerSeq,PrevHash,TotalCoins,TotalCoinsXRS,ClosingTime,PrevClosingTime,"
-        "CloseTimeRes,CloseFlags,AccountSetHash,TransSetHash) VALUES "
-        "('%s','%u','%s','%s','%s','%u','%u','%d','%u','%s','%s');");
 
     auto seq = ledger->info().seq;
 
@@ -1024,25 +1031,25 @@ static bool saveValidatedLedger (
         return false;
     }
 
-    {
-        auto db = app.getLedgerDB ().checkoutDb();
-        *db << boost::str (deleteLedger % seq);
-    }
+    // Gather the rows, the persister writes them in the background
+    auto const& info = ledger->info ();
+    LedgerRows rows;
+    rows.seq = seq;
+    rows.hash = info.hash;
+    rows.parentHash = info.parentHash;
+    rows.accountHash = info.accountHash;
+    rows.txHash = info.txHash;
+    rows.drops = to_string (info.drops);
+    rows.dropsXRS = to_string (info.dropsXRS);
+    rows.closeTime = info.closeTime;
+    rows.parentCloseTime = info.parentCloseTime;
+    rows.closeTimeResolution = info.closeTimeResolution;
+    rows.closeFlags = info.closeFlags;
+    rows.withTransactions = static_cast<bool> (aLedger);
 
-    try
+    if (aLedger)
     {
-    if (app.getTxnDB ().getType () != DatabaseCon::Type::None)
-    {
-        auto db = app.getTxnDB ().checkoutDb ();
-
-        // @TODO: need to check if batch improvement needed.
-        //db->batchStart();
-        soci::transaction tr(*db);
-
-        *db << boost::str (deleteTrans1 % seq);
-        *db << boost::str (deleteTrans2 % seq);
-
-        std::string const ledgerSeq (std::to_string (seq));
+        rows.transactions.reserve (aLedger->getMap ().size ());
 
         for (auto const& vt : aLedger->getMap ())
         {
@@ -1055,111 +1062,45 @@ static bool saveValidatedLedger (
             app.getMasterTransaction ().inLedger (
                 transactionID, seq);
 
-            std::string const txnId (to_string (transactionID));
-            std::string const txnSeq (std::to_string (vt.second->getTxnSeq ()));
+            auto const& txn = *vt.second->getTxn ();
+            auto const format =
+                TxFormats::getInstance ().findByType (txn.getTxnType ());
+            assert (format != nullptr);
 
-            *db << boost::str (deleteAcctTrans % transactionID);
-
-            auto const& accts = vt.second->getAffected ();
+            Serializer raw;
+            txn.add (raw);
 
-            if (!accts.empty ())
-            {
-                std::string sql (
-                    "INSERT INTO AccountTransactions "
-                    "(TransID, Account, LedgerSeq, TxnSeq) VALUES ");
+            rows.transactions.push_back ({to_string (transactionID),
+                format ? format->getName () : std::string (),
+                toBase58 (txn.getAccountID (sfAccount)),
+                txn.getSequence (), std::move (raw.modData ()),
+                vt.second->getMetaBlob ()});
 
-                // Try to make an educated guess on how much space we'll need
-                // for our arguments. In argument order we have:
-                // 64 + 34 + 10 + 10 = 118 + 10 extra = 128 bytes
-                sql.reserve (sql.length () + (accts.size () * 128));
+            auto const& accts = vt.second->getAffected ();
 
-                bool first = true;
-                for (auto const& account : accts)
-                {
-                    if (!first)
-                        sql += ", ('";
-                    else
-                    {
-                        sql += "('";
-                        first = false;
-                    }
-
-                    sql += txnId;
-                    sql += "','";
-                    sql += app.accountIDCache().toBase58(account);
-                    sql += "',";
-                    sql += ledgerSeq;
-                    sql += ",";
-                    sql += txnSeq;
-                    sql += ")";
-                }
-                sql += ";";
-                if (ShouldLog (lsTRACE, Ledger))
-                {
-                    JLOG (j.trace) << "ActTx: " << sql;
-                }
-                *db << sql;
-            }
-            else
+            if (accts.empty ())
                 JLOG (j.warning)
                     << "Transaction in ledger " << seq
                     << " affects no accounts";
 
-            *db <<
-               (STTx::getMetaSQLInsertReplaceHeader (app.getTxnDB ().getType ()) +
-                vt.second->getTxn ()->getMetaSQL (
-                    seq, vt.second->getEscMeta (), ledger->info ().closeTime) + ";");
-        }
-
-        tr.commit ();
-        //db->batchCommit();
-    }
-
-
-    {
-        auto db (app.getLedgerDB ().checkoutDb ());
-
-        // TODO(tom): ARG!
-        *db << boost::str (
-            addLedger %
-            to_string (ledger->info().hash) % seq % to_string (ledger->info().parentHash) %
-            to_string (ledger->info().drops) % to_string (ledger->info().dropsXRS) % ledger->info().closeTime %
-            ledger->info().parentCloseTime % ledger->info().closeTimeResolution %
-            ledger->info().closeFlags % to_string (ledger->info().accountHash) %
-            to_string (ledger->info().txHash));
-    }
-    }
-    catch (std::exception const& e)
-    {
-        // catch mysql error
-        JLOG (j.fatal) << "Mysql insert accountTransaction exception. " << e.what();
-        app.getLedgerMaster().failedSave(seq, ledger->info().hash);
-
-        if (app.getTxnDB ().startReconnection ())
-        {
-            try
-            {
-                //std::this_thread::sleep_for (std::chrono::seconds (3));
-                app.getTxnDB ().getSession ().reconnect ();
-                app.getTxnDB ().finishReconnection ();
-                JLOG (j.warning) << "Mysql reconncetion success";
-            }
-            catch ( std::exception const& e)
+            for (auto const& account : accts)
             {
-                JLOG (j.fatal) << "Mysql has gone away. And reconnection failed. " << e.what();
-                app.getTxnDB ().finishReconnection ();
+                rows.accountTransactions.push_back ({
+                    rows.transactions.back ().id,
+                    app.accountIDCache().toBase58(account),
+                    vt.second->getTxnSeq ()});
             }
         }
-        app.pendingSaves ().finishWork (seq);
-        return false;
     }
 
-    // Clients can now trust the database for
-    // information about this ledger sequence.
-    app.pendingSaves().finishWork(seq);
+    // The ledger stays pending until its rows are committed
+    app.getLedgerPersister ().save (std::move (rows), current);
     return true;
 }
 
+// How long a synchronous save waits for the database
+static std::chrono::seconds const syncSaveTimeout {60};
+
 /** Save, or arrange to save, a fully-validated ledger
     Returns false on error
 */
@@ -1184,20 +1125,59 @@ bool pendSaveValidated (Application& app,
 
     assert (ledger->isImmutable ());
 
-    if (! app.pendingSaves().shouldWork (ledger->info().seq, isSynchronous))
+    bool resave = false;
+    if (isSynchronous)
     {
-        JLOG (app.journal ("Ledger").debug)
-            << "Pend save with seq in pending saves "
-            << ledger->info().seq;
+        if (! app.pendingSaves().shouldWork (
+            ledger->info().seq, syncSaveTimeout))
+        {
+            JLOG (app.journal ("Ledger").warning)
+                << "Timed out waiting for the save of ledger "
+                << ledger->info().seq;
+            return false;
+        }
+    }
+    else if (! app.pendingSaves().shouldWork (ledger->info().seq, false))
+    {
+        if (app.getLedgerPersister ().pending (
+            ledger->info().seq, ledger->info().hash))
+        {
+            JLOG (app.journal ("Ledger").debug)
+                << "Pend save with seq in pending saves "
+                << ledger->info().seq;
 
-        return true;
+            return true;
+        }
+
+        // The pending save is of another ledger with this sequence,
+        // replace its rows once it is done.
+        JLOG (app.journal ("Ledger").info)
+            << "Resave of ledger " << ledger->info().seq;
+        resave = true;
     }
 
     if (isSynchronous)
-        return saveValidatedLedger(app, ledger, isCurrent);
+    {
+        if (! saveValidatedLedger(app, ledger, isCurrent))
+            return false;
+        // Wait for the persister to commit the rows, which it
+        // retries for as long as the database is unavailable
+        if (! app.pendingSaves().await (
+            ledger->info().seq, syncSaveTimeout))
+        {
+            JLOG (app.journal ("Ledger").warning)
+                << "Timed out saving ledger " << ledger->info().seq;
+            return false;
+        }
+        return true;
+    }
 
-    auto job = [ledger, &app, isCurrent] (Job&) {
-        saveValidatedLedger(app, ledger, isCurrent);
+    auto job = [ledger, &app, isCurrent, resave] (Job&) {
+        // A resave waits for a save in progress to finish and takes
+        // over one that is only scheduled, so it is never dropped
+        if (resave)
+            app.pendingSaves().claimWork (ledger->info().seq);
+        saveValidatedLedger(app, ledger, isCurrent, resave);
     };
 
     if (isCurrent)
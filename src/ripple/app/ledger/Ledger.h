@@ -26,6 +26,7 @@
 #include <ripple/basics/CountedObject.h>
 #include <ripple/core/TimeKeeper.h>
 #include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/SLEView.h>
 #include <ripple/protocol/STLedgerEntry.h>
 #include <ripple/protocol/Serializer.h>
 #include <ripple/protocol/Book.h>
@@ -340,6 +341,11 @@ public:
 
     void visitStateItems (std::function<void (SLE::ref)>) const;
 
+    /** Visit every state entry without decoding it.
+        The views refer to the state map's items directly.
+    */
+    void visitStateViews (std::function<void (SLEView const&)>) const;
+
 
     std::vector<uint256> getNeededTransactionHashes (
         int max, SHAMapSyncFilter* filter) const;
@@ -0,0 +1,204 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_LEDGERPERSISTER_H_INCLUDED
+#define RIPPLE_APP_LEDGER_LEDGERPERSISTER_H_INCLUDED
+
+#include <ripple/basics/Blob.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/Slice.h>
+#include <ripple/core/Config.h>
+#include <ripple/protocol/Protocol.h>
+#include <beast/threads/Stoppable.h>
+#include <beast/utility/Journal.h>
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+class Application;
+class DatabaseCon;
+
+/** The SQL rows saved for one validated ledger. */
+struct LedgerRows
+{
+    struct Transaction
+    {
+        std::string id;
+        std::string type;
+        std::string account;
+        std::uint32_t sequence = 0;
+        Blob raw;
+        Blob meta;
+    };
+
+    struct AccountTransaction
+    {
+        std::string id;
+        std::string account;
+        std::uint32_t txnSeq = 0;
+    };
+
+    LedgerIndex seq = 0;
+    uint256 hash;
+    uint256 parentHash;
+    uint256 accountHash;
+    uint256 txHash;
+    std::string drops;
+    std::string dropsXRS;
+    std::uint32_t closeTime = 0;
+    std::uint32_t parentCloseTime = 0;
+    int closeTimeResolution = 0;
+    int closeFlags = 0;
+
+    // False when there is no transaction database to write
+    bool withTransactions = false;
+    std::vector<Transaction> transactions;
+    std::vector<AccountTransaction> accountTransactions;
+};
+
+/** Encode rows for the write-ahead log. */
+std::string
+serializeLedgerRows (LedgerRows const& rows);
+
+/** Decode rows from the write-ahead log.
+    @return The rows, or boost::none if the record is malformed.
+*/
+boost::optional<LedgerRows>
+deserializeLedgerRows (Slice const& record);
+
+/** Append a record to a write-ahead log stream.
+    @return The number of bytes written.
+*/
+std::size_t
+appendLedgerLog (std::ostream& log, std::string const& record);
+
+/** Read the records of a write-ahead log stream.
+    Reading stops at the first torn or corrupt record, which includes
+    a record whose size is larger than the rest of the stream.
+*/
+std::vector<std::string>
+readLedgerLog (std::istream& log);
+
+/** Where the record of a ledger is in the write-ahead log. */
+struct LedgerLogEntry
+{
+    LedgerIndex seq = 0;
+    uint256 hash;
+    std::uint64_t offset = 0;
+
+    // The bytes of the record and its header
+    std::size_t size = 0;
+};
+
+/** Find the ledgers in a write-ahead log stream, read from its start.
+    Only the positions of the records are kept. A ledger logged more
+    than once is found at its last record. Scanning stops where
+    readLedgerLog stops.
+    @return The entries in ledger order.
+*/
+std::vector<LedgerLogEntry>
+scanLedgerLog (std::istream& log);
+
+/** Read the record of a ledger found in a write-ahead log stream.
+    @return The record, or boost::none if it is torn or corrupt.
+*/
+boost::optional<std::string>
+readLedgerLogEntry (std::istream& log, LedgerLogEntry const& entry);
+
+/** Write the rows of some ledgers to the SQL databases.
+    The rows a ledger had are replaced, so writing a batch again after
+    it was interrupted leaves the same rows as writing it once.
+*/
+void
+writeLedgerRows (DatabaseCon& ledgerDB, DatabaseCon& txnDB,
+    std::vector<LedgerRows> const& batch);
+
+//------------------------------------------------------------------------------
+
+/** Writes validated ledgers to the SQL databases in the background.
+
+    Ledgers are queued in order and written by a dedicated thread, which
+    groups up to batchSize queued ledgers in each database transaction so
+    that catching up doesn't pay a commit for every ledger. Each queued
+    ledger is first appended to a write-ahead log, so that rows not yet
+    committed survive a restart, and a database error is retried until
+    it succeeds instead of dropping the ledger.
+
+    Queued rows are read back from the log when they are written, and
+    held in memory only when they can't be logged. A ledger stays
+    pending in PendingSaves until its rows are committed.
+*/
+class LedgerPersister
+    : public beast::Stoppable
+{
+protected:
+    explicit LedgerPersister (Stoppable& parent);
+
+public:
+    struct Setup
+    {
+        // Ledgers written in one database transaction
+        std::size_t batchSize = 16;
+
+        // History ledgers queued before their saves block
+        std::size_t queueLimit = 256;
+
+        // The write-ahead log, empty to run without one
+        boost::filesystem::path logPath;
+    };
+
+    virtual ~LedgerPersister () = 0;
+
+    /** Queue the rows of a ledger to be written.
+        Saving a history ledger blocks while the queue is full, which
+        slows down catching up to the pace of the database. The current
+        ledger is always accepted. Before the writer starts and after it
+        stops the rows are written by the caller.
+
+        Thread safety:
+            Safe to call from any thread at any time.
+    */
+    virtual void save (LedgerRows&& rows, bool current) = 0;
+
+    /** Returns true if the rows of this ledger are waiting to be written.
+        A save of another ledger with the same sequence doesn't count.
+    */
+    virtual bool pending (LedgerIndex seq, uint256 const& hash) const = 0;
+
+    /** Returns the number of ledgers waiting to be written. */
+    virtual std::size_t size () const = 0;
+};
+
+LedgerPersister::Setup
+setup_LedgerPersister (Config const& config);
+
+std::unique_ptr<LedgerPersister>
+make_LedgerPersister (Application& app, LedgerPersister::Setup const& setup,
+    beast::Stoppable& parent, beast::Journal journal);
+
+} // ripple
+
+#endif
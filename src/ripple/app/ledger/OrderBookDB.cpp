@@ -242,9 +242,6 @@ void OrderBookDB::processTxn (
 {
     std::lock_guard <std::recursive_mutex> sl (mLock);
     
-    Json::Value jvObj;
-    bool bJvObjInitialized = false;
-
     if (alTx.getResult () == tesSUCCESS)
     {
         std::set<BookListeners::pointer> listenersSet;
@@ -297,16 +294,23 @@ void OrderBookDB::processTxn (
             }
         }
         
-        for (auto& listeners: listenersSet)
-        {
-            if (!bJvObjInitialized)
+        StreamMessage message (
+            [&]
             {
-                jvObj = NetworkOPs_transJson (*alTx.getTxn (), alTx.getResult (), true, ledger, app_);
+                auto jvObj = NetworkOPs_transJson (*alTx.getTxn (),
+                    alTx.getResult (), true, ledger, app_);
                 jvObj[jss::meta] = alTx.getMeta ()->getJson (0);
-                bJvObjInitialized = true;
-            }
-            listeners->publish (jvObj);
-        }
+                return jvObj;
+            },
+            [&]
+            {
+                return NetworkOPs_transBinary (*alTx.getTxn (),
+                    alTx.getResult (), true, *ledger,
+                        makeSlice (alTx.getMetaBlob ()));
+            });
+
+        for (auto& listeners: listenersSet)
+            listeners->publish (message);
     }
 }
 
@@ -21,6 +21,7 @@
 #define RIPPLE_APP_PENDINGSAVES_H_INCLUDED
 
 #include <ripple/protocol/Protocol.h>
+#include <chrono>
 #include <map>
 #include <mutex>
 #include <condition_variable>
@@ -65,6 +66,24 @@ public:
         return true;
     }
 
+    /** Take over the work on a ledger
+
+        Waits while another thread is saving the ledger, then marks
+        the work as in progress. A save that is scheduled but not yet
+        dispatched is superseded: its later call to startWork fails.
+    */
+    void
+    claimWork (LedgerIndex seq)
+    {
+        std::unique_lock <std::mutex> lock(mutex_);
+        await_.wait (lock, [&]
+            {
+                auto it = map_.find (seq);
+                return (it == map_.end()) || ! it->second;
+            });
+        map_[seq] = true;
+    }
+
     /** Finish working on a ledger
 
         This is called after updating the SQLite indexes.
@@ -80,6 +99,33 @@ public:
         await_.notify_all();
     }
 
+    /** Wait until a ledger is no longer being saved. */
+    void
+    await (LedgerIndex seq)
+    {
+        std::unique_lock <std::mutex> lock(mutex_);
+        await_.wait (lock, [&]
+            {
+                return map_.find (seq) == map_.end();
+            });
+    }
+
+    /** Wait until a ledger is no longer being saved, or the timeout.
+
+        @return 'false' if the ledger is still being saved
+    */
+    template <class Rep, class Period>
+    bool
+    await (LedgerIndex seq,
+        std::chrono::duration <Rep, Period> const& timeout)
+    {
+        std::unique_lock <std::mutex> lock(mutex_);
+        return await_.wait_for (lock, timeout, [&]
+            {
+                return map_.find (seq) == map_.end();
+            });
+    }
+
     /** Return `true` if a ledger is in the progress of being saved. */
     bool
     pending (LedgerIndex seq)
@@ -128,6 +174,34 @@ public:
         } while (true);
     }
 
+    /** Check if a ledger should be saved synchronously
+
+        Like a synchronous call to shouldWork, but waits for work
+        in progress no longer than the timeout.
+
+        @return 'true' if work should be done, 'false' if the work
+                in progress didn't finish in time
+    */
+    template <class Rep, class Period>
+    bool
+    shouldWork (LedgerIndex seq,
+        std::chrono::duration <Rep, Period> const& timeout)
+    {
+        std::unique_lock <std::mutex> lock(mutex_);
+        if (! await_.wait_for (lock, timeout, [&]
+            {
+                auto it = map_.find (seq);
+                return (it == map_.end()) || ! it->second;
+            }))
+        {
+            return false;
+        }
+
+        // Take over a save that is scheduled, but not dispatched
+        map_.emplace (seq, false);
+        return true;
+    }
+
     /** Get a snapshot of the pending saves
 
         Each entry in the returned map corresponds to a ledger
@@ -0,0 +1,1020 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/app/ledger/LedgerPersister.h>
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/PendingSaves.h>
+#include <ripple/app/main/Application.h>
+#include <ripple/app/misc/AccountTxIndex.h>
+#include <ripple/basics/contract.h>
+#include <ripple/basics/Log.h>
+#include <ripple/core/ConfigSections.h>
+#include <ripple/core/DatabaseCon.h>
+#include <ripple/core/SociDB.h>
+#include <ripple/protocol/digest.h>
+#include <ripple/protocol/Serializer.h>
+#include <ripple/protocol/STTx.h>
+#include <beast/threads/Thread.h>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace ripple {
+
+namespace {
+
+std::uint32_t const logVersion = 1;
+
+// Size and checksum in front of each log record
+std::size_t const logHeaderSize = 12;
+
+void
+addBytes (Serializer& s, void const* data, std::size_t size)
+{
+    s.add32 (static_cast<std::uint32_t> (size));
+    if (size != 0)
+        s.addRaw (data, static_cast<int> (size));
+}
+
+Slice
+getBytes (SerialIter& sit)
+{
+    std::size_t const size = sit.get32 ();
+    return sit.getSlice (size);
+}
+
+std::string
+getString (SerialIter& sit)
+{
+    auto const s = getBytes (sit);
+    return std::string (reinterpret_cast<char const*> (s.data ()), s.size ());
+}
+
+Blob
+getBlob (SerialIter& sit)
+{
+    auto const s = getBytes (sit);
+    return Blob (s.data (), s.data () + s.size ());
+}
+
+// The first bytes of the record's hash, to detect torn writes
+std::uint64_t
+checksum (Slice const& record)
+{
+    auto const hash = sha512Half (record);
+    std::uint64_t result;
+    std::memcpy (&result, hash.data (), sizeof (result));
+    return result;
+}
+
+// No record is this big, a larger size is a corrupt header
+std::size_t const maxRecordSize = 256 * 1024 * 1024;
+
+// The bytes left in a stream, or maxRecordSize if it can't seek
+std::uint64_t
+remaining (std::istream& log)
+{
+    auto const pos = log.tellg ();
+    if (pos == std::istream::pos_type (-1))
+        return maxRecordSize;
+    log.seekg (0, std::ios::end);
+    auto const end = log.tellg ();
+    log.clear ();
+    log.seekg (pos);
+    if (end == std::istream::pos_type (-1) || end < pos)
+        return maxRecordSize;
+    return static_cast<std::uint64_t> (end - pos);
+}
+
+// Read the record at the position of the stream.
+// Returns false at the end of the log and at a torn or corrupt record.
+bool
+readRecord (std::istream& log, std::string& record)
+{
+    std::uint8_t buffer[logHeaderSize];
+    log.read (reinterpret_cast<char*> (buffer), sizeof (buffer));
+    if (log.gcount () != sizeof (buffer))
+        return false;
+
+    SerialIter sit (buffer, sizeof (buffer));
+    std::size_t const size = sit.get32 ();
+    std::uint64_t const sum = sit.get64 ();
+
+    // Check the size before allocating for it
+    if (size > maxRecordSize || size > remaining (log))
+        return false;
+
+    record.assign (size, '\0');
+    if (size != 0)
+    {
+        log.read (&record[0], size);
+        if (static_cast<std::size_t> (log.gcount ()) != size)
+            return false;
+    }
+
+    return checksum (makeSlice (record)) == sum;
+}
+
+void
+writeTransactions (DatabaseCon& txnDB, std::vector<LedgerRows> const& batch)
+{
+    auto const dbType = txnDB.getType ();
+
+    std::vector<long long> ledgerSeqs;
+    std::vector<std::string> txnIds;
+    std::vector<std::string> acctTxnIds;
+    std::vector<std::string> acctAccounts;
+    std::vector<long long> acctLedgerSeqs;
+    std::vector<int> acctTxnSeqs;
+
+    for (auto const& rows : batch)
+    {
+        if (! rows.withTransactions)
+            continue;
+        ledgerSeqs.push_back (rows.seq);
+        for (auto const& tx : rows.transactions)
+            txnIds.push_back (tx.id);
+        for (auto const& atx : rows.accountTransactions)
+        {
+            acctTxnIds.push_back (atx.id);
+            acctAccounts.push_back (atx.account);
+            acctLedgerSeqs.push_back (rows.seq);
+            acctTxnSeqs.push_back (atx.txnSeq);
+        }
+    }
+
+    if (ledgerSeqs.empty ())
+        return;
+
+    auto db = txnDB.checkoutDb ();
+    soci::transaction tr (*db);
+
+    *db << "DELETE FROM Transactions WHERE LedgerSeq = :seq;",
+        soci::use (ledgerSeqs);
+    *db << "DELETE FROM AccountTransactions WHERE LedgerSeq = :seq;",
+        soci::use (ledgerSeqs);
+
+    if (! txnIds.empty ())
+    {
+        *db << "DELETE FROM AccountTransactions WHERE TransID = :id;",
+            soci::use (txnIds);
+    }
+
+    if (! acctTxnIds.empty ())
+    {
+        *db << "INSERT INTO AccountTransactions "
+            "(TransID, Account, LedgerSeq, TxnSeq) VALUES "
+            "(:id, :account, :seq, :txnSeq);",
+            soci::use (acctTxnIds), soci::use (acctAccounts),
+            soci::use (acctLedgerSeqs), soci::use (acctTxnSeqs);
+    }
+
+    if (! txnIds.empty ())
+    {
+        // MySQL takes the blobs as escaped strings,
+        // SQLite binds them as blobs.
+        bool const isMySQL = dbType == DatabaseCon::Type::MySQL;
+        std::string const status (1, TXN_SQL_VALIDATED);
+        std::string id, type, account, rawStr, metaStr;
+        long long sequence = 0, ledgerSeq = 0, closeTime = 0;
+        soci::blob rawBlob (*db), metaBlob (*db);
+
+        std::string const sql =
+            STTx::getMetaSQLInsertReplaceHeader (dbType) +
+            "(:id, :type, :account, :seq, :ledgerSeq, :status, "
+            ":closeTime, :raw, :meta);";
+
+        soci::statement st = isMySQL ?
+            (db->prepare << sql, soci::use (id), soci::use (type),
+                soci::use (account), soci::use (sequence),
+                soci::use (ledgerSeq), soci::use (status),
+                soci::use (closeTime), soci::use (rawStr),
+                soci::use (metaStr)) :
+            (db->prepare << sql, soci::use (id), soci::use (type),
+                soci::use (account), soci::use (sequence),
+                soci::use (ledgerSeq), soci::use (status),
+                soci::use (closeTime), soci::use (rawBlob),
+                soci::use (metaBlob));
+
+        for (auto const& rows : batch)
+        {
+            if (! rows.withTransactions)
+                continue;
+            ledgerSeq = rows.seq;
+            closeTime = rows.closeTime;
+            for (auto const& tx : rows.transactions)
+            {
+                id = tx.id;
+                type = tx.type;
+                account = tx.account;
+                sequence = tx.sequence;
+                if (isMySQL)
+                {
+                    rawStr.assign (tx.raw.begin (), tx.raw.end ());
+                    metaStr.assign (tx.meta.begin (), tx.meta.end ());
+                }
+                else
+                {
+                    // A blob keeps its old tail when rewritten
+                    rawBlob.trim (0);
+                    convert (tx.raw, rawBlob);
+                    metaBlob.trim (0);
+                    convert (tx.meta, metaBlob);
+                }
+                st.execute (true);
+            }
+        }
+    }
+
+    tr.commit ();
+}
+
+} // anonymous namespace
+
+std::string
+serializeLedgerRows (LedgerRows const& rows)
+{
+    Serializer s (256);
+    s.add32 (logVersion);
+    s.add32 (rows.seq);
+    s.add256 (rows.hash);
+    s.add256 (rows.parentHash);
+    s.add256 (rows.accountHash);
+    s.add256 (rows.txHash);
+    addBytes (s, rows.drops.data (), rows.drops.size ());
+    addBytes (s, rows.dropsXRS.data (), rows.dropsXRS.size ());
+    s.add32 (rows.closeTime);
+    s.add32 (rows.parentCloseTime);
+    s.add32 (static_cast<std::uint32_t> (rows.closeTimeResolution));
+    s.add32 (static_cast<std::uint32_t> (rows.closeFlags));
+    s.add8 (rows.withTransactions ? 1 : 0);
+
+    s.add32 (static_cast<std::uint32_t> (rows.transactions.size ()));
+    for (auto const& tx : rows.transactions)
+    {
+        addBytes (s, tx.id.data (), tx.id.size ());
+        addBytes (s, tx.type.data (), tx.type.size ());
+        addBytes (s, tx.account.data (), tx.account.size ());
+        s.add32 (tx.sequence);
+        addBytes (s, tx.raw.data (), tx.raw.size ());
+        addBytes (s, tx.meta.data (), tx.meta.size ());
+    }
+
+    s.add32 (static_cast<std::uint32_t> (rows.accountTransactions.size ()));
+    for (auto const& atx : rows.accountTransactions)
+    {
+        addBytes (s, atx.id.data (), atx.id.size ());
+        addBytes (s, atx.account.data (), atx.account.size ());
+        s.add32 (atx.txnSeq);
+    }
+
+    return s.getString ();
+}
+
+boost::optional<LedgerRows>
+deserializeLedgerRows (Slice const& record)
+{
+    try
+    {
+        SerialIter sit (record);
+        if (sit.get32 () != logVersion)
+            return boost::none;
+
+        LedgerRows rows;
+        rows.seq = sit.get32 ();
+        rows.hash = sit.get256 ();
+        rows.parentHash = sit.get256 ();
+        rows.accountHash = sit.get256 ();
+        rows.txHash = sit.get256 ();
+        rows.drops = getString (sit);
+        rows.dropsXRS = getString (sit);
+        rows.closeTime = sit.get32 ();
+        rows.parentCloseTime = sit.get32 ();
+        rows.closeTimeResolution = static_cast<int> (sit.get32 ());
+        rows.closeFlags = static_cast<int> (sit.get32 ());
+        rows.withTransactions = sit.get8 () != 0;
+
+        for (auto count = sit.get32 (); count != 0; --count)
+        {
+            LedgerRows::Transaction tx;
+            tx.id = getString (sit);
+            tx.type = getString (sit);
+            tx.account = getString (sit);
+            tx.sequence = sit.get32 ();
+            tx.raw = getBlob (sit);
+            tx.meta = getBlob (sit);
+            rows.transactions.push_back (std::move (tx));
+        }
+
+        for (auto count = sit.get32 (); count != 0; --count)
+        {
+            LedgerRows::AccountTransaction atx;
+            atx.id = getString (sit);
+            atx.account = getString (sit);
+            atx.txnSeq = sit.get32 ();
+            rows.accountTransactions.push_back (std::move (atx));
+        }
+
+        if (! sit.empty ())
+            return boost::none;
+
+        return rows;
+    }
+    catch (std::exception const&)
+    {
+    }
+    return boost::none;
+}
+
+std::size_t
+appendLedgerLog (std::ostream& log, std::string const& record)
+{
+    Serializer header (logHeaderSize);
+    header.add32 (static_cast<std::uint32_t> (record.size ()));
+    header.add64 (checksum (makeSlice (record)));
+    log.write (reinterpret_cast<char const*> (header.data ()), header.size ());
+    log.write (record.data (), record.size ());
+    return header.size () + record.size ();
+}
+
+std::vector<std::string>
+readLedgerLog (std::istream& log)
+{
+    std::vector<std::string> records;
+    std::string record;
+    while (readRecord (log, record))
+        records.push_back (std::move (record));
+    return records;
+}
+
+std::vector<LedgerLogEntry>
+scanLedgerLog (std::istream& log)
+{
+    std::map<LedgerIndex, LedgerLogEntry> entries;
+    std::uint64_t offset = 0;
+    std::string record;
+    while (readRecord (log, record))
+    {
+        std::size_t const size = logHeaderSize + record.size ();
+        if (auto const rows = deserializeLedgerRows (makeSlice (record)))
+            entries[rows->seq] = {rows->seq, rows->hash, offset, size};
+        offset += size;
+    }
+
+    std::vector<LedgerLogEntry> result;
+    result.reserve (entries.size ());
+    for (auto const& entry : entries)
+        result.push_back (entry.second);
+    return result;
+}
+
+boost::optional<std::string>
+readLedgerLogEntry (std::istream& log, LedgerLogEntry const& entry)
+{
+    log.clear ();
+    log.seekg (static_cast<std::streamoff> (entry.offset));
+    std::string record;
+    if (! readRecord (log, record) ||
+            logHeaderSize + record.size () != entry.size)
+        return boost::none;
+    return record;
+}
+
+void
+writeLedgerRows (DatabaseCon& ledgerDB, DatabaseCon& txnDB,
+    std::vector<LedgerRows> const& batch)
+{
+    if (batch.empty ())
+        return;
+
+    // Until the new rows are in, the ledgers must not look complete
+    std::vector<long long> ledgerSeqs;
+    ledgerSeqs.reserve (batch.size ());
+    for (auto const& rows : batch)
+        ledgerSeqs.push_back (rows.seq);
+
+    {
+        auto db = ledgerDB.checkoutDb ();
+        *db << "DELETE FROM Ledgers WHERE LedgerSeq = :seq;",
+            soci::use (ledgerSeqs);
+    }
+
+    if (txnDB.getType () != DatabaseCon::Type::None)
+        writeTransactions (txnDB, batch);
+
+    auto db = ledgerDB.checkoutDb ();
+    soci::transaction tr (*db);
+
+    // soci binds by address and reads the values on execute, so each
+    // bound value is a named local that outlives the statement.
+    // Never bind a temporary such as to_string (rows.hash) here.
+    std::string hash, parentHash, drops, dropsXRS, accountHash, txHash;
+    long long seq = 0, closeTime = 0, parentCloseTime = 0;
+    int closeTimeResolution = 0, closeFlags = 0;
+
+    soci::statement st = (db->prepare <<
+        "INSERT OR REPLACE INTO Ledgers "
+        "(LedgerHash,LedgerSeq,PrevHash,TotalCoins,TotalCoinsXRS,"
+        "ClosingTime,PrevClosingTime,CloseTimeRes,CloseFlags,"
+        "AccountSetHash,TransSetHash) VALUES "
+        "(:hash,:seq,:prevHash,:coins,:coinsXRS,:closeTime,"
+        ":prevCloseTime,:closeTimeRes,:closeFlags,:accountHash,"
+        ":txHash);",
+        soci::use (hash), soci::use (seq), soci::use (parentHash),
+        soci::use (drops), soci::use (dropsXRS), soci::use (closeTime),
+        soci::use (parentCloseTime), soci::use (closeTimeResolution),
+        soci::use (closeFlags), soci::use (accountHash),
+        soci::use (txHash));
+
+    for (auto const& rows : batch)
+    {
+        hash = to_string (rows.hash);
+        seq = rows.seq;
+        parentHash = to_string (rows.parentHash);
+        drops = rows.drops;
+        dropsXRS = rows.dropsXRS;
+        closeTime = rows.closeTime;
+        parentCloseTime = rows.parentCloseTime;
+        closeTimeResolution = rows.closeTimeResolution;
+        closeFlags = rows.closeFlags;
+        accountHash = to_string (rows.accountHash);
+        txHash = to_string (rows.txHash);
+        st.execute (true);
+    }
+
+    tr.commit ();
+}
+
+//------------------------------------------------------------------------------
+
+class LedgerPersisterImp : public LedgerPersister
+{
+    // A queued ledger, whose record is read back from the log
+    // when it is written. The record is held here only when it
+    // couldn't be logged, and then the size is zero.
+    struct Entry : LedgerLogEntry
+    {
+        std::string record;
+
+        Entry () = default;
+
+        explicit
+        Entry (LedgerLogEntry const& entry)
+            : LedgerLogEntry (entry)
+        {
+        }
+    };
+
+    Application& app_;
+    Setup const setup_;
+    beast::Journal j_;
+
+    std::mutex mutable mutex_;
+    std::condition_variable wakeup_;
+    std::condition_variable space_;
+    std::deque<Entry> queue_;
+    bool running_ = false;
+    bool shouldExit_ = false;
+    std::thread thread_;
+
+    // The hash of each ledger queued or being written
+    std::map<LedgerIndex, uint256> saving_;
+
+    std::ofstream log_;
+
+    // Bytes in the log, and bytes of the records not yet committed
+    std::uint64_t logSize_ = 0;
+    std::uint64_t pendingSize_ = 0;
+
+    // The log is rewritten once it is this big and mostly committed
+    static std::uint64_t const compactSize = 64 * 1024 * 1024;
+
+public:
+    LedgerPersisterImp (Application& app, Setup const& setup,
+            Stoppable& parent, beast::Journal journal)
+        : LedgerPersister (parent)
+        , app_ (app)
+        , setup_ (setup)
+        , j_ (journal)
+    {
+    }
+
+    ~LedgerPersisterImp () override
+    {
+        if (thread_.joinable())
+            LogicError ("LedgerPersisterImp::onStop not called.");
+    }
+
+    void
+    save (LedgerRows&& rows, bool current) override
+    {
+        auto record = serializeLedgerRows (rows);
+
+        std::unique_lock<std::mutex> lock (mutex_);
+        if (! current)
+        {
+            space_.wait (lock, [this]
+                {
+                    return ! running_ ||
+                        queue_.size () < setup_.queueLimit;
+                });
+        }
+
+        if (! running_)
+        {
+            lock.unlock ();
+            saveNow (rows);
+            return;
+        }
+
+        Entry entry;
+        entry.seq = rows.seq;
+        entry.hash = rows.hash;
+        if (! appendLog (record, entry))
+            entry.record = std::move (record);
+        saving_[entry.seq] = entry.hash;
+        queue_.push_back (std::move (entry));
+        wakeup_.notify_one ();
+    }
+
+    bool
+    pending (LedgerIndex seq, uint256 const& hash) const override
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        auto const it = saving_.find (seq);
+        return it != saving_.end () && it->second == hash;
+    }
+
+    std::size_t
+    size () const override
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        return queue_.size ();
+    }
+
+    //--------------------------------------------------------------------------
+    //
+    // Stoppable
+    //
+    //--------------------------------------------------------------------------
+
+    void
+    onPrepare () override
+    {
+    }
+
+    void
+    onStart () override
+    {
+        {
+            std::lock_guard<std::mutex> lock (mutex_);
+            replay ();
+            running_ = true;
+        }
+        thread_ = std::thread {&LedgerPersisterImp::run, this};
+    }
+
+    void
+    onStop () override
+    {
+        JLOG (j_.info) << "Stopping";
+        {
+            std::lock_guard<std::mutex> lock (mutex_);
+            shouldExit_ = true;
+            wakeup_.notify_one ();
+        }
+
+        if (thread_.joinable ())
+            thread_.join ();
+        else
+            stopped ();
+    }
+
+private:
+    void
+    run ()
+    {
+        beast::Thread::setCurrentThreadName ("LedgerPersister");
+        JLOG (j_.debug) << "Started";
+
+        std::vector<Entry> batch;
+        std::vector<LedgerRows> rows;
+        int failures = 0;
+
+        while (true)
+        {
+            if (batch.empty ())
+            {
+                {
+                    std::unique_lock<std::mutex> lock (mutex_);
+                    wakeup_.wait (lock, [this]
+                        {
+                            return shouldExit_ || ! queue_.empty ();
+                        });
+
+                    // Drain the queue before stopping
+                    if (queue_.empty ())
+                        break;
+
+                    while (! queue_.empty () &&
+                        batch.size () < setup_.batchSize)
+                    {
+                        batch.push_back (std::move (queue_.front ()));
+                        queue_.pop_front ();
+                    }
+                    space_.notify_all ();
+                }
+
+                // Only this thread replaces the log, so the
+                // records can be read without holding the lock.
+                rows = load (batch);
+            }
+
+            if (write (batch, rows))
+            {
+                failures = 0;
+                {
+                    std::lock_guard<std::mutex> lock (mutex_);
+                    committed (batch);
+                }
+
+                // Clients can now trust the database for
+                // information about these ledgers.
+                for (auto const& entry : batch)
+                    app_.pendingSaves ().finishWork (entry.seq);
+                batch.clear ();
+                rows.clear ();
+                continue;
+            }
+
+            // Keep the batch and try again after a pause
+            std::unique_lock<std::mutex> lock (mutex_);
+            if (shouldExit_)
+                break;
+            failures = std::min (failures + 1, 30);
+            wakeup_.wait_for (lock, std::chrono::seconds (failures),
+                [this] { return shouldExit_; });
+        }
+
+        // Whatever is left stays in the log for the next start
+        std::vector<LedgerIndex> left;
+        {
+            std::lock_guard<std::mutex> lock (mutex_);
+            running_ = false;
+            for (auto const& entry : batch)
+                left.push_back (entry.seq);
+            for (auto const& entry : queue_)
+                left.push_back (entry.seq);
+            queue_.clear ();
+            saving_.clear ();
+            log_.close ();
+            space_.notify_all ();
+        }
+
+        if (! left.empty ())
+        {
+            JLOG (j_.warning) << left.size ()
+                << " ledgers left unsaved in " << setup_.logPath;
+        }
+
+        for (auto seq : left)
+            app_.pendingSaves ().finishWork (seq);
+
+        stopped ();
+    }
+
+    // Write a ledger on the caller's thread when the writer isn't running
+    void
+    saveNow (LedgerRows const& rows)
+    {
+        try
+        {
+            writeRows ({rows});
+        }
+        catch (std::exception const& e)
+        {
+            JLOG (j_.error) << "Unable to save ledger " << rows.seq
+                << ": " << e.what ();
+            app_.getLedgerMaster ().failedSave (rows.seq, rows.hash);
+        }
+        app_.pendingSaves ().finishWork (rows.seq);
+    }
+
+    // Read the rows of a batch, a ledger whose record is lost is
+    // acquired again.
+    std::vector<LedgerRows>
+    load (std::vector<Entry> const& batch)
+    {
+        std::vector<LedgerRows> rows;
+        rows.reserve (batch.size ());
+        std::ifstream in;
+        for (auto const& entry : batch)
+        {
+            boost::optional<LedgerRows> r;
+            if (entry.size == 0)
+            {
+                r = deserializeLedgerRows (makeSlice (entry.record));
+            }
+            else
+            {
+                if (! in.is_open ())
+                    in.open (setup_.logPath.string (), std::ios::binary);
+                if (auto const record = readLedgerLogEntry (in, entry))
+                    r = deserializeLedgerRows (makeSlice (*record));
+            }
+
+            if (r)
+            {
+                rows.push_back (std::move (*r));
+                continue;
+            }
+
+            JLOG (j_.error) << "Bad log record for ledger " << entry.seq;
+            app_.getLedgerMaster ().failedSave (entry.seq, entry.hash);
+        }
+        return rows;
+    }
+
+    bool
+    write (std::vector<Entry> const& batch,
+        std::vector<LedgerRows> const& rows)
+    {
+        try
+        {
+            writeRows (rows);
+            JLOG (j_.debug) << "Saved " << rows.size () << " ledgers";
+            return true;
+        }
+        catch (std::exception const& e)
+        {
+            JLOG (j_.error) << "Unable to save ledgers "
+                << batch.front ().seq << " to " << batch.back ().seq
+                << ": " << e.what ();
+        }
+
+        if (app_.getTxnDB ().startReconnection ())
+        {
+            try
+            {
+                app_.getTxnDB ().reconnect ();
+                JLOG (j_.warning) << "Reconnected to the transaction database";
+            }
+            catch (std::exception const& e)
+            {
+                JLOG (j_.error) << "Unable to reconnect: " << e.what ();
+            }
+            app_.getTxnDB ().finishReconnection ();
+        }
+        return false;
+    }
+
+    void
+    writeRows (std::vector<LedgerRows> const& batch)
+    {
+        writeLedgerRows (app_.getLedgerDB (), app_.getTxnDB (), batch);
+
+        if (auto index = app_.getAccountTxIndex ())
+            indexTransactions (*index, batch);
+    }
+
+    // Add the ledgers to the account transaction index once their
+    // rows are committed, so that every indexed position can be read.
+    void
+    indexTransactions (AccountTxIndex& index,
+        std::vector<LedgerRows> const& batch)
+    {
+        std::vector<AccountTxIndex::Entry> entries;
+        for (auto const& rows : batch)
+        {
+            if (! rows.withTransactions)
+                continue;
+
+            entries.clear ();
+            entries.reserve (rows.accountTransactions.size ());
+            for (auto const& atx : rows.accountTransactions)
+            {
+                auto const account = parseBase58<AccountID> (atx.account);
+                uint256 id;
+                if (! account || ! id.SetHexExact (atx.id.c_str ()))
+                    break;
+                entries.push_back ({*account, atx.txnSeq, id});
+            }
+
+            // Leave the ledger out, lookups fall back to SQL
+            if (entries.size () != rows.accountTransactions.size ())
+            {
+                JLOG (j_.error) << "Unable to index ledger " << rows.seq;
+                continue;
+            }
+
+            index.insert (rows.seq, entries);
+        }
+    }
+
+    // The lock must be held for the log functions
+
+    // Returns false if the record couldn't be logged
+    bool
+    appendLog (std::string const& record, Entry& entry)
+    {
+        if (! log_.is_open ())
+            return false;
+
+        auto const size = appendLedgerLog (log_, record);
+        log_.flush ();
+        if (! log_)
+        {
+            JLOG (j_.error) << "Unable to write " << setup_.logPath;
+            log_.close ();
+            return false;
+        }
+        entry.offset = logSize_;
+        entry.size = size;
+        logSize_ += size;
+        pendingSize_ += size;
+        return true;
+    }
+
+    void
+    committed (std::vector<Entry> const& batch)
+    {
+        for (auto const& entry : batch)
+        {
+            auto const it = saving_.find (entry.seq);
+            if (it != saving_.end () && it->second == entry.hash)
+                saving_.erase (it);
+        }
+
+        if (! log_.is_open ())
+            return;
+
+        for (auto const& entry : batch)
+            pendingSize_ -= entry.size;
+
+        if (queue_.empty ())
+        {
+            log_.close ();
+            log_.open (setup_.logPath.string (),
+                std::ios::binary | std::ios::trunc);
+            logSize_ = pendingSize_ = 0;
+        }
+        else if (logSize_ > compactSize && logSize_ > 2 * pendingSize_)
+        {
+            rewriteLog ();
+        }
+    }
+
+    // Replace the log with one holding just the queued records
+    void
+    rewriteLog ()
+    {
+        log_.close ();
+        auto const temp = setup_.logPath.string () + ".tmp";
+
+        // The offset and size of each queued record in the new log
+        std::vector<std::pair<std::uint64_t, std::size_t>> positions;
+        positions.reserve (queue_.size ());
+        std::uint64_t size = 0;
+        {
+            std::ifstream in (setup_.logPath.string (), std::ios::binary);
+            std::ofstream out (temp, std::ios::binary | std::ios::trunc);
+            for (auto const& entry : queue_)
+            {
+                boost::optional<std::string> record;
+                if (entry.size == 0)
+                    record = entry.record;
+                else
+                    record = readLedgerLogEntry (in, entry);
+
+                if (! record)
+                {
+                    JLOG (j_.error) << "Unable to read ledger " << entry.seq
+                        << " from " << setup_.logPath;
+                    return;
+                }
+
+                auto const written = appendLedgerLog (out, *record);
+                positions.emplace_back (size, written);
+                size += written;
+            }
+            out.flush ();
+            if (! out)
+            {
+                JLOG (j_.error) << "Unable to write " << temp;
+                return;
+            }
+        }
+
+        boost::system::error_code ec;
+        boost::filesystem::rename (temp, setup_.logPath, ec);
+        if (ec)
+        {
+            JLOG (j_.error) << "Unable to replace " << setup_.logPath
+                << ": " << ec.message ();
+            return;
+        }
+
+        auto position = positions.begin ();
+        for (auto& entry : queue_)
+        {
+            entry.offset = position->first;
+            entry.size = position->second;
+            std::string ().swap (entry.record);
+            ++position;
+        }
+
+        log_.open (setup_.logPath.string (),
+            std::ios::binary | std::ios::app);
+        logSize_ = pendingSize_ = size;
+    }
+
+    // Queue the ledgers a previous run left in the log
+    void
+    replay ()
+    {
+        if (setup_.logPath.empty ())
+            return;
+
+        {
+            std::ifstream in (setup_.logPath.string (), std::ios::binary);
+            if (in)
+            {
+                for (auto const& entry : scanLedgerLog (in))
+                {
+                    saving_[entry.seq] = entry.hash;
+                    queue_.emplace_back (entry);
+                }
+            }
+        }
+
+        if (! queue_.empty ())
+        {
+            JLOG (j_.warning) << "Saving " << queue_.size ()
+                << " ledgers left in " << setup_.logPath;
+        }
+
+        rewriteLog ();
+    }
+};
+
+//------------------------------------------------------------------------------
+
+LedgerPersister::LedgerPersister (Stoppable& parent)
+    : Stoppable ("LedgerPersister", parent)
+{
+}
+
+LedgerPersister::~LedgerPersister ()
+{
+}
+
+LedgerPersister::Setup
+setup_LedgerPersister (Config const& config)
+{
+    LedgerPersister::Setup setup;
+    auto const& section = config.section (SECTION_TX_DB);
+    setup.batchSize = std::max<std::size_t> (1,
+        get<std::size_t> (section, "save_batch", setup.batchSize));
+    setup.queueLimit = std::max<std::size_t> (1,
+        get<std::size_t> (section, "save_queue", setup.queueLimit));
+
+    // Standalone servers use temporary databases
+    auto const dataDir = setup_DatabaseCon (config).dataDir;
+    if (! config.RUN_STANDALONE && ! dataDir.empty ())
+        setup.logPath = dataDir / "ledger_save.wal";
+    return setup;
+}
+
+std::unique_ptr<LedgerPersister>
+make_LedgerPersister (Application& app, LedgerPersister::Setup const& setup,
+    beast::Stoppable& parent, beast::Journal journal)
+{
+    return std::make_unique<LedgerPersisterImp> (
+        app, setup, parent, journal);
+}
+
+} // ripple
@@ -26,6 +26,7 @@
 #include <ripple/app/ledger/AcceptedLedger.h>
 #include <ripple/app/ledger/InboundLedgers.h>
 #include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/LedgerPersister.h>
 #include <ripple/app/ledger/LedgerToJson.h>
 #include <ripple/app/ledger/OpenLedger.h>
 #include <ripple/app/ledger/OrderBookDB.h>
@@ -36,17 +37,20 @@
 #include <ripple/app/main/LoadManager.h>
 #include <ripple/app/main/LocalCredentials.h>
 #include <ripple/app/main/NodeStoreScheduler.h>
+#include <ripple/app/misc/AccountTxIndex.h>
 #include <ripple/app/misc/AmendmentTable.h>
 #include <ripple/app/misc/DividendMaster.h>
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/app/misc/SHAMapStore.h>
 #include <ripple/app/misc/TxQ.h>
+#include <ripple/app/misc/TxStore.h>
 #include <ripple/app/misc/Validations.h>
 #include <ripple/app/paths/Pathfinder.h>
 #include <ripple/app/paths/PathRequests.h>
 #include <ripple/app/misc/UniqueNodeList.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/app/tx/TxCheckCache.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/ResolverAsio.h>
@@ -67,6 +71,7 @@
 #include <ripple/protocol/SecretKey.h>
 #include <ripple/protocol/STParsedJSON.h>
 #include <ripple/protocol/types.h>
+#include <ripple/rpc/impl/ResultCache.h>
 #include <ripple/server/make_ServerHandler.h>
 #include <ripple/shamap/Family.h>
 #include <ripple/unity/git_id.h>
@@ -315,6 +320,7 @@ public:
     std::unique_ptr <CollectorManager> m_collectorManager;
     detail::AppFamily family_;
     CachedSLEs cachedSLEs_;
+    RPC::ResultCache rpcResultCache_;
     LocalCredentials m_localCredentials;
 
     std::unique_ptr <Resource::Manager> m_resourceManager;
@@ -325,6 +331,9 @@ public:
     OrderBookDB m_orderBookDB;
     std::unique_ptr <PathRequests> m_pathRequests;
     std::unique_ptr <LedgerMaster> m_ledgerMaster;
+    std::unique_ptr <LedgerPersister> m_ledgerPersister;
+    std::unique_ptr <AccountTxIndex> m_accountTxIndex;
+    std::unique_ptr <TxStore> m_txStore;
     std::unique_ptr <InboundLedgers> m_inboundLedgers;
     std::unique_ptr <InboundTransactions> m_inboundTransactions;
     TaggedCache <uint256, AcceptedLedger> m_acceptedLedgerCache;
@@ -336,6 +345,7 @@ public:
     std::unique_ptr <DividendMaster> m_dividendMaster;
     std::unique_ptr <LoadFeeTrack> mFeeTrack;
     std::unique_ptr <HashRouter> mHashRouter;
+    std::unique_ptr <TxCheckCache> txCheckCache_;
     std::unique_ptr <Validations> mValidations;
     std::unique_ptr <LoadManager> m_loadManager;
     std::unique_ptr <TxQ> txQ_;
@@ -406,6 +416,8 @@ public:
 
         , cachedSLEs_ (std::chrono::minutes(1), stopwatch())
 
+        , rpcResultCache_ (RPC::setup_ResultCache (*config_))
+
         , m_localCredentials (*this)
 
         , m_resourceManager (Resource::make_Manager (
@@ -431,6 +443,14 @@ public:
             *m_jobQueue, m_collectorManager->collector (),
             logs_->journal("LedgerMaster")))
 
+        , m_ledgerPersister (make_LedgerPersister (*this,
+            setup_LedgerPersister (*config_), *m_jobQueue,
+            logs_->journal("LedgerPersister")))
+
+        , m_accountTxIndex (make_AccountTxIndex (
+            config_->section (SECTION_ACCOUNT_TX_INDEX),
+            logs_->journal("AccountTxIndex")))
+
         // VFALCO NOTE must come before NetworkOPs to prevent a crash due
         //             to dependencies in the destructor.
         //
@@ -471,6 +491,9 @@ public:
         , mHashRouter (std::make_unique<HashRouter>(
             stopwatch(), HashRouter::getDefaultHoldTime ()))
 
+        , txCheckCache_ (std::make_unique<TxCheckCache>(
+            stopwatch(), TxCheckCache::getDefaultHoldTime ()))
+
         , mValidations (make_Validations (*this))
 
         , m_loadManager (make_LoadManager (*this, *this, logs_->journal("LoadManager")))
@@ -582,6 +605,26 @@ public:
         return *m_ledgerMaster;
     }
 
+    LedgerPersister& getLedgerPersister () override
+    {
+        return *m_ledgerPersister;
+    }
+
+    AccountTxIndex* getAccountTxIndex () override
+    {
+        return m_accountTxIndex.get ();
+    }
+
+    TxStore* getTxStore () override
+    {
+        return m_txStore.get ();
+    }
+
+    void setTxStore (std::unique_ptr<TxStore> store) override
+    {
+        m_txStore = std::move (store);
+    }
+
     InboundLedgers& getInboundLedgers () override
     {
         return *m_inboundLedgers;
@@ -648,6 +691,12 @@ public:
         return cachedSLEs_;
     }
 
+    RPC::ResultCache&
+    getRPCResultCache () override
+    {
+        return rpcResultCache_;
+    }
+
     AmendmentTable& getAmendmentTable() override
     {
         return *m_amendmentTable;
@@ -668,6 +717,11 @@ public:
         return *mHashRouter;
     }
 
+    TxCheckCache& getTxCheckCache () override
+    {
+        return *txCheckCache_;
+    }
+
     Validations& getValidations () override
     {
         return *mValidations;
@@ -746,9 +800,14 @@ public:
         DatabaseCon::Setup setup = setup_DatabaseCon (*config_);
         auto const& trasactionDatabse = config_->section (SECTION_TX_DB);
         std::string type = get<std::string> (trasactionDatabse, "type");
+        // Sessions used by queries, apart from the one saving ledgers.
+        // The default matches the jtCLIENT_DB job limit.
+        auto const readers = get<std::size_t> (
+            trasactionDatabse, "read_connections", 4);
         if (type.empty () || type == "sqlite")
-            mTxnDB = std::make_unique <DatabaseCon> (setup, "transaction.db",
-                TxnDBInit, TxnDBCount);
+            mTxnDB = std::make_unique <DatabaseCon> (setup,
+                DatabaseCon::Type::Sqlite, "transaction.db",
+                    TxnDBInit, TxnDBCount, readers);
         else if (type == "mysql")
         {
             auto const& params = config_->section (SECTION_TX_DB);
@@ -760,7 +819,7 @@ public:
                                      get<std::string> (params, "password"))
                                         .str ();
             mTxnDB = std::make_unique <DatabaseCon> (setup, DatabaseCon::Type::MySQL, connectionString,
-                TxnDBInitMySQL, TxnDBCountMySQL);
+                TxnDBInitMySQL, TxnDBCountMySQL, readers);
         }
         else if (type == "none")
         {
@@ -36,6 +36,7 @@ namespace ripple {
 namespace unl { class Manager; }
 namespace Resource { class Manager; }
 namespace NodeStore { class Database; }
+namespace RPC { class ResultCache; }
 
 // VFALCO TODO Fix forward declares required for header dependency loops
 class AmendmentTable;
@@ -44,6 +45,7 @@ class CachedSLEs;
 class CollectorManager;
 class Family;
 class HashRouter;
+class TxCheckCache;
 class Logs;
 class LoadFeeTrack;
 class LocalCredentials;
@@ -52,7 +54,9 @@ class JobQueue;
 class InboundLedgers;
 class InboundTransactions;
 class AcceptedLedger;
+class AccountTxIndex;
 class LedgerMaster;
+class LedgerPersister;
 class LoadManager;
 class NetworkOPs;
 class OpenLedger;
@@ -65,6 +69,7 @@ class STLedgerEntry;
 class TimeKeeper;
 class TransactionMaster;
 class TxQ;
+class TxStore;
 class Validations;
 class Cluster;
 
@@ -113,6 +118,7 @@ public:
     virtual JobQueue&               getJobQueue () = 0;
     virtual NodeCache&              getTempNodeCache () = 0;
     virtual CachedSLEs&             cachedSLEs() = 0;
+    virtual RPC::ResultCache&       getRPCResultCache () = 0;
     virtual AmendmentTable&         getAmendmentTable() = 0;
     virtual DividendMaster&         getDividendMaster() = 0;
     virtual HashRouter&             getHashRouter () = 0;
@@ -120,6 +126,7 @@ public:
     virtual LoadManager&            getLoadManager () = 0;
     virtual Overlay&                overlay () = 0;
     virtual TxQ&                    getTxQ() = 0;
+    virtual TxCheckCache&           getTxCheckCache() = 0;
     virtual UniqueNodeList&         getUNL () = 0;
     virtual Cluster&                cluster () = 0;
     virtual Validations&            getValidations () = 0;
@@ -129,6 +136,14 @@ public:
     virtual TaggedCache <uint256, AcceptedLedger>&
                                     getAcceptedLedgerCache () = 0;
     virtual LedgerMaster&           getLedgerMaster () = 0;
+    virtual LedgerPersister&        getLedgerPersister () = 0;
+    /** Returns nullptr unless [account_tx_index] is configured. */
+    virtual AccountTxIndex*         getAccountTxIndex () = 0;
+    /** Returns nullptr unless an external store was installed. */
+    virtual TxStore*                getTxStore () = 0;
+    /** Install an external transaction store, during setup only. */
+    virtual void                    setTxStore (
+                                        std::unique_ptr<TxStore> store) = 0;
     virtual NetworkOPs&             getOPs () = 0;
     virtual OrderBookDB&            getOrderBookDB () = 0;
     virtual TransactionMaster&      getMasterTransaction () = 0;
@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_MISC_ACCOUNTTXINDEX_H_INCLUDED
+#define RIPPLE_APP_MISC_ACCOUNTTXINDEX_H_INCLUDED
+
+#include <ripple/basics/BasicConfig.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/Protocol.h>
+#include <beast/utility/Journal.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ripple {
+
+/** The positions of account transactions, kept outside of SQL.
+
+    Entries are keyed by the binary account, the ledger sequence and the
+    transaction's index in the ledger, so the transactions of an account
+    form one sorted run and finding a page is a seek followed by a short
+    scan, wherever the marker points. The index remembers which ledgers
+    it holds, and callers must check that it covers a range before
+    trusting an empty or short answer.
+*/
+class AccountTxIndex
+{
+public:
+    struct Entry
+    {
+        AccountID account;
+        std::uint32_t txnSeq;
+        uint256 id;
+    };
+
+    struct Position
+    {
+        LedgerIndex ledgerSeq;
+        std::uint32_t txnSeq;
+        uint256 id;
+    };
+
+    virtual ~AccountTxIndex () = default;
+
+    /** Add the account transactions of a validated ledger.
+        Entries from an earlier insert of the same ledger are replaced.
+        The entries and the ledger are written atomically.
+        Throws on error.
+    */
+    virtual void insert (LedgerIndex seq,
+        std::vector<Entry> const& entries) = 0;
+
+    /** Remove every ledger before seq and its entries.
+        The ledgers stop being covered before their entries go.
+        Throws on error.
+    */
+    virtual void clearPrior (LedgerIndex seq) = 0;
+
+    /** Returns `true` if every ledger in [first, last] is indexed. */
+    virtual bool covers (LedgerIndex first, LedgerIndex last) const = 0;
+
+    /** Return positions of an account's transactions.
+        The scan starts at (ledgerSeq, txnSeq) inclusive, moves forward
+        or backward, and stops after limit positions or when it passes
+        endLedger.
+    */
+    virtual std::vector<Position> getPositions (
+        AccountID const& account, LedgerIndex ledgerSeq,
+            std::uint32_t txnSeq, LedgerIndex endLedger, bool forward,
+                std::size_t limit) const = 0;
+};
+
+/** Open the index described by the [account_tx_index] section.
+    @return The index, or nullptr if none is configured.
+*/
+std::unique_ptr<AccountTxIndex>
+make_AccountTxIndex (Section const& section, beast::Journal journal);
+
+} // ripple
+
+#endif
@@ -120,15 +120,15 @@ public:
         uint64_t sumEnergy = 0;
         uint32_t accountsCounter = 0;
 
-        auto accountVisitor = [&](SLE::ref sle)
+        auto accountVisitor = [&](SLEView const& sle)
         {
-            if (sle->getType () != ltACCOUNT_ROOT)
+            if (sle.getType () != ltACCOUNT_ROOT)
                 return;
                 
             accountsCounter++;
             
-            auto account = sle->getAccountID (sfAccount);
-            auto balance = sle->getFieldAmount (sfBalance).mantissa ();
+            auto account = sle.getAccountID (sfAccount);
+            auto balance = sle.getFieldAmount (sfBalance).mantissa ();
             if (balance < XRS_DIVIDEND_MIN)
             {
                 JLOG (m_journal.debug) << "Account: " << account << " passed, balance " << balance <<" less than 1";
@@ -140,7 +140,7 @@ public:
             {
                 std::tie (iter, result) = accounts.emplace (account, std::make_shared<QuantumData>(account, balance));
             }
-            uint32_t linksCount = sle->getFieldU32 (sfQuantumLinksCount);
+            uint32_t linksCount = sle.getFieldU32 (sfQuantumLinksCount);
             if (linksCount == 0)
                 return;
             
@@ -208,7 +208,7 @@ public:
             iter->second->linksCount = linksCount;
 
         };
-        ledger->visitStateItems (accountVisitor);
+        ledger->visitStateViews (accountVisitor);
         m_quantumDivTotalAccounts = accountsCounter;
         JLOG (m_journal.info) << "accounts size: " << accounts.size ();
 
@@ -240,11 +240,11 @@ public:
         }
 
         // calc collect energy
-        auto accountVisitor1 = [&](SLE::ref sle)
+        auto accountVisitor1 = [&](SLEView const& sle)
         {
-            if (sle->getType () != ltACCOUNT_ROOT)
+            if (sle.getType () != ltACCOUNT_ROOT)
                 return;
-            auto account = sle->getAccountID (sfAccount);
+            auto account = sle.getAccountID (sfAccount);
             auto iter = accounts.find (account);
             if (iter == accounts.end ())
                 return;
@@ -290,7 +290,7 @@ public:
             
             JLOG (m_journal.debug) << "Calc account:" << account << " collect energy:" << energyC << " transfer energy:" << energyT << " final energy:" << accountEnergy;
         };
-        ledger->visitStateItems (accountVisitor1);
+        ledger->visitStateViews (accountVisitor1);
         
         // calc total dividend coins
         calcDividendCoins (ledger);
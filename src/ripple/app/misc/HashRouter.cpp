@@ -109,4 +109,20 @@ bool HashRouter::swapSet (uint256 const& key, std::set<PeerShortID>& peers, int
     return true;
 }
 
+bool HashRouter::setFlagsGetPeers (uint256 const& key, int flag,
+    std::set<PeerShortID>& peers)
+{
+    std::lock_guard <std::mutex> lock (mMutex);
+
+    auto& s = emplace(key).first;
+
+    if ((s.getFlags () & flag) == flag)
+        return false;
+
+    s.setFlags (flag);
+    peers = s.peekPeers ();
+
+    return true;
+}
+
 } // ripple
@@ -151,6 +151,16 @@ public:
 
     bool swapSet (uint256 const& key, std::set<PeerShortID>& peers, int flag);
 
+    /** Set a flag and copy the peers that have delivered the hash.
+
+        Together with addSuppressionPeer this lets a caller see each peer
+        exactly once: either in the copy, or with the flag already set.
+
+        @return `true` if the flag was changed. `false` if unchanged.
+    */
+    bool setFlagsGetPeers (uint256 const& key, int flag,
+        std::set<PeerShortID>& peers);
+
 private:
     // pair.second indicates whether the entry was created
     std::pair<Entry&, bool> emplace (uint256 const&);
@@ -24,6 +24,7 @@
 #include <ripple/app/ledger/Consensus.h>
 #include <ripple/app/ledger/LedgerConsensus.h>
 #include <ripple/app/ledger/AcceptedLedger.h>
+#include <ripple/app/ledger/BookIndex.h>
 #include <ripple/app/ledger/InboundLedger.h>
 #include <ripple/app/ledger/InboundLedgers.h>
 #include <ripple/app/ledger/LedgerMaster.h>
@@ -43,6 +44,7 @@
 #include <ripple/app/misc/impl/AccountTxPaging.h>
 #include <ripple/app/misc/UniqueNodeList.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/app/tx/PreclaimCache.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/Time.h>
@@ -57,6 +59,7 @@
 #include <ripple/crypto/RFC1751.h>
 #include <ripple/json/to_string.h>
 #include <ripple/ledger/Sandbox.h>
+#include <ripple/net/StreamMessage.h>
 #include <ripple/overlay/ClusterNode.h>
 #include <ripple/overlay/Cluster.h>
 #include <ripple/overlay/Overlay.h>
@@ -65,6 +68,7 @@
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/HashPrefix.h>
 #include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/StreamEvent.h>
 #include <ripple/resource/Fees.h>
 #include <ripple/resource/Gossip.h>
 #include <ripple/resource/ResourceManager.h>
@@ -74,6 +78,7 @@
 #include <beast/utility/make_lock.h>
 #include <boost/optional.hpp>
 #include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <tuple>
@@ -96,6 +101,7 @@ class NetworkOPsImp final
         bool local;
         FailHard failType;
         bool applied;
+        bool relay;
         TER result;
 
         TransactionStatus (
@@ -107,7 +113,28 @@ class NetworkOPsImp final
             , admin (a)
             , local (l)
             , failType (f)
+            , applied (false)
+            , relay (false)
+            , result (tesSUCCESS)
         {}
+
+        ApplyFlags flags () const
+        {
+            // we check the signature before adding to the batch
+            ApplyFlags flags = tapNO_CHECK_SIGN;
+            if (admin)
+                flags = flags | tapUNLIMITED;
+            return flags;
+        }
+    };
+
+    /**
+     * An applied batch waiting to be published and relayed.
+     */
+    struct PublishBatch
+    {
+        std::shared_ptr<ReadView const> view;
+        std::vector<TransactionStatus> transactions;
     };
 
     /**
@@ -200,6 +227,7 @@ public:
         , m_job_queue (job_queue)
         , m_standalone (standalone)
         , m_network_quorum (start_valid ? 0 : network_quorum)
+        , mBookIndex (journal)
         , accounting_ ()
     {
     }
@@ -259,6 +287,12 @@ public:
      */
     void apply (std::unique_lock<std::mutex>& batchLock);
 
+    /**
+     * Publish applied transactions to subscribers and relay them to peers.
+     * Runs in its own job so the next batch need not wait for it.
+     */
+    void publishBatches();
+
     //
     // Owner functions.
     //
@@ -543,12 +577,20 @@ private:
     // The number of nodes that we need to consider ourselves connected.
     std::size_t const m_network_quorum;
 
+    // Offers and owner funds of the books read by book_offers.
+    BookIndex mBookIndex;
+
     // Transaction batching.
     std::condition_variable mCond;
     std::mutex mMutex;
     DispatchState mDispatchState = DispatchState::none;
     std::vector <TransactionStatus> mTransactions;
 
+    // Applied batches, in order, waiting for the publisher.
+    std::mutex mPublishMutex;
+    std::deque <PublishBatch> mPublish;
+    bool mPublishing = false;
+
     StateAccounting accounting_;
 };
 
@@ -913,6 +955,16 @@ void NetworkOPsImp::apply (std::unique_lock<std::mutex>& batchLock)
 
     batchLock.unlock();
 
+    // Preflight and preclaim only read the ledger, so the whole batch is
+    // checked in parallel against a snapshot before any lock is taken.
+    // New transactions keep arriving in mTransactions meanwhile.
+    PreclaimCache checked (app_.openLedger().current());
+    for (TransactionStatus const& e : transactions)
+        checked.insert (e.transaction->getSTransaction(), e.flags());
+    m_job_queue.parallelFor (jtBATCH, "checkBatch", checked.size(),
+        [&](std::size_t i) { checked.check (i, app_, m_journal); });
+
+    PublishBatch published;
     {
         auto lock = beast::make_lock(app_.getMasterMutex());
         {
@@ -925,14 +977,9 @@ void NetworkOPsImp::apply (std::unique_lock<std::mutex>& batchLock)
                 bool changed = false;
                 for (TransactionStatus& e : transactions)
                 {
-                    // we check before addingto the batch
-                    ApplyFlags flags = tapNO_CHECK_SIGN;
-                    if (e.admin)
-                        flags = flags | tapUNLIMITED;
-
                     auto const result = app_.getTxQ().apply(
                         app_, view, e.transaction->getSTransaction(),
-                        flags, j);
+                        e.flags(), j, &checked);
                     e.result = result.first;
                     e.applied = result.second;
                     changed = changed || result.second;
@@ -941,15 +988,9 @@ void NetworkOPsImp::apply (std::unique_lock<std::mutex>& batchLock)
             });
         }
 
-        auto newOL = app_.openLedger().current();
+        published.view = app_.openLedger().current();
         for (TransactionStatus& e : transactions)
         {
-            if (e.applied)
-            {
-                pubProposedTransaction (newOL,
-                    e.transaction->getSTransaction(), e.result);
-            }
-
             e.transaction->setResult (e.result);
 
             if (isTemMalformed (e.result))
@@ -1016,29 +1057,24 @@ void NetworkOPsImp::apply (std::unique_lock<std::mutex>& batchLock)
                     e.transaction->getSTransaction());
             }
 
-            if (e.applied || ((mMode != omFULL) &&
+            e.relay = e.applied || ((mMode != omFULL) &&
                 (e.failType != FailHard::yes) && e.local) ||
-                    (e.result == terQUEUED))
-            {
-                std::set<Peer::id_t> peers;
+                    (e.result == terQUEUED);
 
-                if (app_.getHashRouter().swapSet (
-                        e.transaction->getID(), peers, SF_RELAYED))
-                {
-                    protocol::TMTransaction tx;
-                    Serializer s;
+            if (e.applied || e.relay)
+                published.transactions.push_back (e);
+        }
+    }
 
-                    e.transaction->getSTransaction()->add (s);
-                    tx.set_rawtransaction (&s.getData().front(), s.getLength());
-                    tx.set_status (protocol::tsCURRENT);
-                    tx.set_receivetimestamp (app_.timeKeeper().now().time_since_epoch().count());
-                    tx.set_deferred(e.result == terQUEUED);
-                    // FIXME: This should be when we received it
-                    app_.overlay().foreach (send_if_not (
-                        std::make_shared<Message> (tx, protocol::mtTRANSACTION),
-                        peer_in_set(peers)));
-                }
-            }
+    if (! published.transactions.empty())
+    {
+        std::lock_guard<std::mutex> lock (mPublishMutex);
+        mPublish.push_back (std::move (published));
+        if (! mPublishing)
+        {
+            m_job_queue.addJob (jtPUBTXN, "publishTransactions",
+                                [this] (Job&) { publishBatches(); });
+            mPublishing = true;
         }
     }
 
@@ -1052,6 +1088,55 @@ void NetworkOPsImp::apply (std::unique_lock<std::mutex>& batchLock)
     mDispatchState = DispatchState::none;
 }
 
+void NetworkOPsImp::publishBatches()
+{
+    for (;;)
+    {
+        PublishBatch batch;
+        {
+            std::lock_guard<std::mutex> lock (mPublishMutex);
+            if (mPublish.empty())
+            {
+                mPublishing = false;
+                return;
+            }
+            batch = std::move (mPublish.front());
+            mPublish.pop_front();
+        }
+
+        for (TransactionStatus const& e : batch.transactions)
+        {
+            if (e.applied)
+            {
+                pubProposedTransaction (batch.view,
+                    e.transaction->getSTransaction(), e.result);
+            }
+
+            if (! e.relay)
+                continue;
+
+            std::set<Peer::id_t> peers;
+
+            if (app_.getHashRouter().swapSet (
+                    e.transaction->getID(), peers, SF_RELAYED))
+            {
+                protocol::TMTransaction tx;
+                Serializer s;
+
+                e.transaction->getSTransaction()->add (s);
+                tx.set_rawtransaction (&s.getData().front(), s.getLength());
+                tx.set_status (protocol::tsCURRENT);
+                tx.set_receivetimestamp (app_.timeKeeper().now().time_since_epoch().count());
+                tx.set_deferred(e.result == terQUEUED);
+                // FIXME: This should be when we received it
+                app_.overlay().foreach (send_if_not (
+                    std::make_shared<Message> (tx, protocol::mtTRANSACTION),
+                    peer_in_set(peers)));
+            }
+        }
+    }
+}
+
 //
 // Owner functions
 //
@@ -1615,13 +1700,15 @@ void NetworkOPsImp::pubValidation (STValidation::ref val)
         jvObj [jss::ledger_hash]           = to_string (val->getLedgerHash ());
         jvObj [jss::signature]             = strHex (val->getSignature ());
 
+        std::string sObj = to_string (jvObj);
+
         for (auto i = mSubValidations.begin (); i != mSubValidations.end (); )
         {
             InfoSub::pointer p = i->second.lock ();
 
             if (p)
             {
-                p->send (jvObj, true);
+                p->send (jvObj, sObj, true);
                 ++i;
             }
             else
@@ -1643,18 +1730,20 @@ void NetworkOPsImp::pubPeerStatus (
 
         jvObj [jss::type]                  = "peerStatusChange";
 
+        std::string sObj = to_string (jvObj);
+
         for (auto i = mSubPeerStatus.begin (); i != mSubPeerStatus.end (); )
         {
             InfoSub::pointer p = i->second.lock ();
 
             if (p)
             {
-                p->send (jvObj, true);
+                p->send (jvObj, sObj, true);
                 ++i;
             }
             else
             {
-                i = mSubValidations.erase (i);
+                i = mSubPeerStatus.erase (i);
             }
         }
     }
@@ -1787,7 +1876,7 @@ NetworkOPs::AccountTxs NetworkOPsImp::getAccountTxs (
 
     {
         bool isMySQL = app_.getTxnDB ().getType () == DatabaseCon::Type::MySQL;
-        auto db = app_.getTxnDB ().checkoutDb ();
+        auto db = app_.getTxnDB ().checkoutReadDb ();
 
         boost::optional<std::uint64_t> ledgerSeq;
         boost::optional<std::string> status;
@@ -1871,7 +1960,7 @@ std::vector<NetworkOPsImp::txnMetaLedgerType> NetworkOPsImp::getAccountTxsB (
         bUnlimited);
 
     {
-        auto db = app_.getTxnDB ().checkoutDb ();
+        auto db = app_.getTxnDB ().checkoutReadDb ();
 
         boost::optional<std::uint64_t> ledgerSeq;
         boost::optional<std::string> status;
@@ -1931,7 +2020,8 @@ NetworkOPsImp::getTxsAccount (
         std::bind(saveLedgerAsync, std::ref(app_),
             std::placeholders::_1), bound, account, minLedger,
                 maxLedger, forward, token, limit, bUnlimited,
-                    page_length);
+                    page_length, app_.getAccountTxIndex (),
+                        app_.getTxStore ());
 
     return ret;
 }
@@ -1959,7 +2049,8 @@ NetworkOPsImp::getTxsAccountB (
         std::bind(saveLedgerAsync, std::ref(app_),
             std::placeholders::_1), bound, account, minLedger,
                 maxLedger, forward, token, limit, bUnlimited,
-                    page_length);
+                    page_length, app_.getAccountTxIndex (),
+                        app_.getTxStore ());
     return ret;
 }
 
@@ -2173,11 +2264,21 @@ void NetworkOPsImp::pubProposedTransaction (
     std::shared_ptr<ReadView const> const& lpCurrent,
     std::shared_ptr<STTx const> const& stTxn, TER terResult)
 {
-    Json::Value jvObj   = transJson (*stTxn, terResult, false, lpCurrent);
-
     {
         ScopedLockType sl (mSubLock);
 
+        // Built once, for every subscriber
+        StreamMessage message (
+            [&]
+            {
+                return transJson (*stTxn, terResult, false, lpCurrent);
+            },
+            [&]
+            {
+                return NetworkOPs_transBinary (
+                    *stTxn, terResult, false, *lpCurrent, Slice (nullptr, 0));
+            });
+
         auto it = mSubRTTransactions.begin ();
         while (it != mSubRTTransactions.end ())
         {
@@ -2185,7 +2286,7 @@ void NetworkOPsImp::pubProposedTransaction (
 
             if (p)
             {
-                p->send (jvObj, true);
+                message.send (*p, true);
                 ++it;
             }
             else
@@ -2206,6 +2307,9 @@ void NetworkOPsImp::pubLedger (Ledger::ref lpAccepted)
     // Ledgers are published only when they acquire sufficient validations
     // Holes are filled across connection loss or other catastrophe
 
+    // Keep the chain of book snapshots going, so book_offers stays warm
+    mBookIndex.get (lpAccepted);
+
     std::shared_ptr<AcceptedLedger> alpAccepted =
         app_.getAcceptedLedgerCache().fetch (lpAccepted->info().hash);
     if (! alpAccepted)
@@ -2243,13 +2347,28 @@ void NetworkOPsImp::pubLedger (Ledger::ref lpAccepted)
                         = app_.getLedgerMaster ().getCompleteLedgers ();
             }
 
+            StreamMessage message (
+                [&]
+                {
+                    return jvObj;
+                },
+                [&]
+                {
+                    auto const& info = lpAccepted->info();
+                    Serializer s;
+                    addRaw (info, s);
+                    return encodeStreamEvent (StreamEvent::ledgerClosed,
+                        StreamEvent::validated, info.seq, info.closeTime,
+                            0, s.slice(), Slice (nullptr, 0));
+                });
+
             auto it = mSubLedger.begin ();
             while (it != mSubLedger.end ())
             {
                 InfoSub::pointer p = it->second.lock ();
                 if (p)
                 {
-                    p->send (jvObj, true);
+                    message.send (*p, true);
                     ++it;
                 }
                 else
@@ -2335,17 +2454,39 @@ Json::Value NetworkOPs_transJson(
     return jvObj;
 }
 
+std::string NetworkOPs_transBinary (
+        const STTx& stTxn, TER terResult, bool bValidated,
+        ReadView const& lpCurrent, Slice const& meta)
+{
+    auto const& info = lpCurrent.info();
+    Serializer s;
+    stTxn.add (s);
+    return encodeStreamEvent (StreamEvent::transaction,
+        bValidated ? StreamEvent::validated : 0, info.seq,
+            bValidated ? info.closeTime : 0, terResult, s.slice(), meta);
+}
+
 void NetworkOPsImp::pubValidatedTransaction (
     Ledger::ref alAccepted, const AcceptedLedgerTx& alTx)
 {
-    Json::Value jvObj;
-
-    std::string sObj;
-    bool bSobjInitialized = false;
-
     {
         ScopedLockType sl (mSubLock);
 
+        StreamMessage message (
+            [&]
+            {
+                auto jvObj = transJson (*alTx.getTxn (), alTx.getResult (),
+                    true, alAccepted);
+                jvObj[jss::meta] = alTx.getMeta ()->getJson (0);
+                return jvObj;
+            },
+            [&]
+            {
+                return NetworkOPs_transBinary (*alTx.getTxn (),
+                    alTx.getResult (), true, *alAccepted,
+                        makeSlice (alTx.getMetaBlob ()));
+            });
+
         auto it = mSubTransactions.begin ();
         while (it != mSubTransactions.end ())
         {
@@ -2353,13 +2494,7 @@ void NetworkOPsImp::pubValidatedTransaction (
 
             if (p)
             {
-                if (!bSobjInitialized) {
-                    jvObj = transJson (*alTx.getTxn (), alTx.getResult (), true, alAccepted);
-                    jvObj[jss::meta] = alTx.getMeta ()->getJson (0);
-                    sObj = to_string (jvObj);
-                    bSobjInitialized = true;
-                }
-                p->send (jvObj, sObj, true);
+                message.send (*p, true);
                 ++it;
             }
             else
@@ -2374,13 +2509,7 @@ void NetworkOPsImp::pubValidatedTransaction (
 
             if (p)
             {
-                if (!bSobjInitialized) {
-                    jvObj = transJson (*alTx.getTxn (), alTx.getResult (), true, alAccepted);
-                    jvObj[jss::meta] = alTx.getMeta ()->getJson (0);
-                    sObj = to_string (jvObj);
-                    bSobjInitialized = true;
-                }
-                p->send (jvObj, sObj, true);
+                message.send (*p, true);
                 ++it;
             }
             else
@@ -2461,17 +2590,26 @@ void NetworkOPsImp::pubAccountTransaction (
 
     if (!notify.empty ())
     {
-        Json::Value jvObj = transJson (
-            *alTx.getTxn (), alTx.getResult (), bAccepted, lpCurrent);
-
-        if (alTx.isApplied ())
-            jvObj[jss::meta] = alTx.getMeta ()->getJson (0);
+        StreamMessage message (
+            [&]
+            {
+                auto jvObj = transJson (
+                    *alTx.getTxn (), alTx.getResult (), bAccepted, lpCurrent);
 
-        std::string sObj = to_string (jvObj);
+                if (alTx.isApplied ())
+                    jvObj[jss::meta] = alTx.getMeta ()->getJson (0);
+                return jvObj;
+            },
+            [&]
+            {
+                return NetworkOPs_transBinary (*alTx.getTxn (),
+                    alTx.getResult (), bAccepted, *lpCurrent,
+                        makeSlice (alTx.getMetaBlob ()));
+            });
 
         for (InfoSub::ref isrListener : notify)
         {
-            isrListener->send (jvObj, sObj, true);
+            message.send (*isrListener, true);
         }
     }
 }
@@ -2757,203 +2895,132 @@ void NetworkOPsImp::getBookPage (
             (jvResult[jss::offers] = Json::Value (Json::arrayValue));
 
     std::map<AccountID, STAmount> umBalance;
-    const uint256   uBookBase   = getBookBase (book);
-    const uint256   uBookEnd    = getQualityNext (uBookBase);
-    uint256         uTipIndex   = uBookBase;
 
-    if (m_journal.trace)
-    {
-        m_journal.trace << "getBookPage:" << book;
-        m_journal.trace << "getBookPage: uBookBase=" << uBookBase;
-        m_journal.trace << "getBookPage: uBookEnd=" << uBookEnd;
-        m_journal.trace << "getBookPage: uTipIndex=" << uTipIndex;
-    }
+    m_journal.trace << "getBookPage:" << book;
 
-    Sandbox view (&*lpLedger, tapNONE);
+    auto const snapshot = mBookIndex.get (lpLedger);
+    auto const& view = *snapshot->ledger ();
 
     bool const bGlobalFreeze =
         isGlobalFrozen(view, book.out.account) ||
             isGlobalFrozen(view, book.in.account);
 
-    bool            bDone           = false;
-    bool            bDirectAdvance  = true;
-
-    std::shared_ptr<SLE const> sleOfferDir;
-    uint256         offerIndex;
-    unsigned int    uBookEntry;
-    STAmount        saDirRate;
-
     auto uTransferRate = rippleTransferRate(view, book.out.account);
-    auto viewJ = app_.journal ("View");
 
     unsigned int left (iLimit == 0 ? 300 : iLimit);
     if (! bUnlimited && left > 300)
         left = 300;
 
-    while (!bDone && left-- > 0)
+    auto const offers = snapshot->offers (book, left);
+    for (auto const& offer : *offers)
     {
-        if (bDirectAdvance)
-        {
-            bDirectAdvance  = false;
-
-            m_journal.trace << "getBookPage: bDirectAdvance";
+        if (left-- == 0)
+            break;
 
-            auto const ledgerIndex = view.succ(uTipIndex, uBookEnd);
-            if (ledgerIndex)
-                sleOfferDir = view.read(keylet::page(*ledgerIndex));
-            else
-                sleOfferDir.reset();
+        auto const& sleOffer = offer.sle;
+        auto const& saDirRate = offer.quality;
+        auto const uOfferOwnerID =
+                sleOffer->getAccountID (sfAccount);
+        auto const& saTakerGets =
+                sleOffer->getFieldAmount (sfTakerGets);
+        auto const& saTakerPays =
+                sleOffer->getFieldAmount (sfTakerPays);
+        STAmount saOwnerFunds;
+        bool firstOwnerOffer (true);
 
-            if (!sleOfferDir)
+        if (book.out.account == uOfferOwnerID)
+        {
+            // If an offer is selling issuer's own IOUs, it is fully
+            // funded.
+            saOwnerFunds    = saTakerGets;
+        }
+        else if (bGlobalFreeze)
+        {
+            // If either asset is globally frozen, consider all offers
+            // that aren't ours to be totally unfunded
+            saOwnerFunds.clear (book.out);
+        }
+        else
+        {
+            auto umBalanceEntry  = umBalance.find (uOfferOwnerID);
+            if (umBalanceEntry != umBalance.end ())
             {
-                m_journal.trace << "getBookPage: bDone";
-                bDone           = true;
+                // Found in running balance table.
+
+                saOwnerFunds    = umBalanceEntry->second;
+                firstOwnerOffer = false;
             }
             else
             {
-                uTipIndex = sleOfferDir->getIndex ();
-                saDirRate = amountFromQuality (getQuality (uTipIndex));
+                // Did not find balance in table.
 
-                cdirFirst (view,
-                    uTipIndex, sleOfferDir, uBookEntry, offerIndex, viewJ);
-
-                m_journal.trace << "getBookPage:   uTipIndex=" << uTipIndex;
-                m_journal.trace << "getBookPage: offerIndex=" << offerIndex;
+                saOwnerFunds = snapshot->ownerFunds (
+                    uOfferOwnerID, book.out);
             }
         }
 
-        if (!bDone)
-        {
-            auto sleOffer = view.read(keylet::offer(offerIndex));
-
-            if (sleOffer)
-            {
-                auto const uOfferOwnerID =
-                        sleOffer->getAccountID (sfAccount);
-                auto const& saTakerGets =
-                        sleOffer->getFieldAmount (sfTakerGets);
-                auto const& saTakerPays =
-                        sleOffer->getFieldAmount (sfTakerPays);
-                STAmount saOwnerFunds;
-                bool firstOwnerOffer (true);
-
-                if (book.out.account == uOfferOwnerID)
-                {
-                    // If an offer is selling issuer's own IOUs, it is fully
-                    // funded.
-                    saOwnerFunds    = saTakerGets;
-                }
-                else if (bGlobalFreeze)
-                {
-                    // If either asset is globally frozen, consider all offers
-                    // that aren't ours to be totally unfunded
-                    saOwnerFunds.clear (book.out);
-                }
-                else
-                {
-                    auto umBalanceEntry  = umBalance.find (uOfferOwnerID);
-                    if (umBalanceEntry != umBalance.end ())
-                    {
-                        // Found in running balance table.
-
-                        saOwnerFunds    = umBalanceEntry->second;
-                        firstOwnerOffer = false;
-                    }
-                    else
-                    {
-                        // Did not find balance in table.
-
-                        saOwnerFunds = accountHolds (view,
-                            uOfferOwnerID, book.out.currency,
-                                book.out.account, fhZERO_IF_FROZEN, viewJ);
-
-                        if (saOwnerFunds < zero)
-                        {
-                            // Treat negative funds as zero.
-
-                            saOwnerFunds.clear ();
-                        }
-                    }
-                }
-
-                Json::Value jvOffer = sleOffer->getJson (0);
+        Json::Value jvOffer = offer.json;
 
-                STAmount    saTakerGetsFunded;
-                STAmount    saOwnerFundsLimit;
-                std::uint32_t uOfferRate;
+        STAmount    saTakerGetsFunded;
+        STAmount    saOwnerFundsLimit;
+        std::uint32_t uOfferRate;
 
 
-                if (uTransferRate != QUALITY_ONE
-                    // Have a tranfer fee.
-                    && uTakerID != book.out.account
-                    // Not taking offers of own IOUs.
-                    && book.out.account != uOfferOwnerID)
-                    // Offer owner not issuing ownfunds
-                {
-                    // Need to charge a transfer fee to offer owner.
-                    uOfferRate          = uTransferRate;
-                    saOwnerFundsLimit   = divide (
-                        saOwnerFunds,
-                        amountFromRate (uOfferRate),
-                        saOwnerFunds.issue ());
-                }
-                else
-                {
-                    uOfferRate          = QUALITY_ONE;
-                    saOwnerFundsLimit   = saOwnerFunds;
-                }
-
-                if (saOwnerFundsLimit >= saTakerGets)
-                {
-                    // Sufficient funds no shenanigans.
-                    saTakerGetsFunded   = saTakerGets;
-                }
-                else
-                {
-                    // Only provide, if not fully funded.
+        if (uTransferRate != QUALITY_ONE
+            // Have a tranfer fee.
+            && uTakerID != book.out.account
+            // Not taking offers of own IOUs.
+            && book.out.account != uOfferOwnerID)
+            // Offer owner not issuing ownfunds
+        {
+            // Need to charge a transfer fee to offer owner.
+            uOfferRate          = uTransferRate;
+            saOwnerFundsLimit   = divide (
+                saOwnerFunds,
+                amountFromRate (uOfferRate),
+                saOwnerFunds.issue ());
+        }
+        else
+        {
+            uOfferRate          = QUALITY_ONE;
+            saOwnerFundsLimit   = saOwnerFunds;
+        }
 
-                    saTakerGetsFunded   = saOwnerFundsLimit;
+        if (saOwnerFundsLimit >= saTakerGets)
+        {
+            // Sufficient funds no shenanigans.
+            saTakerGetsFunded   = saTakerGets;
+        }
+        else
+        {
+            // Only provide, if not fully funded.
 
-                    saTakerGetsFunded.setJson (jvOffer[jss::taker_gets_funded]);
-                    std::min (
-                        saTakerPays, multiply (
-                            saTakerGetsFunded, saDirRate, saTakerPays.issue ())).setJson
-                            (jvOffer[jss::taker_pays_funded]);
-                }
+            saTakerGetsFunded   = saOwnerFundsLimit;
 
-                STAmount saOwnerPays = (QUALITY_ONE == uOfferRate)
-                    ? saTakerGetsFunded
-                    : std::min (
-                        saOwnerFunds,
-                        multiply (
-                            saTakerGetsFunded,
-                            amountFromRate (uOfferRate),
-                            saTakerGetsFunded.issue ()));
+            saTakerGetsFunded.setJson (jvOffer[jss::taker_gets_funded]);
+            std::min (
+                saTakerPays, multiply (
+                    saTakerGetsFunded, saDirRate, saTakerPays.issue ())).setJson
+                    (jvOffer[jss::taker_pays_funded]);
+        }
 
-                umBalance[uOfferOwnerID]    = saOwnerFunds - saOwnerPays;
+        STAmount saOwnerPays = (QUALITY_ONE == uOfferRate)
+            ? saTakerGetsFunded
+            : std::min (
+                saOwnerFunds,
+                multiply (
+                    saTakerGetsFunded,
+                    amountFromRate (uOfferRate),
+                    saTakerGetsFunded.issue ()));
 
-                // Include all offers funded and unfunded
-                Json::Value& jvOf = jvOffers.append (jvOffer);
-                jvOf[jss::quality] = saDirRate.getText ();
+        umBalance[uOfferOwnerID]    = saOwnerFunds - saOwnerPays;
 
-                if (firstOwnerOffer)
-                    jvOf[jss::owner_funds] = saOwnerFunds.getText ();
-            }
-            else
-            {
-                m_journal.warning << "Missing offer";
-            }
+        // Include all offers funded and unfunded
+        Json::Value& jvOf = jvOffers.append (jvOffer);
+        jvOf[jss::quality] = saDirRate.getText ();
 
-            if (! cdirNext(view,
-                    uTipIndex, sleOfferDir, uBookEntry, offerIndex, viewJ))
-            {
-                bDirectAdvance  = true;
-            }
-            else
-            {
-                m_journal.trace << "getBookPage: offerIndex=" << offerIndex;
-            }
-        }
+        if (firstOwnerOffer)
+            jvOf[jss::owner_funds] = saOwnerFunds.getText ();
     }
 
     //  jvResult[jss::marker]  = Json::Value(Json::arrayValue);
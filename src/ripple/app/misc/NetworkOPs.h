@@ -245,6 +245,13 @@ Json::Value NetworkOPs_transJson (
         const STTx& stTxn, TER terResult, bool bValidated,
         std::shared_ptr<ReadView const> const& lpCurrent,
         Application& app);
+
+/** Encode a transaction as a binary stream event.
+    @param meta The serialized metadata, empty if not applied.
+*/
+std::string NetworkOPs_transBinary (
+        const STTx& stTxn, TER terResult, bool bValidated,
+        ReadView const& lpCurrent, Slice const& meta);
 } // ripple
 
 #endif
@@ -23,6 +23,7 @@
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/main/Application.h>
+#include <ripple/app/misc/AccountTxIndex.h>
 #include <ripple/basics/contract.h>
 #include <ripple/core/ConfigSections.h>
 #include <boost/format.hpp>
@@ -594,6 +595,22 @@ SHAMapStoreImp::clearPrior (LedgerIndex lastRotated)
     if (health())
         return;
 
+    // The index must stop answering for ledgers before their rows go
+    if (auto index = app_.getAccountTxIndex ())
+    {
+        try
+        {
+            index->clearPrior (lastRotated);
+        }
+        catch (std::exception const& e)
+        {
+            journal_.error << "account_tx_index: " << e.what ();
+            return;
+        }
+    }
+    if (health())
+        return;
+
     clearSql (*transactionDb_, lastRotated,
         "SELECT MIN(LedgerSeq) FROM Transactions;",
         "DELETE FROM Transactions WHERE LedgerSeq < %u;");
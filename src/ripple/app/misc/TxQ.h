@@ -27,11 +27,14 @@
 #include <ripple/core/LoadFeeTrack.h>
 #include <ripple/protocol/TER.h>
 #include <ripple/protocol/STTx.h>
+#include <ripple/basics/UnorderedContainers.h>
 #include <boost/intrusive/set.hpp>
+#include <array>
 
 namespace ripple {
 
 class Application;
+class PreclaimCache;
 
 namespace detail {
 
@@ -61,6 +64,13 @@ private:
 public:
     static const std::uint64_t baseLevel = 256;
 
+    /** The escalation parameters in effect for one open ledger. */
+    struct Snapshot
+    {
+        std::size_t txnsExpected;
+        std::uint32_t escalationMultiplier;
+    };
+
 public:
     FeeMetrics(bool standAlone, beast::Journal j)
         : targetTxnCount_(50)
@@ -79,10 +89,13 @@ public:
     @param view View of the LCL that was just closed or received.
     @param timeLeap Indicates that rippled is under load so fees
     should grow faster.
+    @param knownLevels Fee levels already computed when the
+    transactions were applied to the open ledger, by ID.
     */
     std::size_t
     updateFeeMetrics(Application& app,
-        ReadView const& view, bool timeLeap);
+        ReadView const& view, bool timeLeap,
+            hash_map<TxID, std::uint64_t> const& knownLevels = {});
 
     /** Used by tests only.
     */
@@ -113,8 +126,24 @@ public:
         return escalationMultiplier_;
     }
 
+    Snapshot
+    getSnapshot() const
+    {
+        std::lock_guard <std::mutex> sl(lock_);
+
+        return { txnsExpected_, escalationMultiplier_ };
+    }
+
+    std::uint64_t
+    scaleFeeLevel(OpenView const& view) const
+    {
+        return scaleFeeLevel(getSnapshot(), view);
+    }
+
+    static
     std::uint64_t
-    scaleFeeLevel(OpenView const& view) const;
+    scaleFeeLevel(Snapshot const& snapshot,
+        OpenView const& view);
 };
 
 }
@@ -192,11 +221,14 @@ public:
         @param txn The transaction to be attempted.
         @param params Flags to control engine behaviors.
         @param engine Transaction Engine.
+        @param checked If not null, preflight and preclaim results
+                       computed ahead of time, reused when still valid.
     */
     std::pair<TER, bool>
     apply(Application& app, OpenView& view,
         std::shared_ptr<STTx const> const& tx,
-            ApplyFlags flags, beast::Journal j);
+            ApplyFlags flags, beast::Journal j,
+                PreclaimCache const* checked = nullptr);
 
     /**
         Fill the new open ledger with transactions from the queue.
@@ -251,6 +283,12 @@ public:
     Json::Value
     doRPC(Application& app) const;
 
+    /** Queue depth and fee level distribution for the `tx_queue`
+        RPC command. Does not walk the queue.
+    */
+    Json::Value
+    doQueueRPC() const;
+
     /** Return the instantaneous fee to get into the current
         open ledger for a reference transaction.
     */
@@ -344,10 +382,24 @@ private:
     Setup const setup_;
     beast::Journal j_;
 
+    // Queued fee levels by power of two multiple of the base level
+    static std::size_t const feeBuckets = 16;
+
+    struct AppliedLevel
+    {
+        std::uint64_t feeLevel;
+        LedgerIndex seq;
+    };
+
     detail::FeeMetrics feeMetrics_;
     FeeMultiSet byFee_;
-    std::map <AccountID, TxQAccount> byAccount_;
+    hash_map <AccountID, TxQAccount> byAccount_;
     boost::optional<size_t> maxSize_;
+    std::array <std::size_t, feeBuckets> histogram_;
+
+    // Fee levels of the transactions applied to the open ledger,
+    // handed to the fee metrics once their ledger is validated.
+    hash_map <TxID, AppliedLevel> appliedLevels_;
 
     // Most queue operations are done under the master lock,
     // but use this mutex for the RPC "fee" command, which isn't.
@@ -363,6 +415,10 @@ private:
 
     FeeMultiSet::iterator_type erase(FeeMultiSet::const_iterator_type);
 
+    static
+    std::size_t
+    feeBucket(std::uint64_t feeLevel);
+
 };
 
 TxQ::Setup
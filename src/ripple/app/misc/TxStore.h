@@ -0,0 +1,77 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_MISC_TXSTORE_H_INCLUDED
+#define RIPPLE_APP_MISC_TXSTORE_H_INCLUDED
+
+#include <ripple/basics/Blob.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/Protocol.h>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ripple {
+
+/** A store of validated transactions kept outside of the SQL databases.
+
+    When one is installed, the tx, account_tx and tx_history RPC commands
+    read transaction history from it instead of the transaction database.
+    The methods throw on errors talking to the store.
+*/
+class TxStore
+{
+public:
+    struct Tx
+    {
+        LedgerIndex ledgerSeq;
+        std::uint32_t txnSeq;
+        Blob rawTxn;
+        Blob rawMeta;
+    };
+
+    virtual ~TxStore () = default;
+
+    /** Look up a transaction by its ID. */
+    virtual boost::optional<Tx> getTx (uint256 const& id) = 0;
+
+    /** Return transactions affecting an account.
+        The scan starts at (ledgerSeq, txnSeq) inclusive, moves forward
+        or backward, and stops after limit transactions or when it passes
+        endLedger. Index entries whose transaction is missing or was
+        replaced are skipped without counting toward the limit, so fewer
+        than limit transactions means the scan reached the end.
+    */
+    virtual std::vector<Tx> getAccountTxs (AccountID const& account,
+        LedgerIndex ledgerSeq, std::uint32_t txnSeq, LedgerIndex endLedger,
+            bool forward, std::size_t limit) = 0;
+
+    /** Return the most recent transactions.
+        Ledgers are visited from lastLedger down to firstLedger, newest
+        first, skipping the first startIndex transactions.
+    */
+    virtual std::vector<Tx> getTxHistory (LedgerIndex firstLedger,
+        LedgerIndex lastLedger, std::size_t startIndex,
+            std::size_t count) = 0;
+};
+
+} // ripple
+
+#endif
@@ -0,0 +1,457 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/app/misc/AccountTxIndex.h>
+#include <ripple/basics/contract.h>
+#include <ripple/basics/Log.h>
+#include <ripple/unity/rocksdb.h>
+#include <beast/utility/ci_char_traits.h>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <mutex>
+
+namespace ripple {
+
+#if RIPPLE_ROCKSDB_AVAILABLE
+
+namespace {
+
+// Entries:  'a' | account (20) | ledger seq (4) | txn seq (4) -> id (32)
+// Ledgers:  'l' | ledger seq (4) -> (account (20) | txn seq (4))...
+// Ranges:   'r' | first ledger seq (4)                      -> last seq (4)
+//
+// A ledger's record lists the entries it added, so they can be found
+// again to replace or remove the ledger.
+//
+// Integers are big endian so that keys sort numerically.
+
+char const entryPrefix = 'a';
+char const ledgerPrefix = 'l';
+char const rangePrefix = 'r';
+
+std::size_t const accountKeySize = 1 + 20;
+std::size_t const entryKeySize = accountKeySize + 4 + 4;
+std::size_t const ledgerKeySize = 1 + 4;
+std::size_t const ledgerRecordSize = 20 + 4;
+std::size_t const rangeKeySize = 1 + 4;
+
+// Ledger records deleted by one write while clearing
+std::size_t const clearBatchSize = 256;
+
+void
+put32 (std::string& s, std::uint32_t v)
+{
+    s.push_back (static_cast<char> (v >> 24));
+    s.push_back (static_cast<char> (v >> 16));
+    s.push_back (static_cast<char> (v >> 8));
+    s.push_back (static_cast<char> (v));
+}
+
+std::uint32_t
+get32 (char const* p)
+{
+    auto const u = reinterpret_cast<unsigned char const*> (p);
+    return (std::uint32_t (u[0]) << 24) | (std::uint32_t (u[1]) << 16) |
+        (std::uint32_t (u[2]) << 8) | std::uint32_t (u[3]);
+}
+
+std::string
+accountKey (AccountID const& account)
+{
+    std::string key;
+    key.reserve (entryKeySize);
+    key.push_back (entryPrefix);
+    key.append (reinterpret_cast<char const*> (account.data ()),
+        account.size ());
+    return key;
+}
+
+std::string
+entryKey (AccountID const& account,
+    std::uint32_t ledgerSeq, std::uint32_t txnSeq)
+{
+    auto key = accountKey (account);
+    put32 (key, ledgerSeq);
+    put32 (key, txnSeq);
+    return key;
+}
+
+std::string
+ledgerKey (std::uint32_t seq)
+{
+    std::string key (1, ledgerPrefix);
+    put32 (key, seq);
+    return key;
+}
+
+// Delete the entries listed in a ledger's record
+void
+deleteEntries (std::uint32_t seq, rocksdb::Slice const& record,
+    rocksdb::WriteBatch& wb)
+{
+    for (std::size_t i = 0; i + ledgerRecordSize <= record.size ();
+        i += ledgerRecordSize)
+    {
+        auto const p = record.data () + i;
+        std::string key (1, entryPrefix);
+        key.append (p, 20);
+        put32 (key, seq);
+        key.append (p + 20, 4);
+        wb.Delete (key);
+    }
+}
+
+std::string
+rangeKey (std::uint32_t first)
+{
+    std::string key (1, rangePrefix);
+    put32 (key, first);
+    return key;
+}
+
+std::string
+rangeValue (std::uint32_t last)
+{
+    std::string value;
+    put32 (value, last);
+    return value;
+}
+
+} // anonymous namespace
+
+class RocksDBAccountTxIndex : public AccountTxIndex
+{
+private:
+    using Ranges = std::map<std::uint32_t, std::uint32_t>;
+
+    beast::Journal j_;
+    std::unique_ptr<rocksdb::DB> db_;
+
+    // Held while changing the index
+    std::mutex writeMutex_;
+
+    // The ledgers in the index, first -> last
+    std::mutex mutable mutex_;
+    Ranges ranges_;
+
+public:
+    RocksDBAccountTxIndex (Section const& section, beast::Journal journal)
+        : j_ (journal)
+    {
+        std::string path;
+        if (! get_if_exists (section, "path", path))
+            Throw<std::runtime_error> ("Missing path in account_tx_index");
+
+        rocksdb::Options options;
+        rocksdb::BlockBasedTableOptions table_options;
+        options.create_if_missing = true;
+
+        if (section.exists ("cache_mb"))
+            table_options.block_cache = rocksdb::NewLRUCache (
+                get<int>(section, "cache_mb") * 1024L * 1024L);
+
+        get_if_exists (section, "open_files", options.max_open_files);
+
+        if (section.exists ("compression") &&
+            (get<int>(section, "compression") == 0))
+        {
+            options.compression = rocksdb::kNoCompression;
+        }
+
+        options.table_factory.reset (
+            NewBlockBasedTableFactory (table_options));
+
+        rocksdb::DB* db = nullptr;
+        rocksdb::Status status = rocksdb::DB::Open (options, path, &db);
+        if (! status.ok () || ! db)
+            Throw<std::runtime_error> (
+                std::string ("Unable to open/create RocksDB: ") +
+                    status.ToString ());
+        db_.reset (db);
+
+        std::unique_ptr<rocksdb::Iterator> it (
+            db_->NewIterator (rocksdb::ReadOptions ()));
+        for (it->Seek (std::string (1, rangePrefix)); it->Valid (); it->Next ())
+        {
+            auto const key = it->key ();
+            if (key.size () != rangeKeySize || key[0] != rangePrefix)
+                break;
+            if (it->value ().size () != 4)
+                continue;
+            ranges_[get32 (key.data () + 1)] = get32 (it->value ().data ());
+        }
+
+        JLOG (j_.info) << "Opened " << path << " with " <<
+            ranges_.size () << " ledger ranges";
+    }
+
+    void
+    insert (LedgerIndex seq, std::vector<Entry> const& entries) override
+    {
+        std::lock_guard<std::mutex> writeLock (writeMutex_);
+        rocksdb::WriteBatch wb;
+
+        // A ledger saved again may list other transactions
+        auto const key = ledgerKey (seq);
+        std::string record;
+        auto status = db_->Get (rocksdb::ReadOptions (), key, &record);
+        if (status.ok ())
+            deleteEntries (seq, record, wb);
+        else if (! status.IsNotFound ())
+            Throw<std::runtime_error> (
+                "account_tx_index read failed: " + status.ToString ());
+
+        record.clear ();
+        record.reserve (entries.size () * ledgerRecordSize);
+        for (auto const& e : entries)
+        {
+            wb.Put (entryKey (e.account, seq, e.txnSeq),
+                rocksdb::Slice (reinterpret_cast<char const*> (
+                    e.id.data ()), e.id.size ()));
+            record.append (reinterpret_cast<char const*> (
+                e.account.data ()), e.account.size ());
+            put32 (record, e.txnSeq);
+        }
+        wb.Put (key, record);
+
+        // The ledger is marked in the same batch as its entries
+        auto ranges = getRanges ();
+        addLedger (ranges, seq, wb);
+        write (wb);
+        setRanges (ranges);
+    }
+
+    void
+    clearPrior (LedgerIndex seq) override
+    {
+        std::lock_guard<std::mutex> writeLock (writeMutex_);
+
+        {
+            rocksdb::WriteBatch wb;
+            auto ranges = getRanges ();
+            removeLedgers (ranges, seq, wb);
+            write (wb);
+            setRanges (ranges);
+        }
+
+        // The entries are no longer trusted and can go in pieces
+        auto const end = ledgerKey (seq);
+        std::unique_ptr<rocksdb::Iterator> it (
+            db_->NewIterator (rocksdb::ReadOptions ()));
+        rocksdb::WriteBatch wb;
+        std::size_t ledgers = 0;
+        std::size_t count = 0;
+        for (it->Seek (std::string (1, ledgerPrefix)); it->Valid (); it->Next ())
+        {
+            auto const key = it->key ();
+            if (key.size () != ledgerKeySize || key[0] != ledgerPrefix ||
+                    key.compare (end) >= 0)
+                break;
+
+            deleteEntries (get32 (key.data () + 1), it->value (), wb);
+            wb.Delete (key);
+            ++ledgers;
+            if (++count == clearBatchSize)
+            {
+                write (wb);
+                wb.Clear ();
+                count = 0;
+            }
+        }
+        if (count != 0)
+            write (wb);
+
+        JLOG (j_.debug) << "Cleared " << ledgers <<
+            " ledgers before " << seq;
+    }
+
+    bool
+    covers (LedgerIndex first, LedgerIndex last) const override
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        auto it = ranges_.upper_bound (first);
+        if (it == ranges_.begin ())
+            return false;
+        --it;
+        return it->second >= last;
+    }
+
+    std::vector<Position>
+    getPositions (AccountID const& account, LedgerIndex ledgerSeq,
+        std::uint32_t txnSeq, LedgerIndex endLedger, bool forward,
+            std::size_t limit) const override
+    {
+        std::vector<Position> result;
+        if (limit == 0)
+            return result;
+
+        auto const prefix = accountKey (account);
+        auto const start = entryKey (account, ledgerSeq, txnSeq);
+
+        std::unique_ptr<rocksdb::Iterator> it (
+            db_->NewIterator (rocksdb::ReadOptions ()));
+
+        it->Seek (start);
+        if (! forward)
+        {
+            // Step back to the last key at or before the start
+            if (! it->Valid ())
+                it->SeekToLast ();
+            else if (it->key ().compare (start) > 0)
+                it->Prev ();
+        }
+
+        for (; it->Valid (); forward ? it->Next () : it->Prev ())
+        {
+            auto const key = it->key ();
+            if (key.size () != entryKeySize ||
+                    std::memcmp (key.data (), prefix.data (),
+                        accountKeySize) != 0)
+                break;
+
+            auto const seq = get32 (key.data () + accountKeySize);
+            if (forward ? (seq > endLedger) : (seq < endLedger))
+                break;
+
+            auto const value = it->value ();
+            if (value.size () != uint256::bytes)
+            {
+                JLOG (j_.error) << "Bad entry for ledger " << seq;
+                continue;
+            }
+
+            result.push_back ({seq, get32 (key.data () + accountKeySize + 4),
+                uint256::fromVoid (value.data ())});
+            if (result.size () >= limit)
+                break;
+        }
+
+        return result;
+    }
+
+private:
+    Ranges
+    getRanges () const
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        return ranges_;
+    }
+
+    void
+    setRanges (Ranges& ranges)
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        ranges_.swap (ranges);
+    }
+
+    void
+    write (rocksdb::WriteBatch& wb)
+    {
+        auto const status = db_->Write (rocksdb::WriteOptions (), &wb);
+        if (! status.ok ())
+            Throw<std::runtime_error> (
+                "account_tx_index write failed: " + status.ToString ());
+    }
+
+    // Remove the ledgers before seq from the ranges, recording the
+    // change in the batch
+    static
+    void
+    removeLedgers (Ranges& ranges, std::uint32_t seq, rocksdb::WriteBatch& wb)
+    {
+        while (! ranges.empty () && ranges.begin ()->first < seq)
+        {
+            auto const last = ranges.begin ()->second;
+            wb.Delete (rangeKey (ranges.begin ()->first));
+            ranges.erase (ranges.begin ());
+
+            if (last >= seq)
+            {
+                ranges[seq] = last;
+                wb.Put (rangeKey (seq), rangeValue (last));
+            }
+        }
+    }
+
+    // Add a ledger to the ranges, recording the change in the batch
+    static
+    void
+    addLedger (Ranges& ranges, std::uint32_t seq, rocksdb::WriteBatch& wb)
+    {
+        auto next = ranges.upper_bound (seq);
+        if (next != ranges.begin ())
+        {
+            auto const prev = std::prev (next);
+            if (prev->second >= seq)
+                return;
+        }
+
+        std::uint32_t first = seq;
+        std::uint32_t last = seq;
+
+        if (next != ranges.end () && next->first == seq + 1)
+        {
+            last = next->second;
+            wb.Delete (rangeKey (next->first));
+            next = ranges.erase (next);
+        }
+
+        if (next != ranges.begin ())
+        {
+            auto const prev = std::prev (next);
+            if (prev->second + 1 == seq)
+            {
+                first = prev->first;
+                ranges.erase (prev);
+            }
+        }
+
+        ranges[first] = last;
+        wb.Put (rangeKey (first), rangeValue (last));
+    }
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+
+std::unique_ptr<AccountTxIndex>
+make_AccountTxIndex (Section const& section, beast::Journal journal)
+{
+    if (! section.exists ("path"))
+        return nullptr;
+
+    std::string type = "RocksDB";
+    get_if_exists (section, "type", type);
+    if (! beast::ci_equal (type, std::string ("RocksDB")))
+        Throw<std::runtime_error> (
+            "Unknown account_tx_index type: " + type);
+
+#if RIPPLE_ROCKSDB_AVAILABLE
+    return std::make_unique<RocksDBAccountTxIndex> (section, journal);
+#else
+    Throw<std::runtime_error> ("RocksDB is not available");
+    return nullptr;
+#endif
+}
+
+} // ripple
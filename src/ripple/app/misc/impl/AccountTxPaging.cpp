@@ -23,9 +23,12 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/Transaction.h>
 #include <ripple/app/misc/impl/AccountTxPaging.h>
+#include <ripple/basics/UnorderedContainers.h>
 #include <ripple/protocol/Serializer.h>
 #include <ripple/protocol/types.h>
 #include <boost/format.hpp>
+#include <algorithm>
+#include <limits>
 #include <memory>
 
 namespace ripple {
@@ -62,6 +65,127 @@ saveLedgerAsync (Application& app, std::uint32_t seq)
         pendSaveValidated(app, ledger, false, false);
 }
 
+// Read the rows of transactions located by the account index.
+// Only primary key lookups are needed, whatever the marker.
+static
+void
+indexedTxPage (
+    DatabaseCon& connection,
+    std::vector<AccountTxIndex::Position> const& positions,
+    std::uint32_t numberOfResults,
+    Json::Value& token,
+    std::function<void (std::uint32_t)> const& onUnsavedLedger,
+    std::function<void (std::uint32_t,
+                        std::string const&,
+                        Blob const&,
+                        Blob const&)> const& onTransaction)
+{
+    auto const count = std::min<std::size_t> (
+        positions.size (), numberOfResults);
+
+    if (positions.size () > count)
+    {
+        token = Json::objectValue;
+        token[jss::ledger] = positions[count].ledgerSeq;
+        token[jss::seq] = positions[count].txnSeq;
+    }
+
+    if (count == 0)
+        return;
+
+    struct Row
+    {
+        std::string status;
+        Blob rawTxn;
+        Blob rawMeta;
+    };
+    hash_map<uint256, Row> rows;
+
+    {
+        std::string sql =
+            "SELECT TransID,Status,RawTxn,TxnMeta FROM Transactions "
+            "WHERE TransID IN (";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i != 0)
+                sql += ",";
+            sql += "'" + to_string (positions[i].id) + "'";
+        }
+        sql += ");";
+
+        bool isMySQL = connection.getType () == DatabaseCon::Type::MySQL;
+        auto db = connection.checkoutReadDb ();
+
+        std::string transID;
+        boost::optional<std::string> status;
+        boost::optional<std::string> txnDataStr;
+        boost::optional<std::string> txnMetaStr;
+        std::unique_ptr<soci::blob> txnData (isMySQL ? nullptr : new soci::blob (*db));
+        std::unique_ptr<soci::blob> txnMeta (isMySQL ? nullptr : new soci::blob (*db));
+        soci::indicator dataPresent, metaPresent;
+
+        soci::statement st = isMySQL ?
+                                 (db->prepare << sql,
+                                  soci::into (transID),
+                                  soci::into (status),
+                                  soci::into (txnDataStr, dataPresent),
+                                  soci::into (txnMetaStr, metaPresent)) :
+                                 (db->prepare << sql,
+                                  soci::into (transID),
+                                  soci::into (status),
+                                  soci::into (*txnData, dataPresent),
+                                  soci::into (*txnMeta, metaPresent));
+
+        st.execute ();
+
+        while (st.fetch ())
+        {
+            uint256 id;
+            if (! id.SetHexExact (transID.c_str ()))
+                continue;
+
+            auto& row = rows[id];
+            row.status = status.value_or ("");
+
+            if (dataPresent == soci::i_ok)
+            {
+                if (isMySQL)
+                    row.rawTxn.assign (txnDataStr->begin (), txnDataStr->end ());
+                else
+                    convert (*txnData, row.rawTxn);
+            }
+
+            if (metaPresent == soci::i_ok)
+            {
+                if (isMySQL)
+                    row.rawMeta.assign (txnMetaStr->begin (), txnMetaStr->end ());
+                else
+                    convert (*txnMeta, row.rawMeta);
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto const& position = positions[i];
+        auto const iter = rows.find (position.id);
+
+        // Like the join, skip transactions without a row
+        if (iter == rows.end ())
+        {
+            onUnsavedLedger (position.ledgerSeq);
+            continue;
+        }
+
+        // Work around a bug that could leave the metadata missing
+        if (iter->second.rawMeta.size () == 0)
+            onUnsavedLedger (position.ledgerSeq);
+
+        onTransaction (position.ledgerSeq, iter->second.status,
+            iter->second.rawTxn, iter->second.rawMeta);
+    }
+}
+
 void
 accountTxPage (
     DatabaseCon& connection,
@@ -78,7 +202,9 @@ accountTxPage (
     Json::Value& token,
     int limit,
     bool bAdmin,
-    std::uint32_t page_length)
+    std::uint32_t page_length,
+    AccountTxIndex const* index,
+    TxStore* store)
 {
     bool lookingForMarker =  !token.isNull() && token.isObject();
 
@@ -116,6 +242,55 @@ accountTxPage (
     // we need to clear it in between.
     token = Json::nullValue;
 
+    if ((store || index) && maxLedger >= 0 && minLedger <= maxLedger)
+    {
+        // The scan starts at the marker, which is part of the page
+        LedgerIndex const first = std::max (minLedger, 0);
+        LedgerIndex const last = maxLedger;
+        LedgerIndex startLedger = forward ? first : last;
+        std::uint32_t startSeq = forward ? 0 :
+            std::numeric_limits<std::uint32_t>::max ();
+        if (findLedger != 0)
+        {
+            startLedger = findLedger;
+            startSeq = findSeq;
+        }
+        LedgerIndex const endLedger = forward ? last : first;
+
+        // The external store holds validated ledgers only. It skips
+        // the index entries it can't serve, so the transaction past
+        // the page is always a real one to resume from.
+        if (store)
+        {
+            auto const txs = store->getAccountTxs (account,
+                startLedger, startSeq, endLedger, forward, queryLimit);
+            if (txs.size () > numberOfResults)
+            {
+                token = Json::objectValue;
+                token[jss::ledger] = txs[numberOfResults].ledgerSeq;
+                token[jss::seq] = txs[numberOfResults].txnSeq;
+            }
+            std::string const status (1, TXN_SQL_VALIDATED);
+            for (std::size_t i = 0;
+                i < std::min<std::size_t> (txs.size (), numberOfResults); ++i)
+            {
+                onTransaction (txs[i].ledgerSeq, status,
+                    txs[i].rawTxn, txs[i].rawMeta);
+            }
+            return;
+        }
+
+        if (index->covers (std::min (startLedger, endLedger),
+            std::max (startLedger, endLedger)))
+        {
+            auto const positions = index->getPositions (account,
+                startLedger, startSeq, endLedger, forward, queryLimit);
+            indexedTxPage (connection, positions, numberOfResults,
+                token, onUnsavedLedger, onTransaction);
+            return;
+        }
+    }
+
     static std::string const prefix (
         R"(SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,
           Status,RawTxn,TxnMeta
@@ -199,7 +374,7 @@ accountTxPage (
 
     {
         bool isMySQL = connection.getType () == DatabaseCon::Type::MySQL;
-        auto db =connection.checkoutDb();
+        auto db = connection.checkoutReadDb ();
 
         Blob rawData;
         Blob rawMeta;
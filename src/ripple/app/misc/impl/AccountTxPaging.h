@@ -21,7 +21,9 @@
 #define RIPPLE_APP_MISC_IMPL_ACCOUNTTXPAGING_H_INCLUDED
 
 #include <ripple/core/DatabaseCon.h>
+#include <ripple/app/misc/AccountTxIndex.h>
 #include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/app/misc/TxStore.h>
 #include <cstdint>
 #include <string>
 #include <utility>
@@ -59,7 +61,9 @@ accountTxPage (
     Json::Value& token,
     int limit,
     bool bAdmin,
-    std::uint32_t pageLength);
+    std::uint32_t pageLength,
+    AccountTxIndex const* index = nullptr,
+    TxStore* store = nullptr);
 
 }
 
@@ -119,10 +119,9 @@ Transaction::pointer Transaction::transactionFromSQLValidated(
 
 Transaction::pointer Transaction::load(uint256 const& id, Application& app)
 {
-    std::string sql = "SELECT LedgerSeq,Status,RawTxn "
-            "FROM Transactions WHERE TransID='";
-    sql.append (to_string (id));
-    sql.append ("';");
+    static std::string const sql = "SELECT LedgerSeq,Status,RawTxn "
+            "FROM Transactions WHERE TransID = :id;";
+    std::string const txnId (to_string (id));
 
     boost::optional<std::uint64_t> ledgerSeq;
     boost::optional<std::string> status;
@@ -130,17 +129,17 @@ Transaction::pointer Transaction::load(uint256 const& id, Application& app)
     {
         bool isMySQL = app.getTxnDB ().getType () == DatabaseCon::Type::MySQL;
         
-        auto db = app.getTxnDB ().checkoutDb ();
+        auto db = app.getTxnDB ().checkoutReadDb ();
         boost::optional<std::string> sociRawTxnStr;
         std::unique_ptr<soci::blob> sociRawTxnBlob (isMySQL ? nullptr : new soci::blob (*db));
         soci::indicator rti;
 
         if (isMySQL)
-            *db << sql, soci::into (ledgerSeq), soci::into (status),
-                soci::into (sociRawTxnStr, rti);
+            *db << sql, soci::use (txnId), soci::into (ledgerSeq),
+                soci::into (status), soci::into (sociRawTxnStr, rti);
         else
-            *db << sql, soci::into (ledgerSeq), soci::into (status),
-                soci::into (*sociRawTxnBlob, rti);
+            *db << sql, soci::use (txnId), soci::into (ledgerSeq),
+                soci::into (status), soci::into (*sociRawTxnBlob, rti);
 
         if (!db->got_data () || rti != soci::i_ok)
             return {};
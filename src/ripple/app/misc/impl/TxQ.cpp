@@ -21,10 +21,12 @@
 #include <ripple/app/ledger/OpenLedger.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/app/tx/PreclaimCache.h>
 #include <ripple/protocol/st.h>
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/JsonFields.h>
 #include <boost/algorithm/clamp.hpp>
+#include <algorithm>
 #include <limits>
 
 namespace ripple {
@@ -73,7 +75,8 @@ namespace detail {
 
 std::size_t
 FeeMetrics::updateFeeMetrics(Application& app,
-    ReadView const& view, bool timeLeap)
+    ReadView const& view, bool timeLeap,
+        hash_map<TxID, std::uint64_t> const& knownLevels)
 {
     std::vector<uint64_t> feeLevels;
     std::size_t txnsExpected;
@@ -88,12 +91,18 @@ FeeMetrics::updateFeeMetrics(Application& app,
     }
     for (auto const& tx : view.txs)
     {
+        auto const iter = knownLevels.find(
+            tx.first->getTransactionID());
+        if (iter != knownLevels.end())
+        {
+            feeLevels.push_back(iter->second);
+            continue;
+        }
         auto const baseFee = calculateBaseFee(app, view,
             *tx.first, j_);
         feeLevels.push_back(getFeeLevelPaid(*tx.first,
             baseLevel, baseFee));
     }
-    std::sort(feeLevels.begin(), feeLevels.end());
     auto const size = feeLevels.size();
 
     JLOG(j_.debug) << "Ledger " << view.info().seq <<
@@ -130,8 +139,12 @@ FeeMetrics::updateFeeMetrics(Application& app,
         // evaluates to the middle element; for an even
         // number of elements, it will add the two elements
         // on either side of the "middle" and average them.
-        escalationMultiplier = (feeLevels[size / 2] +
-            feeLevels[(size - 1) / 2] + 1) / 2;
+        // Only the middle is ordered, there is no need to sort.
+        auto const middle = feeLevels.begin() + size / 2;
+        std::nth_element(feeLevels.begin(), middle, feeLevels.end());
+        auto const lower = (size % 2) ? *middle :
+            *std::max_element(feeLevels.begin(), middle);
+        escalationMultiplier = (*middle + lower + 1) / 2;
         escalationMultiplier = std::max(escalationMultiplier,
             minimumMultiplier_);
     }
@@ -147,22 +160,17 @@ FeeMetrics::updateFeeMetrics(Application& app,
 }
 
 std::uint64_t
-FeeMetrics::scaleFeeLevel(OpenView const& view) const
+FeeMetrics::scaleFeeLevel(Snapshot const& snapshot,
+    OpenView const& view)
 {
     auto fee = baseLevel;
 
     // Transactions in the open ledger so far
     auto const current = view.txCount();
 
-    std::size_t target;
-    std::uint32_t multiplier;
-    {
-        std::lock_guard <std::mutex> sl(lock_);
-
-        // Target number of transactions allowed
-        target = txnsExpected_;
-        multiplier = escalationMultiplier_;
-    }
+    // Target number of transactions allowed
+    auto const target = snapshot.txnsExpected;
+    auto const multiplier = snapshot.escalationMultiplier;
 
     // Once the open ledger bypasses the target,
     // escalate the fee quickly.
@@ -248,6 +256,7 @@ TxQ::TxQ(Setup const& setup,
     , feeMetrics_(setup.standAlone, j)
     , maxSize_(boost::none)
 {
+    histogram_.fill(0);
 }
 
 TxQ::~TxQ()
@@ -281,10 +290,21 @@ TxQ::canBeHeld(std::shared_ptr<STTx const> const& tx)
     return canBeHeld;
 }
 
+std::size_t
+TxQ::feeBucket(std::uint64_t feeLevel)
+{
+    std::size_t bucket = 0;
+    for (auto multiple = feeLevel / detail::FeeMetrics::baseLevel;
+            multiple > 1 && bucket + 1 < feeBuckets; multiple >>= 1)
+        ++bucket;
+    return bucket;
+}
+
 auto
 TxQ::erase(TxQ::FeeMultiSet::const_iterator_type candidateIter)
     -> FeeMultiSet::iterator_type
 {
+    --histogram_[feeBucket(candidateIter->feeLevel)];
     auto& txQAccount = byAccount_.at(candidateIter->account);
     auto sequence = candidateIter->sequence;
     auto newCandidateIter = byFee_.erase(candidateIter);
@@ -301,7 +321,8 @@ TxQ::erase(TxQ::FeeMultiSet::const_iterator_type candidateIter)
 std::pair<TER, bool>
 TxQ::apply(Application& app, OpenView& view,
     std::shared_ptr<STTx const> const& tx,
-        ApplyFlags flags, beast::Journal j)
+        ApplyFlags flags, beast::Journal j,
+            PreclaimCache const* checked)
 {
     auto const allowEscalation =
         (flags & tapENABLE_TESTING) ||
@@ -312,6 +333,9 @@ TxQ::apply(Application& app, OpenView& view,
     
     if (!allowEscalation)
     {
+        if (auto const entry = checked ?
+                checked->find(*tx, flags, view) : nullptr)
+            return doApply(entry->preclaim(), app, view);
         return ripple::apply(app, view, *tx, flags, j);
     }
 
@@ -346,9 +370,26 @@ TxQ::apply(Application& app, OpenView& view,
     }
 
     // See if the transaction is likely to claim a fee.
-    auto const pfresult = preflight(app, view.rules(),
-        *tx, flags | (currentSeq ? tapNONE: tapPOST_SEQ), j);
-    auto const pcresult = preclaim(pfresult, app, view);
+    // Reuse the checks made ahead of time if nothing
+    // they depend on has changed since.
+    auto const checkFlags =
+        flags | (currentSeq ? tapNONE: tapPOST_SEQ);
+    boost::optional<PreflightResult const> pf;
+    boost::optional<PreclaimResult const> pc;
+    if (auto const entry = checked ?
+            checked->find(*tx, checkFlags, view) : nullptr)
+    {
+        pf.emplace(entry->preflight());
+        pc.emplace(entry->preclaim());
+    }
+    else
+    {
+        pf.emplace(preflight(app, view.rules(),
+            *tx, checkFlags, j));
+        pc.emplace(preclaim(*pf, app, view));
+    }
+    auto const& pfresult = *pf;
+    auto const& pcresult = *pc;
     if (!pcresult.likelyToClaimFee)
         return{ pcresult.ter, false };
 
@@ -434,6 +475,8 @@ TxQ::apply(Application& app, OpenView& view,
         bool didApply;
 
         std::tie(txnResult, didApply) = doApply(pcresult, app, view);
+        if (didApply)
+            appliedLevels_[transactionID] = { feeLevelPaid, view.seq() };
 
         JLOG(j_.trace) << "Transaction " <<
             transactionID <<
@@ -496,6 +539,7 @@ TxQ::apply(Application& app, OpenView& view,
     { tx, transactionID, feeLevelPaid, flags, pfresult });
     // Then index it into the byFee lookup.
     byFee_.insert(candidate);
+    ++histogram_[feeBucket(feeLevelPaid)];
     JLOG(j_.debug) << "Added transaction " << candidate.txID <<
         " from " << op << " account " << candidate.account <<
         " to queue.";
@@ -517,10 +561,28 @@ TxQ::processValidatedLedger(Application& app,
         return;
     }
 
-    feeMetrics_.updateFeeMetrics(app, view, timeLeap);
-
     auto ledgerSeq = view.info().seq;
 
+    // Pick up the levels computed as the transactions of this
+    // ledger were applied. Later ones belong to the open ledger.
+    hash_map<TxID, std::uint64_t> knownLevels;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto iter = appliedLevels_.begin();
+            iter != appliedLevels_.end();)
+        {
+            if (iter->second.seq > ledgerSeq)
+            {
+                ++iter;
+                continue;
+            }
+            knownLevels.emplace(iter->first, iter->second.feeLevel);
+            iter = appliedLevels_.erase(iter);
+        }
+    }
+
+    feeMetrics_.updateFeeMetrics(app, view, timeLeap, knownLevels);
+
     std::lock_guard<std::mutex> lock(mutex_);
 
     if (!timeLeap)
@@ -581,11 +643,15 @@ TxQ::accept(Application& app,
 
     auto ledgerChanged = false;
 
+    // The metrics only change when a ledger is validated
+    auto const metrics = feeMetrics_.getSnapshot();
+
     std::lock_guard<std::mutex> lock(mutex_);
 
     for (auto candidateIter = byFee_.begin(); candidateIter != byFee_.end();)
     {
-        auto const requiredFeeLevel = feeMetrics_.scaleFeeLevel(view);
+        auto const requiredFeeLevel =
+            detail::FeeMetrics::scaleFeeLevel(metrics, view);
         auto const feeLevelPaid = candidateIter->feeLevel;
         JLOG(j_.trace) << "Queued transaction " <<
             candidateIter->txID << " from account " <<
@@ -625,6 +691,9 @@ TxQ::accept(Application& app,
                     candidateIter->txID <<
                     " applied successfully. Remove from queue.";
 
+                appliedLevels_[candidateIter->txID] =
+                    { feeLevelPaid, view.seq() };
+
                 candidateIter = erase(candidateIter);
                 ledgerChanged = true;
             }
@@ -716,6 +785,50 @@ TxQ::doRPC(Application& app) const
     return ret;
 }
 
+Json::Value
+TxQ::doQueueRPC() const
+{
+    Json::Value ret(Json::objectValue);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    ret[jss::current_queue_size] =
+        static_cast<Json::UInt>(byFee_.size());
+    if (maxSize_)
+        ret[jss::max_queue_size] =
+            static_cast<Json::UInt>(*maxSize_);
+    ret[jss::queue_accounts] =
+        static_cast<Json::UInt>(byAccount_.size());
+
+    auto& levels = ret[jss::levels] = Json::objectValue;
+    levels[jss::reference_level] = std::to_string(
+        detail::FeeMetrics::baseLevel);
+    if (! byFee_.empty())
+    {
+        levels[jss::minimum_level] = std::to_string(
+            byFee_.rbegin()->feeLevel);
+        levels[jss::maximum_level] = std::to_string(
+            byFee_.begin()->feeLevel);
+    }
+
+    // Count of queued transactions paying at least each
+    // power of two multiple of the reference level
+    auto& histogram = ret[jss::histogram] = Json::arrayValue;
+    for (std::size_t i = 0; i < feeBuckets; ++i)
+    {
+        if (histogram_[i] == 0)
+            continue;
+        Json::Value bucket(Json::objectValue);
+        bucket[jss::fee_level] = std::to_string(
+            detail::FeeMetrics::baseLevel << i);
+        bucket[jss::count] =
+            static_cast<Json::UInt>(histogram_[i]);
+        histogram.append(std::move(bucket));
+    }
+
+    return ret;
+}
+
 XRPAmount
 TxQ::openLedgerFee(OpenView const& view) const
 {
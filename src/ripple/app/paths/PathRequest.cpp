@@ -29,6 +29,7 @@
 #include <ripple/core/LoadFeeTrack.h>
 #include <ripple/net/RPCErr.h>
 #include <ripple/protocol/ErrorCodes.h>
+#include <ripple/protocol/Serializer.h>
 #include <ripple/protocol/UintTypes.h>
 #include <beast/module/core/text/LexicalCast.h>
 #include <boost/optional.hpp>
@@ -489,7 +490,8 @@ PathRequest::getPathFinder(RippleLineCache::ref cache,
 
 void
 PathRequest::findPaths (RippleLineCache::ref cache, int const level,
-    Json::Value& jvArray)
+    Json::Value& jvArray,
+        hash_map<Currency, std::unique_ptr<Pathfinder>>& currency_map)
 {
     auto sourceCurrencies = sciSourceCurrencies;
     if (sourceCurrencies.empty ())
@@ -510,7 +512,6 @@ PathRequest::findPaths (RippleLineCache::ref cache, int const level,
     auto const dst_amount = convert_all_ ?
         STAmount(saDstAmount.issue(), STAmount::cMaxValue, STAmount::cMaxOffset)
             : saDstAmount;
-    hash_map<Currency, std::unique_ptr<Pathfinder>> currency_map;
     for (auto const& issue : sourceCurrencies)
     {
         if (issue.currency == assetCurrency())
@@ -622,7 +623,31 @@ PathRequest::findPaths (RippleLineCache::ref cache, int const level,
     }
 }
 
-Json::Value PathRequest::doUpdate (RippleLineCache::ref cache, bool fast)
+boost::optional<uint256> PathRequest::getSearchKey ()
+{
+    ScopedLockType sl (mLock);
+
+    if (! raSrcAccount || ! raDstAccount)
+        return boost::none;
+
+    Serializer s;
+    s.add160 (*raSrcAccount);
+    s.add160 (*raDstAccount);
+    saDstAmount.add (s);
+    s.add8 (convert_all_ ? 1 : 0);
+    s.add8 (saSendMax ? 1 : 0);
+    if (saSendMax)
+        saSendMax->add (s);
+    for (auto const& issue : sciSourceCurrencies)
+    {
+        s.add160 (issue.currency);
+        s.add160 (issue.account);
+    }
+    return s.getSHA512Half ();
+}
+
+Json::Value PathRequest::doUpdate (RippleLineCache::ref cache, bool fast,
+    PathfinderMap* shared)
 {
     m_journal.debug << iIdentifier << " update " << (fast ? "fast" : "normal");
 
@@ -686,7 +711,9 @@ Json::Value PathRequest::doUpdate (RippleLineCache::ref cache, bool fast)
     m_journal.debug << iIdentifier << " processing at level " << iLevel;
 
     Json::Value jvArray = Json::arrayValue;
-    findPaths(cache, iLevel, jvArray);
+    PathfinderMap pathfinders;
+    findPaths(cache, iLevel, jvArray,
+        (shared ? *shared : pathfinders)[iLevel]);
     bLastSuccess = jvArray.size();
     iLastLevel = iLevel;
 
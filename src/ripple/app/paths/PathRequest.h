@@ -86,8 +86,20 @@ public:
     Json::Value doClose (Json::Value const&);
     Json::Value doStatus (Json::Value const&);
 
+    /** Pathfinders built against one line cache, by search level and
+        source currency. Requests with the same search key can share them.
+    */
+    using PathfinderMap = std::map <int,
+        hash_map<Currency, std::unique_ptr<Pathfinder>>>;
+
+    /** Returns a digest of the search parameters.
+        Requests with equal keys look for the same paths.
+    */
+    boost::optional<uint256> getSearchKey ();
+
     // update jvStatus
-    Json::Value doUpdate (const std::shared_ptr<RippleLineCache>&, bool fast);
+    Json::Value doUpdate (const std::shared_ptr<RippleLineCache>&, bool fast,
+        PathfinderMap* shared = nullptr);
     InfoSub::pointer getSubscriber ();
     bool hasCompletion ();
 
@@ -104,7 +116,8 @@ private:
             STAmount const&, int const);
 
     void
-    findPaths (RippleLineCache::ref, int const, Json::Value&);
+    findPaths (RippleLineCache::ref, int const, Json::Value&,
+        hash_map<Currency, std::unique_ptr<Pathfinder>>&);
 
     int parseJson (Json::Value const&);
 
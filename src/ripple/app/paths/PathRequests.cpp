@@ -24,6 +24,8 @@
 #include <ripple/core/JobQueue.h>
 #include <ripple/protocol/JsonFields.h>
 #include <ripple/resource/Fees.h>
+#include <set>
+#include <vector>
 
 namespace ripple {
 
@@ -44,7 +46,12 @@ RippleLineCache::pointer PathRequests::getLineCache (
          (authoritative && ((lgrSeq + 8)  < lineSeq)) ||   // we jumped way back for some reason
          (lgrSeq > (lineSeq + 8)))                         // we jumped way forward for some reason
     {
-        mLineCache = std::make_shared<RippleLineCache> (ledger);
+        // Start from the lines we already know when we can
+        if (mLineCache)
+            mLineCache = std::make_shared<RippleLineCache> (
+                ledger, *mLineCache);
+        else
+            mLineCache = std::make_shared<RippleLineCache> (ledger);
     }
     return mLineCache;
 }
@@ -65,75 +72,115 @@ void PathRequests::updateAll (std::shared_ptr <ReadView const> const& inLedger,
     }
 
     bool newRequests = app_.getLedgerMaster().isNewPathRequest();
-    bool mustBreak = false;
+    std::atomic<bool> mustBreak (false);
 
     mJournal.trace << "updateAll seq=" << cache->getLedger()->seq() << ", " <<
         requests.size() << " requests";
-    int processed = 0, removed = 0;
+    std::atomic<int> processed (0);
+    int removed = 0;
+
+    struct Update
+    {
+        PathRequest::pointer request;
+        bool remove = true;
+    };
 
     do
     {
-        for (auto& wRequest : requests)
+        // Requests searching for the same paths are updated together,
+        // so their pathfinders are only built once
+        std::vector<std::vector<Update>> groups;
         {
-            if (shouldCancel())
-                break;
-
-            bool remove = true;
-            PathRequest::pointer pRequest = wRequest.lock ();
+            hash_map<uint256, std::size_t> byKey;
+            for (auto& wRequest : requests)
+            {
+                auto pRequest = wRequest.lock ();
+                if (! pRequest)
+                    continue;
+                auto const key = pRequest->getSearchKey ();
+                std::size_t index = groups.size ();
+                if (key)
+                    index = byKey.emplace (*key, index).first->second;
+                if (index == groups.size ())
+                    groups.emplace_back ();
+                groups[index].push_back ({std::move (pRequest)});
+            }
+        }
 
-            if (pRequest)
+        auto const seq = cache->getLedger()->seq();
+        mustBreak = false;
+        app_.getJobQueue().parallelFor (jtUPDATE_PF, "updatePaths",
+            groups.size(),
+            [&](std::size_t i)
             {
-                if (!pRequest->needsUpdate (newRequests, cache->getLedger()->seq()))
-                    remove = false;
-                else
+                PathRequest::PathfinderMap pathfinders;
+                for (auto& u : groups[i])
                 {
-                    InfoSub::pointer ipSub = pRequest->getSubscriber ();
-                    if (ipSub)
+                    if (mustBreak || shouldCancel())
+                    {
+                        u.remove = false;
+                        continue;
+                    }
+
+                    auto& pRequest = u.request;
+                    if (!pRequest->needsUpdate (newRequests, seq))
+                        u.remove = false;
+                    else
                     {
-                        ipSub->getConsumer ().charge (Resource::feePathFindUpdate);
-                        if (!ipSub->getConsumer ().warn ())
+                        InfoSub::pointer ipSub = pRequest->getSubscriber ();
+                        if (ipSub)
+                        {
+                            ipSub->getConsumer ().charge (Resource::feePathFindUpdate);
+                            if (!ipSub->getConsumer ().warn ())
+                            {
+                                Json::Value update = pRequest->doUpdate (
+                                    cache, false, &pathfinders);
+                                pRequest->updateComplete ();
+                                update[jss::type] = "path_find";
+                                ipSub->send (update, false);
+                                u.remove = false;
+                                ++processed;
+                            }
+                        }
+                        else if (pRequest->hasCompletion ())
                         {
-                            Json::Value update = pRequest->doUpdate (cache, false);
-                            pRequest->updateComplete ();
-                            update[jss::type] = "path_find";
-                            ipSub->send (update, false);
-                            remove = false;
+                            // One-shot request with completion function
+                            pRequest->doUpdate (cache, false, &pathfinders);
+                            pRequest->updateComplete();
                             ++processed;
                         }
                     }
-                    else if (pRequest->hasCompletion ())
-                    {
-                        // One-shot request with completion function
-                        pRequest->doUpdate (cache, false);
-                        pRequest->updateComplete();
-                        ++processed;
-                    }
+
+                    // We weren't handling new requests and then there was a new request
+                    if (!newRequests && !mustBreak &&
+                            app_.getLedgerMaster().isNewPathRequest())
+                        mustBreak = true;
                 }
-            }
+            });
 
-            if (remove)
-            {
-                ScopedLockType sl (mLock);
+        {
+            ScopedLockType sl (mLock);
 
-                // Remove any dangling weak pointers or weak pointers that refer to this path request.
-                std::vector<PathRequest::wptr>::iterator it = mRequests.begin();
-                while (it != mRequests.end())
+            // Remove any dangling weak pointers or weak pointers that refer
+            // to a path request we are done with.
+            std::set<PathRequest const*> done;
+            for (auto const& group : groups)
+                for (auto const& u : group)
+                    if (u.remove)
+                        done.insert (u.request.get());
+
+            std::vector<PathRequest::wptr>::iterator it = mRequests.begin();
+            while (it != mRequests.end())
+            {
+                PathRequest::pointer itRequest = it->lock ();
+                if (!itRequest || done.count (itRequest.get()))
                 {
-                    PathRequest::pointer itRequest = it->lock ();
-                    if (!itRequest || (itRequest == pRequest))
-                    {
-                        ++removed;
-                        it = mRequests.erase (it);
-                    }
-                    else
-                        ++it;
+                    ++removed;
+                    it = mRequests.erase (it);
                 }
+                else
+                    ++it;
             }
-
-            mustBreak = !newRequests && app_.getLedgerMaster().isNewPathRequest();
-            if (mustBreak) // We weren't handling new requests and then there was a new request
-                break;
-
         }
 
         if (mustBreak)
@@ -165,7 +212,7 @@ void PathRequests::updateAll (std::shared_ptr <ReadView const> const& inLedger,
     }
     while (!shouldCancel ());
 
-    mJournal.debug << "updateAll complete " << processed << " process and " <<
+    mJournal.debug << "updateAll complete " << processed.load() << " process and " <<
         removed << " removed";
 }
 
@@ -27,6 +27,7 @@
 #include <ripple/app/ledger/OrderBookDB.h>
 #include <ripple/basics/Log.h>
 #include <ripple/json/to_string.h>
+#include <ripple/protocol/Serializer.h>
 #include <ripple/core/JobQueue.h>
 #include <tuple>
 
@@ -359,6 +360,53 @@ TER Pathfinder::getPathLiquidity (
                                    //      deliver to be worth keeping.
     STAmount& amountOut,           // OUT: The actual liquidity along the path.
     uint64_t& qualityOut) const    // OUT: The returned initial quality
+{
+    // Requests ranking the same path for the same payment against the
+    // same ledger share the result through the line cache.
+    Serializer s;
+    s.add160 (mSrcAccount);
+    s.add160 (mDstAccount);
+    mSrcAmount.add (s);
+    mDstAmount.add (s);
+    minDstAmount.add (s);
+    s.add8 (convert_all_ ? 1 : 0);
+    for (auto const& element : path)
+    {
+        s.add8 (element.getNodeType ());
+        s.add160 (element.getAccountID ());
+        s.add160 (element.getCurrency ());
+        s.add160 (element.getIssuerID ());
+    }
+    auto const key = s.getSHA512Half ();
+
+    if (auto const cached = mRLCache->getPathLiquidity (key))
+    {
+        if (cached->result == tesSUCCESS)
+        {
+            amountOut = cached->amount;
+            qualityOut = cached->quality;
+        }
+        return cached->result;
+    }
+
+    RippleLineCache::PathLiquidity liquidity;
+    liquidity.result = computePathLiquidity (
+        path, minDstAmount, liquidity.amount, liquidity.quality);
+    mRLCache->setPathLiquidity (key, liquidity);
+
+    if (liquidity.result == tesSUCCESS)
+    {
+        amountOut = liquidity.amount;
+        qualityOut = liquidity.quality;
+    }
+    return liquidity.result;
+}
+
+TER Pathfinder::computePathLiquidity (
+    STPath const& path,
+    STAmount const& minDstAmount,
+    STAmount& amountOut,
+    uint64_t& qualityOut) const
 {
     STPathSet pathSet;
     pathSet.push_back (path);
@@ -121,7 +121,8 @@ private:
       computePathRanks:
           rippleCalculate
           getPathLiquidity:
-              rippleCalculate
+              computePathLiquidity:
+                  rippleCalculate
 
       getBestPaths
      */
@@ -158,6 +159,13 @@ private:
         STAmount& amountOut,           // OUT: The actual liquidity on the path.
         uint64_t& qualityOut) const;   // OUT: The returned initial quality
 
+    // Run the payment engine for getPathLiquidity, without the memo.
+    TER computePathLiquidity (
+        STPath const& path,
+        STAmount const& minDstAmount,
+        STAmount& amountOut,
+        uint64_t& qualityOut) const;
+
     // Does this path end on an account-to-account link whose last account has
     // set the "no ripple" flag on the link?
     bool isNoRippleOut (STPath const& currentPath);
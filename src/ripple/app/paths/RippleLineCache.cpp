@@ -20,9 +20,46 @@
 #include <BeastConfig.h>
 #include <ripple/app/paths/RippleLineCache.h>
 #include <ripple/ledger/OpenView.h>
+#include <ripple/protocol/Indexes.h>
 
 namespace ripple {
 
+// Collect the accounts on either side of every trust line created,
+// modified or deleted by the transactions in a closed ledger.
+// Returns false if the metadata does not identify them all.
+static
+bool
+getTouchedAccounts (ReadView const& ledger, hash_set<AccountID>& accounts)
+{
+    for (auto const& item : ledger.txs)
+    {
+        if (! item.second)
+            return false;
+
+        for (auto const& node : item.second->getFieldArray (sfAffectedNodes))
+        {
+            if (node.getFieldU16 (sfLedgerEntryType) != ltRIPPLE_STATE)
+                continue;
+
+            auto const& fields = (node.getFName () == sfCreatedNode) ?
+                sfNewFields : sfFinalFields;
+            std::shared_ptr<SLE const> sle;
+            if (! node.isFieldPresent (fields))
+            {
+                // The limits never change, so the current entry will do
+                sle = ledger.read (keylet::unchecked (
+                    node.getFieldH256 (sfLedgerIndex)));
+                if (! sle)
+                    return false;
+            }
+            STObject const& line = sle ? *sle : node.getFieldObject (fields);
+            accounts.insert (line.getFieldAmount (sfLowLimit).getIssuer ());
+            accounts.insert (line.getFieldAmount (sfHighLimit).getIssuer ());
+        }
+    }
+    return true;
+}
+
 RippleLineCache::RippleLineCache(
     std::shared_ptr <ReadView const> const& ledger)
 {
@@ -32,6 +69,31 @@ RippleLineCache::RippleLineCache(
     mLedger = std::make_shared<OpenView>(&*ledger, ledger);
 }
 
+RippleLineCache::RippleLineCache(
+    std::shared_ptr <ReadView const> const& ledger,
+    RippleLineCache& parent)
+    : hasher_ (parent.hasher_)
+{
+    mLedger = std::make_shared<OpenView>(&*ledger, ledger);
+
+    if (ledger->open () || parent.mLedger->open () ||
+        ledger->info ().parentHash != parent.mLedger->info ().hash)
+        return;
+
+    hash_set<AccountID> touched;
+    if (! getTouchedAccounts (*ledger, touched))
+        return;
+
+    // Keys are carried over as is, we share the parent's hasher
+    std::lock_guard <std::mutex> sl (parent.mLock);
+    mRLMap.reserve (parent.mRLMap.size ());
+    for (auto const& item : parent.mRLMap)
+    {
+        if (touched.count (item.first.account_) == 0)
+            mRLMap.emplace (item);
+    }
+}
+
 RippleLineCache::RippleStateVector const&
 RippleLineCache::getRippleLines (AccountID const& accountID)
 {
@@ -39,12 +101,31 @@ RippleLineCache::getRippleLines (AccountID const& accountID)
 
     std::lock_guard <std::mutex> sl (mLock);
 
-    auto it = mRLMap.emplace (key, RippleStateVector ());
+    auto it = mRLMap.emplace (key, nullptr);
 
     if (it.second)
-        it.first->second = ripple::getRippleStateItems (accountID, *mLedger);
+        it.first->second = std::make_shared<RippleStateVector const> (
+            ripple::getRippleStateItems (accountID, *mLedger));
+
+    return *it.first->second;
+}
 
-    return it.first->second;
+boost::optional<RippleLineCache::PathLiquidity>
+RippleLineCache::getPathLiquidity (uint256 const& key)
+{
+    std::lock_guard <std::mutex> sl (mLiquidityLock);
+    auto const it = mLiquidity.find (key);
+    if (it == mLiquidity.end ())
+        return boost::none;
+    return it->second;
+}
+
+void
+RippleLineCache::setPathLiquidity (
+    uint256 const& key, PathLiquidity const& liquidity)
+{
+    std::lock_guard <std::mutex> sl (mLiquidityLock);
+    mLiquidity.emplace (key, liquidity);
 }
 
 } // ripple
@@ -23,6 +23,10 @@
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/paths/RippleState.h>
 #include <ripple/basics/hardened_hash.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/TER.h>
+#include <boost/optional.hpp>
 #include <cstddef>
 #include <memory>
 #include <mutex>
@@ -40,15 +44,42 @@ public:
 
     explicit RippleLineCache (std::shared_ptr <ReadView const> const& l);
 
+    /** Create the cache for a closed ledger from the cache of its parent.
+
+        Accounts on either side of a trust line touched by the ledger's
+        transactions are dropped and reloaded on demand, the lines of
+        every other account are shared with the parent. If the parent
+        does not hold the closed predecessor of l the cache starts cold.
+    */
+    RippleLineCache (std::shared_ptr <ReadView const> const& l,
+        RippleLineCache& parent);
+
     std::shared_ptr <ReadView const> const&
     getLedger () // VFALCO TODO const?
     {
         return mLedger;
     }
 
-    std::vector<RippleState::pointer> const&
+    RippleStateVector const&
     getRippleLines (AccountID const& accountID);
 
+    /** The liquidity of one path, as ranked by a Pathfinder. */
+    struct PathLiquidity
+    {
+        TER result = tesSUCCESS;
+        STAmount amount;
+        std::uint64_t quality = 0;
+    };
+
+    /** Memo of path liquidity, shared by every Pathfinder using this
+        cache. The key must identify the path and the payment.
+    */
+    boost::optional<PathLiquidity>
+    getPathLiquidity (uint256 const& key);
+
+    void
+    setPathLiquidity (uint256 const& key, PathLiquidity const& liquidity);
+
 private:
     std::mutex mLock;
 
@@ -91,7 +122,13 @@ private:
         };
     };
 
-    hash_map <AccountKey, RippleStateVector, AccountKey::Hash> mRLMap;
+    // The lines of an account never change once loaded,
+    // so successive caches can share them.
+    hash_map <AccountKey, std::shared_ptr <RippleStateVector const>,
+        AccountKey::Hash> mRLMap;
+
+    std::mutex mLiquidityLock;
+    hash_map <uint256, PathLiquidity> mLiquidity;
 };
 
 } // ripple
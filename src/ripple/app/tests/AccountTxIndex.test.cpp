@@ -0,0 +1,273 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/app/misc/AccountTxIndex.h>
+#include <beast/module/core/diagnostic/UnitTestUtilities.h>
+#include <beast/unit_test/suite.h>
+#include <limits>
+
+namespace ripple {
+
+class AccountTxIndex_test : public beast::unit_test::suite
+{
+    using Position = AccountTxIndex::Position;
+
+    static
+    AccountID
+    account (std::uint64_t n)
+    {
+        return AccountID (n);
+    }
+
+    static
+    uint256
+    txID (LedgerIndex seq, std::uint32_t txnSeq)
+    {
+        return uint256 ((std::uint64_t (seq) << 32) | txnSeq);
+    }
+
+    static
+    void
+    insert (AccountTxIndex& index, LedgerIndex seq, std::uint32_t count)
+    {
+        std::vector<AccountTxIndex::Entry> entries;
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            // Every transaction affects both accounts
+            entries.push_back ({account (1), i, txID (seq, i)});
+            entries.push_back ({account (2), i, txID (seq, i)});
+        }
+        entries.push_back ({account (3), count, txID (seq, count)});
+        index.insert (seq, entries);
+    }
+
+    bool
+    expectPositions (std::vector<Position> const& positions,
+        std::vector<std::pair<LedgerIndex, std::uint32_t>> const& expected)
+    {
+        if (! expect (positions.size () == expected.size (),
+                "wrong number of positions"))
+            return false;
+        for (std::size_t i = 0; i < positions.size (); ++i)
+        {
+            auto const& p = positions[i];
+            if (! expect (p.ledgerSeq == expected[i].first &&
+                    p.txnSeq == expected[i].second &&
+                        p.id == txID (p.ledgerSeq, p.txnSeq)))
+                return false;
+        }
+        return true;
+    }
+
+    std::unique_ptr<AccountTxIndex>
+    open (std::string const& path)
+    {
+        Section section;
+        section.set ("path", path);
+        try
+        {
+            return make_AccountTxIndex (section, beast::Journal ());
+        }
+        catch (std::exception const& e)
+        {
+            fail (e.what ());
+        }
+        return nullptr;
+    }
+
+public:
+    void
+    testCoverage (std::string const& path)
+    {
+        testcase ("coverage");
+
+        {
+            auto index = open (path);
+            if (! index)
+                return;
+
+            expect (! index->covers (10, 10));
+            insert (*index, 10, 1);
+            insert (*index, 12, 1);
+            expect (index->covers (10, 10));
+            expect (index->covers (12, 12));
+            expect (! index->covers (10, 12));
+            expect (! index->covers (9, 10));
+
+            // Filling the gap joins the ranges
+            insert (*index, 11, 1);
+            expect (index->covers (10, 12));
+            expect (! index->covers (10, 13));
+
+            // Inserting a ledger again changes nothing
+            insert (*index, 11, 1);
+            expect (index->covers (10, 12));
+        }
+
+        // The ranges survive a restart
+        auto index = open (path);
+        if (! index)
+            return;
+        expect (index->covers (10, 12));
+        expect (! index->covers (13, 13));
+    }
+
+    void
+    testPositions (std::string const& path)
+    {
+        testcase ("positions");
+
+        auto index = open (path);
+        if (! index)
+            return;
+
+        insert (*index, 20, 2);
+        insert (*index, 21, 3);
+        insert (*index, 22, 2);
+
+        auto const all = std::numeric_limits<std::size_t>::max ();
+        auto const last = std::numeric_limits<std::uint32_t>::max ();
+
+        // Forward, from the start of a range
+        expectPositions (index->getPositions (
+            account (1), 20, 0, 22, true, all),
+            {{20, 0}, {20, 1}, {21, 0}, {21, 1}, {21, 2}, {22, 0}, {22, 1}});
+
+        // Forward from a marker, which is included
+        expectPositions (index->getPositions (
+            account (2), 21, 1, 22, true, 3),
+            {{21, 1}, {21, 2}, {22, 0}});
+
+        // Backward, bounded by the range
+        expectPositions (index->getPositions (
+            account (1), 21, last, 21, false, all),
+            {{21, 2}, {21, 1}, {21, 0}});
+
+        // Backward from a marker
+        expectPositions (index->getPositions (
+            account (2), 21, 1, 20, false, 3),
+            {{21, 1}, {21, 0}, {20, 1}});
+
+        // Backward from past the last key of the index
+        expectPositions (index->getPositions (
+            account (3), 30, last, 20, false, all),
+            {{22, 2}, {21, 3}, {20, 2}});
+
+        // Accounts don't see each other's transactions
+        expect (index->getPositions (
+            account (4), 20, 0, 22, true, all).empty ());
+        expect (index->getPositions (
+            account (0), 22, last, 20, false, all).empty ());
+    }
+
+    void
+    testReplace (std::string const& path)
+    {
+        testcase ("replace");
+
+        auto index = open (path);
+        if (! index)
+            return;
+
+        auto const all = std::numeric_limits<std::size_t>::max ();
+
+        insert (*index, 30, 3);
+        expectPositions (index->getPositions (
+            account (3), 30, 0, 30, true, all), {{30, 3}});
+
+        // Saving the ledger again drops what the first save listed
+        insert (*index, 30, 1);
+        expectPositions (index->getPositions (
+            account (1), 30, 0, 30, true, all), {{30, 0}});
+        expectPositions (index->getPositions (
+            account (3), 30, 0, 30, true, all), {{30, 1}});
+        expect (index->covers (30, 30));
+    }
+
+    void
+    testClearPrior (std::string const& path)
+    {
+        testcase ("clear prior");
+
+        auto const all = std::numeric_limits<std::size_t>::max ();
+        auto const last = std::numeric_limits<std::uint32_t>::max ();
+
+        {
+            auto index = open (path);
+            if (! index)
+                return;
+
+            for (LedgerIndex seq = 40; seq <= 45; ++seq)
+                insert (*index, seq, 1);
+            insert (*index, 50, 1);
+            insert (*index, 51, 1);
+
+            // Clearing inside a range keeps its tail
+            index->clearPrior (43);
+            expect (! index->covers (40, 45));
+            expect (! index->covers (42, 42));
+            expect (index->covers (43, 45));
+            expect (index->covers (50, 51));
+            expectPositions (index->getPositions (
+                account (1), 40, 0, 51, true, all),
+                {{43, 0}, {44, 0}, {45, 0}, {50, 0}, {51, 0}});
+
+            // Clearing past a range removes all of it
+            index->clearPrior (50);
+            expect (! index->covers (45, 45));
+            expect (index->covers (50, 51));
+            expectPositions (index->getPositions (
+                account (3), 51, last, 0, false, all),
+                {{51, 1}, {50, 1}});
+        }
+
+        // What was cleared stays cleared after a restart
+        auto index = open (path);
+        if (! index)
+            return;
+        expect (! index->covers (43, 43));
+        expect (index->covers (50, 51));
+    }
+
+    void
+    run ()
+    {
+        {
+            beast::UnitTestUtilities::TempDirectory path ("account_tx_index");
+            testCoverage (path.getFullPathName ().toStdString ());
+        }
+        {
+            beast::UnitTestUtilities::TempDirectory path ("account_tx_index");
+            testPositions (path.getFullPathName ().toStdString ());
+        }
+        {
+            beast::UnitTestUtilities::TempDirectory path ("account_tx_index");
+            testReplace (path.getFullPathName ().toStdString ());
+        }
+        {
+            beast::UnitTestUtilities::TempDirectory path ("account_tx_index");
+            testClearPrior (path.getFullPathName ().toStdString ());
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(AccountTxIndex,app,ripple);
+
+}
@@ -1,6 +1,9 @@
 #include <BeastConfig.h>
 #include <ripple/test/jtx.h>
+#include <ripple/protocol/Feature.h>
 #include <ripple/protocol/JsonFields.h>
+#include <algorithm>
+#include <limits>
 
 namespace ripple
 {
@@ -68,6 +71,45 @@ struct Asset_test : public beast::unit_test::suite
         expect (line->getFieldAmount (sfReserve) == ASSET (-reserve), "bad reserve");
     }
 
+    // The line's summary is the earliest release due on its asset states
+    void expectNextRelease (jtx::Env& env,
+                     jtx::Account const& account,
+                     jtx::Account const& gw,
+                     jtx::IOU ASSET)
+    {
+        auto line = env.le (
+            keylet::line (account.id (),
+                          gw.id (), ASSET.currency));
+        if (!line)
+            return;
+        uint256 assetStateIndex = getQualityIndex (
+            getAssetStateIndex (account.id (), gw.id (), ASSET.currency));
+        uint256 const assetStateEnd = getQualityNext (assetStateIndex);
+        auto nextRelease = std::numeric_limits<std::uint32_t>::max ();
+        while (auto const next = env.open ()->succ (assetStateIndex, assetStateEnd))
+        {
+            assetStateIndex = *next;
+            if (auto sle = env.le (keylet::asset_state (assetStateIndex)))
+                nextRelease = std::min (nextRelease,
+                    sle->getFieldU32 (sfNextReleaseTime));
+        }
+        expect (line->isFieldPresent (sfNextReleaseTime), "release summary missing");
+        expect (line->getFieldU32 (sfNextReleaseTime) == nextRelease, "bad release summary");
+    }
+
+    void expectNoNextRelease (jtx::Env& env,
+                     jtx::Account const& account,
+                     jtx::Account const& gw,
+                     jtx::IOU ASSET)
+    {
+        auto line = env.le (
+            keylet::line (account.id (),
+                          gw.id (), ASSET.currency));
+        if (!line)
+            return;
+        expect (!line->isFieldPresent (sfNextReleaseTime), "release summary without amendment");
+    }
+
     void testIssue ()
     {
         using namespace jtx;
@@ -151,7 +193,19 @@ struct Asset_test : public beast::unit_test::suite
         env (jv, ter (tefCREATED));
     }
 
-    void testRelease (uint64_t releaseRate1, uint64_t releaseRate2, uint64_t releaseRate3)
+    static
+    std::unique_ptr<Config const>
+    makeConfig (bool nextReleaseTime)
+    {
+        auto p = std::make_unique<Config>();
+        setupConfigForUnitTests (*p);
+        if (nextReleaseTime)
+            p->features.insert (featureNextReleaseTime);
+        return std::move (p);
+    }
+
+    void testRelease (uint64_t releaseRate1, uint64_t releaseRate2, uint64_t releaseRate3,
+                      bool withSummary = true, bool fromConfig = false)
     {
         releaseRate1 *= 10000000;
         releaseRate2 *= 10000000;
@@ -172,7 +226,11 @@ struct Asset_test : public beast::unit_test::suite
         };
         AssetState state[2];
 
-        Env env (*this);
+        // The amendment can also be enabled by the configuration
+        Env env (*this, makeConfig (fromConfig));
+        // Without the amendment every touch walks all the asset states
+        if (!withSummary || fromConfig)
+            env.disable_testing ();
 
         auto updateBalance = [&](auto& state, auto const& amount, auto const& releaseRate)
         {
@@ -186,6 +244,10 @@ struct Asset_test : public beast::unit_test::suite
         auto checkBalance = [&]()
         {
             expectBalanceAndReserve (env, Account ("bob"), gw, ASSET, balance, reserve);
+            if (withSummary)
+                expectNextRelease (env, Account ("bob"), gw, ASSET);
+            else
+                expectNoNextRelease (env, Account ("bob"), gw, ASSET);
         };
 
         auto checkAssetState = [&](auto assetStateNext, auto& state)
@@ -607,6 +669,8 @@ struct Asset_test : public beast::unit_test::suite
         testIssue ();
         testRelease (5, 10, 100);
         testRelease (0, 10, 95);
+        testRelease (5, 10, 100, false);
+        testRelease (5, 10, 100, true, true);
         testPayment ();
         testOffer ();
     }
@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/app/ledger/BookIndex.h>
+#include <ripple/test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+struct BookIndex_test : public beast::unit_test::suite
+{
+    void
+    testSnapshots()
+    {
+        testcase ("snapshots");
+        using namespace jtx;
+        Env env(*this);
+        auto const gw = Account("gateway");
+        auto const USD = gw["USD"];
+        auto const EUR = gw["EUR"];
+        env.fund(XRP(10000), "alice", "bob", gw);
+        env.trust(USD(1000), "alice");
+        env.trust(EUR(1000), "bob");
+        env(pay(gw, "alice", USD(100)));
+        env(pay(gw, "bob", EUR(100)));
+        env(offer("alice", XRP(20), USD(10)));
+        env(offer("alice", XRP(10), USD(10)));
+        env(offer("bob", XRP(10), EUR(10)));
+        env.close();
+
+        BookIndex index (env.journal);
+        Book const usdBook (xrpIssue(), USD.issue());
+        Book const eurBook (xrpIssue(), EUR.issue());
+
+        auto const first = index.get(env.closed());
+        expect(index.get(env.closed()) == first);
+
+        // A short walk is extended when more offers are asked for
+        expect(first->offers(usdBook, 1)->size() == 1);
+        auto const usd = first->offers(usdBook, 10);
+        expect(usd->size() == 2);
+        expect(first->offers(usdBook, 10) == usd);
+
+        // Best quality first
+        expect(usd->front().sle->getFieldAmount(sfTakerPays) ==
+            XRP(10).value());
+        expect(usd->front().json[jss::Account] ==
+            Account("alice").human());
+        expect(first->ownerFunds(Account("alice"), USD.issue()) ==
+            USD(100).value());
+
+        auto const eur = first->offers(eurBook, 10);
+        expect(eur->size() == 1);
+
+        // Only the book that was traded in is walked again
+        env(offer("bob", XRP(5), EUR(10)));
+        env.close();
+        auto const second = index.get(env.closed());
+        expect(second->offers(usdBook, 10) == usd);
+        auto const eur2 = second->offers(eurBook, 10);
+        expect(eur2 != eur);
+        expect(eur2->size() == 2);
+        expect(eur2->front().sle->getFieldAmount(sfTakerPays) ==
+            XRP(5).value());
+
+        // The open ledger is never remembered
+        expect(index.get(env.open()) != index.get(env.open()));
+    }
+
+    void run() override
+    {
+        testSnapshots();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(BookIndex,app,ripple);
+
+} // test
+} // ripple
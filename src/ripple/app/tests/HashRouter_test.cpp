@@ -212,6 +212,32 @@ class HashRouter_test : public beast::unit_test::suite
         expect(router.getFlags(key1) == (135 | 24));
     }
 
+    void
+    testSetFlagsGetPeers()
+    {
+        TestStopwatch stopwatch;
+        HashRouter router(stopwatch, std::chrono::seconds(2));
+
+        uint256 const key1(1);
+        int flags;
+
+        expect(router.addSuppressionPeer(key1, 1, flags));
+        expect(!router.addSuppressionPeer(key1, 2, flags));
+        expect(flags == 0);
+
+        // The peers seen before the flag are copied
+        std::set<HashRouter::PeerShortID> peers;
+        expect(router.setFlagsGetPeers(key1, 256, peers));
+        expect(peers == std::set<HashRouter::PeerShortID>({1, 2}));
+
+        // The ones seen after it find the flag set
+        expect(!router.addSuppressionPeer(key1, 3, flags));
+        expect(flags == 256);
+        peers.clear();
+        expect(!router.setFlagsGetPeers(key1, 256, peers));
+        expect(peers.empty());
+    }
+
 public:
 
     void
@@ -222,6 +248,7 @@ public:
         testSuppression();
         testSetFlags();
         testSwapSet();
+        testSetFlagsGetPeers();
     }
 };
 
@@ -0,0 +1,361 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/app/ledger/LedgerPersister.h>
+#include <ripple/app/ledger/PendingSaves.h>
+#include <ripple/app/main/DBInit.h>
+#include <ripple/core/DatabaseCon.h>
+#include <ripple/core/SociDB.h>
+#include <beast/unit_test/suite.h>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+namespace ripple {
+
+class LedgerPersister_test : public beast::unit_test::suite
+{
+    static
+    LedgerRows
+    makeRows (LedgerIndex seq)
+    {
+        LedgerRows rows;
+        rows.seq = seq;
+        rows.hash = uint256 (seq);
+        rows.parentHash = uint256 (seq - 1);
+        rows.accountHash = uint256 (7);
+        rows.txHash = uint256 (8);
+        rows.drops = "100000000000";
+        rows.dropsXRS = "50000000000";
+        rows.closeTime = 500 + seq;
+        rows.parentCloseTime = 490 + seq;
+        rows.closeTimeResolution = 10;
+        rows.closeFlags = 1;
+        rows.withTransactions = true;
+        auto const first = to_string (uint256 (2 * seq));
+        auto const second = to_string (uint256 (2 * seq + 1));
+        rows.transactions.push_back ({first, "Payment",
+            "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh", 3,
+                Blob {1, 2, 3}, Blob {4, 5}});
+        rows.transactions.push_back ({second, "OfferCreate",
+            "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh", 4, Blob {}, Blob {6}});
+        rows.accountTransactions.push_back ({first,
+            "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh", 0});
+        rows.accountTransactions.push_back ({second,
+            "rPEPPER7kfTD9w2To4CQk6UCfuHM9c6GDY", 1});
+        return rows;
+    }
+
+    void
+    expectEqual (LedgerRows const& a, LedgerRows const& b)
+    {
+        expect (a.seq == b.seq);
+        expect (a.hash == b.hash);
+        expect (a.parentHash == b.parentHash);
+        expect (a.accountHash == b.accountHash);
+        expect (a.txHash == b.txHash);
+        expect (a.drops == b.drops);
+        expect (a.dropsXRS == b.dropsXRS);
+        expect (a.closeTime == b.closeTime);
+        expect (a.parentCloseTime == b.parentCloseTime);
+        expect (a.closeTimeResolution == b.closeTimeResolution);
+        expect (a.closeFlags == b.closeFlags);
+        expect (a.withTransactions == b.withTransactions);
+        if (! expect (a.transactions.size () == b.transactions.size ()))
+            return;
+        for (std::size_t i = 0; i < a.transactions.size (); ++i)
+        {
+            auto const& x = a.transactions[i];
+            auto const& y = b.transactions[i];
+            expect (x.id == y.id && x.type == y.type &&
+                x.account == y.account && x.sequence == y.sequence &&
+                    x.raw == y.raw && x.meta == y.meta);
+        }
+        if (! expect (a.accountTransactions.size () ==
+                b.accountTransactions.size ()))
+            return;
+        for (std::size_t i = 0; i < a.accountTransactions.size (); ++i)
+        {
+            auto const& x = a.accountTransactions[i];
+            auto const& y = b.accountTransactions[i];
+            expect (x.id == y.id && x.account == y.account &&
+                x.txnSeq == y.txnSeq);
+        }
+    }
+
+public:
+    void
+    testSerialize ()
+    {
+        testcase ("serialize");
+
+        auto const rows = makeRows (10);
+        auto const record = serializeLedgerRows (rows);
+        auto const result = deserializeLedgerRows (makeSlice (record));
+        if (expect (result))
+            expectEqual (*result, rows);
+
+        // Truncated or padded records are rejected
+        expect (! deserializeLedgerRows (
+            Slice (record.data (), record.size () - 1)));
+        auto padded = record;
+        padded.push_back ('\0');
+        expect (! deserializeLedgerRows (makeSlice (padded)));
+        expect (! deserializeLedgerRows (Slice ()));
+    }
+
+    void
+    testLog ()
+    {
+        testcase ("log");
+
+        auto const first = serializeLedgerRows (makeRows (10));
+        auto const second = serializeLedgerRows (makeRows (11));
+
+        std::stringstream log;
+        auto const size = appendLedgerLog (log, first);
+        expect (size > first.size ());
+        appendLedgerLog (log, second);
+        auto const whole = log.str ();
+
+        {
+            std::istringstream in (whole);
+            auto const records = readLedgerLog (in);
+            expect (records.size () == 2);
+            expect (records.size () == 2 && records[0] == first &&
+                records[1] == second);
+        }
+
+        // A torn write at the tail is dropped
+        {
+            std::istringstream in (whole.substr (0, whole.size () - 3));
+            auto const records = readLedgerLog (in);
+            expect (records.size () == 1 && records[0] == first);
+        }
+
+        // So is a record whose contents don't match its checksum
+        {
+            auto corrupt = whole;
+            corrupt[size + 20] ^= 0x01;
+            std::istringstream in (corrupt);
+            auto const records = readLedgerLog (in);
+            expect (records.size () == 1 && records[0] == first);
+        }
+
+        // And one whose size is over the limit or past the end
+        for (std::uint32_t bad : {0xFFFFFFFFu, 0x00FF0000u})
+        {
+            auto corrupt = whole;
+            for (int i = 0; i < 4; ++i)
+                corrupt[size + i] = static_cast<char> (bad >> (24 - 8 * i));
+            std::istringstream in (corrupt);
+            auto const records = readLedgerLog (in);
+            expect (records.size () == 1 && records[0] == first);
+        }
+    }
+
+    static
+    long long
+    query (soci::session& db, std::string const& sql)
+    {
+        long long result = -1;
+        db << sql, soci::into (result);
+        return result;
+    }
+
+    void
+    testReplay ()
+    {
+        testcase ("replay");
+
+        // Ledger 11 was saved again with another hash and
+        // the append of ledger 13 was torn.
+        auto stale = makeRows (11);
+        stale.hash = uint256 (111);
+        stale.transactions.resize (1);
+        stale.transactions[0].id = to_string (uint256 (1111));
+        stale.accountTransactions.resize (1);
+        stale.accountTransactions[0].id = stale.transactions[0].id;
+
+        std::stringstream log;
+        appendLedgerLog (log, serializeLedgerRows (makeRows (10)));
+        appendLedgerLog (log, serializeLedgerRows (stale));
+        appendLedgerLog (log, serializeLedgerRows (makeRows (11)));
+        appendLedgerLog (log, serializeLedgerRows (makeRows (12)));
+        auto const torn = serializeLedgerRows (makeRows (13));
+        appendLedgerLog (log, torn);
+        auto whole = log.str ();
+        whole.resize (whole.size () - torn.size () / 2);
+
+        DatabaseCon::Setup setup;
+        setup.standAlone = true;
+        DatabaseCon ledgerDB (setup, "ledger.db",
+            LedgerDBInit, LedgerDBCount);
+        DatabaseCon txnDB (setup, "transaction.db",
+            TxnDBInit, TxnDBCount);
+
+        // The batch with the stale rows was committed, and the
+        // next one stopped after it cleared the Ledgers rows.
+        writeLedgerRows (ledgerDB, txnDB, {makeRows (10), stale});
+        ledgerDB.getSession () <<
+            "DELETE FROM Ledgers WHERE LedgerSeq >= 10;";
+
+        std::istringstream in (whole);
+        auto const entries = scanLedgerLog (in);
+        if (! expect (entries.size () == 3))
+            return;
+
+        std::vector<LedgerRows> batch;
+        for (auto const& entry : entries)
+        {
+            auto const record = readLedgerLogEntry (in, entry);
+            if (! expect (record))
+                return;
+            auto rows = deserializeLedgerRows (makeSlice (*record));
+            if (! expect (rows && rows->seq == entry.seq &&
+                    rows->hash == entry.hash))
+                return;
+            batch.push_back (std::move (*rows));
+        }
+        expectEqual (batch[0], makeRows (10));
+        expectEqual (batch[1], makeRows (11));
+        expectEqual (batch[2], makeRows (12));
+
+        writeLedgerRows (ledgerDB, txnDB, batch);
+
+        auto& ledgers = ledgerDB.getSession ();
+        expect (query (ledgers, "SELECT COUNT(*) FROM Ledgers;") == 3);
+        for (auto const& rows : batch)
+        {
+            std::string hash;
+            std::string prevHash;
+            long long seq = rows.seq;
+            ledgers << "SELECT LedgerHash, PrevHash FROM Ledgers "
+                "WHERE LedgerSeq = :seq;",
+                soci::use (seq), soci::into (hash), soci::into (prevHash);
+            expect (hash == to_string (rows.hash));
+            expect (prevHash == to_string (rows.parentHash));
+        }
+
+        auto& txns = txnDB.getSession ();
+        expect (query (txns, "SELECT COUNT(*) FROM Transactions;") == 6);
+        expect (query (txns,
+            "SELECT COUNT(*) FROM AccountTransactions;") == 6);
+        for (auto const& rows : batch)
+        {
+            for (auto const& tx : rows.transactions)
+            {
+                expect (query (txns, "SELECT LedgerSeq FROM Transactions "
+                    "WHERE TransID = '" + tx.id + "';") == rows.seq);
+                expect (query (txns, "SELECT LedgerSeq FROM "
+                    "AccountTransactions WHERE TransID = '" +
+                        tx.id + "';") == rows.seq);
+            }
+        }
+
+        // Nothing is left of the stale save
+        auto const staleId = stale.transactions[0].id;
+        expect (query (txns, "SELECT COUNT(*) FROM Transactions "
+            "WHERE TransID = '" + staleId + "';") == 0);
+        expect (query (txns, "SELECT COUNT(*) FROM AccountTransactions "
+            "WHERE TransID = '" + staleId + "';") == 0);
+    }
+
+    static
+    std::string
+    ledgerHash (soci::session& db, LedgerIndex seq)
+    {
+        std::string hash;
+        long long ledgerSeq = seq;
+        db << "SELECT LedgerHash FROM Ledgers WHERE LedgerSeq = :seq;",
+            soci::use (ledgerSeq), soci::into (hash);
+        return hash;
+    }
+
+    void
+    testResave ()
+    {
+        testcase ("resave");
+
+        DatabaseCon::Setup setup;
+        setup.standAlone = true;
+        DatabaseCon ledgerDB (setup, "ledger.db",
+            LedgerDBInit, LedgerDBCount);
+        DatabaseCon txnDB (setup, "transaction.db",
+            TxnDBInit, TxnDBCount);
+        auto& ledgers = ledgerDB.getSession ();
+        PendingSaves saves;
+
+        // The other save is scheduled but not dispatched: the
+        // resave takes it over and the other job is aborted.
+        expect (saves.shouldWork (11, false));
+        expect (! saves.shouldWork (11, false));
+        saves.claimWork (11);
+        expect (! saves.startWork (11));
+        writeLedgerRows (ledgerDB, txnDB, {makeRows (11)});
+        saves.finishWork (11);
+        expect (! saves.startWork (11));
+        expect (ledgerHash (ledgers, 11) == to_string (uint256 (11)));
+
+        // The other save is in progress: the resave waits for it
+        // and then replaces its rows.
+        auto stale = makeRows (12);
+        stale.hash = uint256 (112);
+        expect (saves.shouldWork (12, false));
+        expect (saves.startWork (12));
+
+        // A synchronous save doesn't wait for it without limit
+        expect (! saves.shouldWork (12, std::chrono::milliseconds (10)));
+        expect (! saves.await (12, std::chrono::milliseconds (10)));
+
+        std::atomic<bool> claimed {false};
+        std::thread resave ([&]
+            {
+                saves.claimWork (12);
+                claimed = true;
+                writeLedgerRows (ledgerDB, txnDB, {makeRows (12)});
+                saves.finishWork (12);
+            });
+        std::this_thread::sleep_for (std::chrono::milliseconds (50));
+        writeLedgerRows (ledgerDB, txnDB, {stale});
+        expect (! claimed.load ());
+        saves.finishWork (12);
+        resave.join ();
+        expect (claimed.load ());
+        expect (! saves.pending (12));
+        expect (saves.await (12, std::chrono::milliseconds (10)));
+        expect (saves.shouldWork (12, std::chrono::milliseconds (10)));
+        expect (ledgerHash (ledgers, 12) == to_string (uint256 (12)));
+    }
+
+    void
+    run ()
+    {
+        testSerialize ();
+        testLog ();
+        testReplay ();
+        testResave ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LedgerPersister,app,ripple);
+
+}
@@ -685,6 +685,44 @@ public:
             Account("bob")["USD"].issue())) == nullptr);
     }
 
+    void
+    line_cache_update()
+    {
+        testcase("line cache update");
+        using namespace jtx;
+        Env env(*this);
+        auto const gw = Account("gateway");
+        auto const USD = gw["USD"];
+        env.fund(XRP(10000), "alice", "bob", "carol", gw);
+        env.trust(USD(100), "alice", "carol");
+        env.close();
+
+        auto const first = std::make_shared<RippleLineCache>(env.closed());
+        auto const& aliceLines = first->getRippleLines(Account("alice"));
+        auto const& carolLines = first->getRippleLines(Account("carol"));
+        expect(aliceLines.size() == 1);
+        expect(first->getRippleLines(Account("bob")).empty());
+        expect(first->getRippleLines(gw).size() == 2);
+
+        env.trust(USD(100), "bob");
+        env(pay(gw, "carol", USD(50)));
+        env.close();
+
+        // Only the accounts whose lines changed are reloaded
+        auto const second = std::make_shared<RippleLineCache>(
+            env.closed(), *first);
+        expect(&second->getRippleLines(Account("alice")) == &aliceLines);
+        expect(&second->getRippleLines(Account("carol")) != &carolLines);
+        expect(second->getRippleLines(Account("bob")).size() == 1);
+        expect(second->getRippleLines(gw).size() == 3);
+
+        // A ledger that does not follow the parent starts cold
+        auto const third = std::make_shared<RippleLineCache>(
+            first->getLedger(), *second);
+        expect(&third->getRippleLines(Account("alice")) != &aliceLines);
+        expect(third->getRippleLines(gw).size() == 2);
+    }
+
     void
     run()
     {
@@ -705,6 +743,7 @@ public:
         quality_paths_quality_set_and_test();
         trust_auto_clear_trust_normal_clear();
         trust_auto_clear_trust_auto_clear();
+        line_cache_update();
     }
 };
 
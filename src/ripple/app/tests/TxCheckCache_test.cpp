@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/app/tx/TxCheckCache.h>
+#include <ripple/basics/chrono.h>
+#include <beast/unit_test/suite.h>
+
+namespace ripple {
+namespace test {
+
+class TxCheckCache_test : public beast::unit_test::suite
+{
+    void
+    testLookup()
+    {
+        testcase ("lookup");
+        TestStopwatch stopwatch;
+        TxCheckCache cache (stopwatch, std::chrono::seconds (2));
+        Rules const rules;
+
+        uint256 const key1 (1);
+        uint256 const key2 (2);
+
+        expect (! cache.find (key1, rules, tapNONE));
+        cache.insert (key1, rules, tapNONE, tesSUCCESS);
+        cache.insert (key2, rules, tapNONE, temBAD_FEE);
+        expect (cache.size () == 2);
+
+        auto ter = cache.find (key1, rules, tapNONE);
+        expect (ter && *ter == tesSUCCESS);
+        ter = cache.find (key2, rules, tapNONE);
+        expect (ter && *ter == temBAD_FEE);
+
+        // Flags preflight ignores do not matter
+        ter = cache.find (key1, rules, tapRETRY | tapNO_CHECK_SIGN);
+        expect (ter && *ter == tesSUCCESS);
+
+        // Flags preflight looks at do
+        expect (! cache.find (key1, rules, tapENABLE_TESTING));
+        cache.insert (key1, rules, tapENABLE_TESTING, temINVALID);
+        ter = cache.find (key1, rules, tapENABLE_TESTING);
+        expect (ter && *ter == temINVALID);
+        expect (! cache.find (key1, rules, tapNONE));
+    }
+
+    void
+    testExpiration()
+    {
+        testcase ("expiration");
+        TestStopwatch stopwatch;
+        TxCheckCache cache (stopwatch, std::chrono::seconds (2));
+        Rules const rules;
+
+        uint256 const key1 (1);
+        uint256 const key2 (2);
+        uint256 const key3 (3);
+
+        cache.insert (key1, rules, tapNONE, tesSUCCESS);
+        cache.insert (key2, rules, tapNONE, tesSUCCESS);
+        ++stopwatch;
+
+        // Lookups keep an entry alive
+        expect (static_cast<bool>(cache.find (key1, rules, tapNONE)));
+        ++stopwatch;
+
+        // Inserting expires stale entries
+        cache.insert (key3, rules, tapNONE, tesSUCCESS);
+        expect (static_cast<bool>(cache.find (key1, rules, tapNONE)));
+        expect (! cache.find (key2, rules, tapNONE));
+        expect (cache.size () == 2);
+    }
+
+public:
+    void
+    run()
+    {
+        testLookup();
+        testExpiration();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(TxCheckCache,app,ripple);
+
+}
+}
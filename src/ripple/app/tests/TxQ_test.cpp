@@ -154,6 +154,12 @@ public:
         submit(env,
             env.jt(noop(alice), queued));
         checkMetrics(env, 1, boost::none, 4, 3, 256, 500);
+        {
+            auto const q = txq.doQueueRPC();
+            expect(q[jss::current_queue_size].asUInt() == 1);
+            expect(q[jss::queue_accounts].asUInt() == 1);
+            expect(q[jss::histogram].size() == 1);
+        }
 
         // Alice - Alice is already in the queue, so can't hold.
         submit(env,
@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_TX_PRECLAIMCACHE_H_INCLUDED
+#define RIPPLE_TX_PRECLAIMCACHE_H_INCLUDED
+
+#include <ripple/app/tx/applySteps.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/ledger/OpenView.h>
+#include <ripple/protocol/STTx.h>
+#include <beast/utility/Journal.h>
+#include <boost/optional.hpp>
+#include <memory>
+#include <vector>
+
+namespace ripple {
+
+class Application;
+
+/** Preflight and preclaim results computed ahead of the serial apply.
+
+    A batch of transactions is checked against a read-only snapshot of
+    the open ledger, one transaction per call to check(), which may run
+    concurrently for distinct transactions. Each preclaim remembers the
+    ledger entries it looked at. When the transaction is later applied,
+    find() hands back the cached results as long as none of those
+    entries changed in the open ledger since the snapshot, so the
+    serial phase only has to run doApply.
+*/
+class PreclaimCache
+{
+public:
+    class Entry;
+
+    explicit
+    PreclaimCache (std::shared_ptr<OpenView const> snapshot);
+
+    ~PreclaimCache();
+
+    PreclaimCache (PreclaimCache const&) = delete;
+    PreclaimCache& operator= (PreclaimCache const&) = delete;
+
+    /** Add a transaction to be checked with the given flags.
+        Must not be called concurrently with anything else.
+    */
+    void
+    insert (std::shared_ptr<STTx const> const& tx,
+        ApplyFlags flags);
+
+    /** Returns the number of transactions inserted. */
+    std::size_t
+    size() const
+    {
+        return entries_.size();
+    }
+
+    /** Run preflight and preclaim for the i-th transaction. */
+    void
+    check (std::size_t i, Application& app,
+        beast::Journal j);
+
+    /** Returns the checks of tx if they still hold in view.
+
+        The flags must match those the transaction was checked
+        with, and view must descend from the snapshot.
+
+        @return nullptr if tx must be checked again.
+    */
+    Entry const*
+    find (STTx const& tx, ApplyFlags flags,
+        OpenView const& view) const;
+
+private:
+    std::shared_ptr<OpenView const> snapshot_;
+    std::vector<std::unique_ptr<Entry>> entries_;
+    hash_map<uint256, std::size_t> index_;
+};
+
+class PreclaimCache::Entry
+{
+public:
+    Entry (std::shared_ptr<STTx const> const& tx,
+        ApplyFlags flags);
+    ~Entry();
+
+    PreflightResult const&
+    preflight() const
+    {
+        return *pfresult_;
+    }
+
+    PreclaimResult const&
+    preclaim() const
+    {
+        return *pcresult_;
+    }
+
+private:
+    friend class PreclaimCache;
+    class Recorder;
+
+    std::shared_ptr<STTx const> tx_;
+    ApplyFlags flags_;
+    std::unique_ptr<Recorder> view_;
+    boost::optional<PreflightResult const> pfresult_;
+    boost::optional<PreclaimResult const> pcresult_;
+
+    // State keys read by preclaim
+    std::vector<uint256> keys_;
+
+    // false if preclaim did something we can't revalidate
+    bool complete_ = true;
+};
+
+} // ripple
+
+#endif
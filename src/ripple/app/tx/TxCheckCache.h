@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_TX_TXCHECKCACHE_H_INCLUDED
+#define RIPPLE_TX_TXCHECKCACHE_H_INCLUDED
+
+#include <ripple/ledger/ApplyView.h>
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/TER.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/chrono.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <beast/container/aged_unordered_map.h>
+#include <boost/optional.hpp>
+#include <chrono>
+#include <mutex>
+
+namespace ripple {
+
+/** Remembers the outcome of the context-free checks on transactions.
+
+    A transaction is preflighted every time it is applied: on arrival,
+    when the open ledger is rebuilt after a close, and again in each
+    consensus pass. The outcome depends only on the transaction, the
+    rules and a couple of apply flags, so it is recorded here, keyed by
+    transaction ID, and reused until it expires.
+
+    Signatures are not part of the record. Their validity is kept in the
+    HashRouter flags, and an outcome is only recorded or reused once the
+    HashRouter knows the signature is good (or the caller skips it).
+*/
+class TxCheckCache
+{
+public:
+    static
+    std::chrono::seconds
+    getDefaultHoldTime ()
+    {
+        return std::chrono::seconds (300);
+    }
+
+    TxCheckCache (Stopwatch& clock, std::chrono::seconds holdTime)
+        : map_ (clock)
+        , holdTime_ (holdTime)
+    {
+    }
+
+    TxCheckCache (TxCheckCache const&) = delete;
+    TxCheckCache& operator= (TxCheckCache const&) = delete;
+
+    /** Returns the recorded preflight outcome, if any. */
+    boost::optional<TER>
+    find (uint256 const& txID, Rules const& rules,
+        ApplyFlags flags);
+
+    /** Record the preflight outcome of a transaction. */
+    void
+    insert (uint256 const& txID, Rules const& rules,
+        ApplyFlags flags, TER ter);
+
+    std::size_t
+    size () const;
+
+private:
+    // The apply flags preflight looks at, besides tapNO_CHECK_SIGN
+    static
+    ApplyFlags
+    relevant (ApplyFlags flags)
+    {
+        return flags & tapENABLE_TESTING;
+    }
+
+    struct Entry
+    {
+        Rules rules;
+        ApplyFlags flags;
+        TER ter;
+    };
+
+    std::mutex mutable mutex_;
+    beast::aged_unordered_map<uint256, Entry, Stopwatch::clock_type,
+        hardened_hash<strong_hash>> map_;
+    std::chrono::seconds const holdTime_;
+};
+
+} // ripple
+
+#endif
@@ -70,6 +70,13 @@ checkValidity(HashRouter& router,
             ApplyFlags const& flags = tapNONE);
 
 
+/** Returns `true` if the signature is known to be good.
+
+    Only consults the cache, the signature is never checked.
+*/
+bool
+isSignatureKnownGood(HashRouter& router, uint256 const& txid);
+
 /** Sets the validity of a given transaction in the cache.
     Use with extreme care.
 
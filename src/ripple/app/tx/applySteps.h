@@ -124,7 +124,7 @@ preflight(Application& app, Rules const& rules,
 */
 PreclaimResult
 preclaim(PreflightResult const& preflightResult,
-    Application& app, OpenView const& view);
+    Application& app, ReadView const& view);
 
 /** Compute only the expected base fee for a transaction.
 
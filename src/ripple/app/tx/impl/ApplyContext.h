@@ -23,6 +23,7 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/ledger/ApplyViewImpl.h>
 #include <ripple/core/Config.h>
+#include <ripple/protocol/STArena.h>
 #include <ripple/protocol/STTx.h>
 #include <ripple/protocol/XRPAmount.h>
 #include <beast/utility/Journal.h>
@@ -114,6 +115,8 @@ public:
     }
 
 private:
+    // Serialized objects built while applying come from the arena
+    STArena::Scope arena_;
     OpenView& base_;
     ApplyFlags flags_;
     boost::optional<ApplyViewImpl> view_;
@@ -0,0 +1,208 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/app/tx/PreclaimCache.h>
+
+namespace ripple {
+
+// Forwards to the snapshot, remembering the state keys looked at
+class PreclaimCache::Entry::Recorder
+    : public ReadView
+{
+private:
+    ReadView const& base_;
+    std::vector<uint256>& keys_;
+    bool& complete_;
+
+public:
+    Recorder (ReadView const& base,
+        std::vector<uint256>& keys, bool& complete)
+        : base_ (base)
+        , keys_ (keys)
+        , complete_ (complete)
+    {
+    }
+
+    LedgerInfo const&
+    info() const override
+    {
+        return base_.info();
+    }
+
+    Fees const&
+    fees() const override
+    {
+        return base_.fees();
+    }
+
+    Rules const&
+    rules() const override
+    {
+        return base_.rules();
+    }
+
+    bool
+    exists (Keylet const& k) const override
+    {
+        keys_.push_back(k.key);
+        return base_.exists(k);
+    }
+
+    boost::optional<key_type>
+    succ (key_type const& key, boost::optional<
+        key_type> const& last = boost::none) const override
+    {
+        complete_ = false;
+        return base_.succ(key, last);
+    }
+
+    std::shared_ptr<SLE const>
+    read (Keylet const& k) const override
+    {
+        keys_.push_back(k.key);
+        return base_.read(k);
+    }
+
+    STAmount
+    balanceHook (AccountID const& account,
+        AccountID const& issuer,
+            STAmount const& amount) const override
+    {
+        return base_.balanceHook(account, issuer, amount);
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesBegin() const override
+    {
+        complete_ = false;
+        return base_.slesBegin();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesEnd() const override
+    {
+        complete_ = false;
+        return base_.slesEnd();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesUpperBound (key_type const& key) const override
+    {
+        complete_ = false;
+        return base_.slesUpperBound(key);
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsBegin() const override
+    {
+        complete_ = false;
+        return base_.txsBegin();
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsEnd() const override
+    {
+        complete_ = false;
+        return base_.txsEnd();
+    }
+
+    bool
+    txExists (key_type const& key) const override
+    {
+        complete_ = false;
+        return base_.txExists(key);
+    }
+
+    tx_type
+    txRead (key_type const& key) const override
+    {
+        complete_ = false;
+        return base_.txRead(key);
+    }
+};
+
+PreclaimCache::Entry::Entry (
+        std::shared_ptr<STTx const> const& tx,
+            ApplyFlags flags)
+    : tx_ (tx)
+    , flags_ (flags)
+{
+}
+
+PreclaimCache::Entry::~Entry() = default;
+
+//------------------------------------------------------------------------------
+
+PreclaimCache::PreclaimCache (
+        std::shared_ptr<OpenView const> snapshot)
+    : snapshot_ (std::move(snapshot))
+{
+}
+
+PreclaimCache::~PreclaimCache() = default;
+
+void
+PreclaimCache::insert (std::shared_ptr<STTx const> const& tx,
+    ApplyFlags flags)
+{
+    auto const result = index_.emplace(
+        tx->getTransactionID(), entries_.size());
+    if (! result.second)
+        return;
+    entries_.emplace_back(
+        std::make_unique<Entry>(tx, flags));
+}
+
+void
+PreclaimCache::check (std::size_t i,
+    Application& app, beast::Journal j)
+{
+    auto& e = *entries_[i];
+    e.view_ = std::make_unique<Entry::Recorder>(
+        *snapshot_, e.keys_, e.complete_);
+    e.pfresult_.emplace(ripple::preflight(app,
+        snapshot_->rules(), *e.tx_, e.flags_, j));
+    e.pcresult_.emplace(ripple::preclaim(
+        *e.pfresult_, app, *e.view_));
+}
+
+PreclaimCache::Entry const*
+PreclaimCache::find (STTx const& tx, ApplyFlags flags,
+    OpenView const& view) const
+{
+    auto const iter = index_.find(tx.getTransactionID());
+    if (iter == index_.end())
+        return nullptr;
+    auto const& e = *entries_[iter->second];
+    if (e.tx_.get() != &tx || e.flags_ != flags ||
+            ! e.pcresult_ || ! e.complete_)
+        return nullptr;
+    if (view.seq() != snapshot_->seq() ||
+            view.rules() != snapshot_->rules())
+        return nullptr;
+    // Cheap revalidation: preclaim would see exactly
+    // what it saw before if none of its entries changed.
+    for (auto const& key : e.keys_)
+        if (! view.unchangedSince(*snapshot_, key))
+            return nullptr;
+    return &e;
+}
+
+} // ripple
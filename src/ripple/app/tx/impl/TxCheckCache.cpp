@@ -0,0 +1,65 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/app/tx/TxCheckCache.h>
+
+namespace ripple {
+
+boost::optional<TER>
+TxCheckCache::find (uint256 const& txID,
+    Rules const& rules, ApplyFlags flags)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto const iter = map_.find (txID);
+    if (iter == map_.end ())
+        return boost::none;
+    auto const& e = iter->second;
+    if (e.flags != relevant (flags) || e.rules != rules)
+        return boost::none;
+    map_.touch (iter);
+    return e.ter;
+}
+
+void
+TxCheckCache::insert (uint256 const& txID,
+    Rules const& rules, ApplyFlags flags, TER ter)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto iter = map_.find (txID);
+    if (iter != map_.end ())
+    {
+        // The rules changed or the flags differ;
+        // keep the latest outcome.
+        iter->second = Entry{ rules, relevant (flags), ter };
+        map_.touch (iter);
+        return;
+    }
+    expire (map_, holdTime_);
+    map_.emplace (txID, Entry{ rules, relevant (flags), ter });
+}
+
+std::size_t
+TxCheckCache::size () const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    return map_.size ();
+}
+
+} // ripple
@@ -90,6 +90,12 @@ checkValidity(HashRouter& router,
     return checkValidity(router, tx, allowMultiSign);
 }
 
+bool
+isSignatureKnownGood(HashRouter& router, uint256 const& txid)
+{
+    return (router.getFlags(txid) & SF_SIGGOOD) != 0;
+}
+
 void
 forceValidity(HashRouter& router, uint256 const& txid,
     Validity validity)
@@ -19,6 +19,10 @@
 
 #include <BeastConfig.h>
 #include <ripple/app/tx/applySteps.h>
+#include <ripple/app/tx/apply.h>
+#include <ripple/app/tx/TxCheckCache.h>
+#include <ripple/app/main/Application.h>
+#include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/tx/impl/ApplyContext.h>
 #include <ripple/app/tx/impl/CancelOffer.h>
 #include <ripple/app/tx/impl/CancelTicket.h>
@@ -203,6 +207,30 @@ invoke_apply (ApplyContext& ctx)
     }
 }
 
+// Preflight, reusing the outcome of an earlier run if there was one.
+// Once the signature is known good the outcome no longer depends on
+// it, so it is only recorded or reused from that point on.
+static
+TER
+cached_preflight(PreflightContext const& ctx)
+{
+    auto& cache = ctx.app.getTxCheckCache();
+    auto& router = ctx.app.getHashRouter();
+    auto const id = ctx.tx.getTransactionID();
+    bool const skipSign = (ctx.flags & tapNO_CHECK_SIGN) != 0;
+
+    if (skipSign || isSignatureKnownGood(router, id))
+    {
+        if (auto const ter = cache.find(id, ctx.rules, ctx.flags))
+            return *ter;
+    }
+
+    auto const ter = invoke_preflight(ctx);
+    if (skipSign || isSignatureKnownGood(router, id))
+        cache.insert(id, ctx.rules, ctx.flags, ter);
+    return ter;
+}
+
 PreflightResult
 preflight(Application& app, Rules const& rules,
     STTx const& tx, ApplyFlags flags,
@@ -212,7 +240,7 @@ preflight(Application& app, Rules const& rules,
         rules, flags, j);
     try
     {
-        return{ pfctx, invoke_preflight(pfctx) };
+        return{ pfctx, cached_preflight(pfctx) };
     }
     catch (std::exception const& e)
     {
@@ -224,7 +252,7 @@ preflight(Application& app, Rules const& rules,
 
 PreclaimResult
 preclaim (PreflightResult const& preflightResult,
-    Application& app, OpenView const& view)
+    Application& app, ReadView const& view)
 {
     boost::optional<PreclaimContext const> ctx;
     if (preflightResult.rules != view.rules())
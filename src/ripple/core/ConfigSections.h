@@ -32,6 +32,7 @@ struct ConfigSection
 };
 
 // VFALCO TODO Rename and replace these macros with variables.
+#define SECTION_ACCOUNT_TX_INDEX        "account_tx_index"
 #define SECTION_AMENDMENTS              "amendments"
 #define SECTION_CLUSTER_NODES           "cluster_nodes"
 #define SECTION_CONSENSUS               "consensus"
@@ -56,6 +57,7 @@ struct ConfigSection
 #define SECTION_PEER_PRIVATE            "peer_private"
 #define SECTION_PEERS_MAX               "peers_max"
 #define SECTION_QUANTUM                 "quantum"
+#define SECTION_RPC_CACHE               "rpc_cache"
 #define SECTION_RPC_STARTUP             "rpc_startup"
 #define SECTION_SNTP                    "sntp_servers"
 #define SECTION_SSL_VERIFY              "ssl_verify"
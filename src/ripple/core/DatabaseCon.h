@@ -23,8 +23,11 @@
 #include <ripple/core/Config.h>
 #include <ripple/core/SociDB.h>
 #include <boost/filesystem/path.hpp>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 
 namespace soci {
@@ -46,6 +49,10 @@ public:
     LockedPointer (T* it, mutex& m) : it_ (it), lock_ (m)
     {
     }
+    LockedPointer (T* it, std::unique_lock<mutex>&& lock)
+        : it_ (it), lock_ (std::move (lock))
+    {
+    }
     LockedPointer (LockedPointer&& rhs) noexcept
         : it_ (rhs.it_), lock_ (std::move (rhs.lock_))
     {
@@ -96,11 +103,19 @@ public:
                  int countInit)
         : DatabaseCon (setup, Type::Sqlite, name, initString, countInit) {}
 
+    /** Open a database.
+
+        When readers is not zero, that many extra sessions are opened for
+        checkoutReadDb, so queries don't wait behind writes on the main
+        session. Temporary SQLite databases can't be shared between
+        sessions and never get readers.
+    */
     DatabaseCon (Setup const& setup,
                  Type const& type,
                  std::string const& name,
                  const char* initString[],
-                 int countInit);
+                 int countInit,
+                 std::size_t readers = 0);
 
     soci::session& getSession()
     {
@@ -112,6 +127,15 @@ public:
         return LockedSociSession (&session_, lock_);
     }
 
+    /** Returns a session for queries which only read.
+        This is an idle session of the read pool, if there is one.
+        Without readers it is the same as checkoutDb.
+    */
+    LockedSociSession checkoutReadDb ();
+
+    /** Reconnect the main session and every reader. */
+    void reconnect ();
+
     void setupCheckpointing (JobQueue*, Logs&);
 
     Type getType () { return type_; }
@@ -143,6 +167,15 @@ private:
 
     soci::session session_;
     std::unique_ptr<Checkpointer> checkpointer_;
+
+    struct Reader
+    {
+        soci::session session;
+        LockedSociSession::mutex lock;
+    };
+
+    std::vector<std::unique_ptr<Reader>> readers_;
+    std::atomic<std::size_t> nextReader_ {0};
     
     Type type_;
 };
@@ -44,9 +44,11 @@ enum JobType
     jtPROPOSAL_ut,   // A proposal from an untrusted source
     jtLEDGER_DATA,   // Received data for a ledger we're acquiring
     jtCLIENT,        // A websocket command from the client
+    jtCLIENT_DB,     // Database work for a client command
     jtRPC,           // A websocket command from the client
     jtUPDATE_PF,     // Update pathfinding requests
     jtTRANSACTION,   // A transaction received from the network
+    jtPUBTXN,        // Publish and relay applied transactions
     jtBATCH,         // Apply batched transactions
     jtUNL,           // A Score or Fetch of the UNL (DEPRECATED)
     jtADVANCE,       // Advance validated/acquired ledgers
@@ -46,7 +46,12 @@ public:
         Stoppable& parent, beast::Journal journal, Logs& logs);
     ~JobQueue ();
 
-    void addJob (JobType type, std::string const& name, JobFunction const& func);
+    /** Adds a job to the queue.
+
+        @return `false` if the queue is stopping and skips this job type,
+                in which case func will never be called.
+    */
+    bool addJob (JobType type, std::string const& name, JobFunction const& func);
 
     /** Creates a coroutine and adds a job to the queue which will run it.
 
@@ -57,6 +62,16 @@ public:
     template <class F>
     void postCoro (JobType t, std::string const& name, F&& f);
 
+    /** Calls f for every index in [0, count) and waits for all of them.
+
+        Helper jobs of the given type are added to share the work, and the
+        calling thread takes part as well, so the call completes even when
+        no job thread is free or the queue is stopping. f is called
+        concurrently and must not throw.
+    */
+    void parallelFor (JobType type, std::string const& name,
+        std::size_t count, std::function <void(std::size_t)> const& f);
+
     /** Jobs waiting at this priority.
     */
     int getJobCount (JobType t) const;
@@ -70,6 +70,13 @@ public:
         add (jtCLIENT,        "clientCommand",
             maxLimit, true,   false, 2000,  5000);
 
+        // Database work for a client command, run while the command's
+        // coroutine is suspended. Limited to the default number of
+        // transaction database read sessions, so slow queries queue up
+        // here rather than tie up worker threads waiting for a session.
+        add (jtCLIENT_DB,     "clientDatabase",
+            4,        false,  false, 0,     0);
+
         // A websocket command from the client
         add (jtRPC,           "RPC",
             maxLimit, false,  false, 0,     0);
@@ -82,6 +89,10 @@ public:
         add (jtTRANSACTION,   "transaction",
             maxLimit, true,   false, 250,   1000);
 
+        // Publish and relay applied transactions
+        add (jtPUBTXN,        "publishTransactions",
+            1,        true,   false, 250,   1000);
+
         // Apply batched transactions
         add (jtBATCH,          "batch",
             maxLimit, true,   false, 250,   1000);
@@ -22,6 +22,7 @@
 #include <ripple/core/SociDB.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/Log.h>
+#include <boost/algorithm/string/predicate.hpp>
 #include <memory>
 
 namespace ripple {
@@ -31,7 +32,8 @@ DatabaseCon::DatabaseCon (
     Type const& type,
     std::string const& strName,
     const char* initStrings[],
-    int initCount)
+    int initCount,
+    std::size_t readers)
     : type_ (type)
 {
     auto const useTempFiles  // Use temporary files or regular DB files?
@@ -57,6 +59,69 @@ DatabaseCon::DatabaseCon (
             // ignore errors
         }
     }
+
+    if (useTempFiles || type == Type::None)
+        return;
+
+    readers_.reserve (readers);
+    for (std::size_t i = 0; i < readers; ++i)
+    {
+        auto reader = std::make_unique<Reader> ();
+        open (reader->session, strType, pPath.string());
+
+        // The schema is in place, only per-connection settings are needed
+        for (int j = 0; j < initCount; ++j)
+        {
+            if (! boost::starts_with (initStrings[j], "PRAGMA"))
+                continue;
+            try
+            {
+                reader->session << initStrings[j];
+            }
+            catch (soci::soci_error&)
+            {
+                // ignore errors
+            }
+        }
+        readers_.push_back (std::move (reader));
+    }
+}
+
+LockedSociSession
+DatabaseCon::checkoutReadDb ()
+{
+    if (readers_.empty ())
+        return checkoutDb ();
+
+    // Take the first idle reader after the one handed out last,
+    // or wait for that one if they are all busy.
+    auto const start = nextReader_++;
+    for (std::size_t i = 0; i < readers_.size (); ++i)
+    {
+        auto& reader = *readers_[(start + i) % readers_.size ()];
+        std::unique_lock<LockedSociSession::mutex> lock (
+            reader.lock, std::try_to_lock);
+        if (lock.owns_lock ())
+            return LockedSociSession (&reader.session, std::move (lock));
+    }
+
+    auto& reader = *readers_[start % readers_.size ()];
+    return LockedSociSession (&reader.session, reader.lock);
+}
+
+void
+DatabaseCon::reconnect ()
+{
+    {
+        std::lock_guard<LockedSociSession::mutex> lock (lock_);
+        session_.reconnect ();
+    }
+
+    for (auto& reader : readers_)
+    {
+        std::lock_guard<LockedSociSession::mutex> lock (reader->lock);
+        reader->session.reconnect ();
+    }
 }
 
 DatabaseCon::Setup setup_DatabaseCon (Config const& c)
@@ -24,7 +24,10 @@
 #include <ripple/core/JobTypeData.h>
 #include <beast/chrono/chrono_util.h>
 #include <beast/module/core/thread/Workers.h>
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -76,7 +79,7 @@ JobQueue::collect ()
     job_count = m_jobSet.size ();
 }
 
-void
+bool
 JobQueue::addJob (JobType type, std::string const& name,
     JobFunction const& func)
 {
@@ -85,7 +88,7 @@ JobQueue::addJob (JobType type, std::string const& name,
     auto iter (m_jobData.find (type));
     assert (iter != m_jobData.end ());
     if (iter == m_jobData.end ())
-        return;
+        return false;
 
     JobTypeData& data (iter->second);
 
@@ -119,7 +122,7 @@ JobQueue::addJob (JobType type, std::string const& name,
     {
         m_journal.debug <<
             "Skipping addJob ('" << name << "')";
-        return;
+        return false;
     }
 
     {
@@ -130,6 +133,58 @@ JobQueue::addJob (JobType type, std::string const& name,
                 data.load (), func, m_cancelCallback)));
         queueJob (*result.first, lock);
     }
+    return true;
+}
+
+void
+JobQueue::parallelFor (JobType type, std::string const& name,
+    std::size_t count, std::function <void(std::size_t)> const& f)
+{
+    if (count == 0)
+        return;
+
+    // Shared with the helper jobs, which may run after we return.
+    // By then every index is taken, so they never touch f.
+    struct State
+    {
+        std::function <void(std::size_t)> f;
+        std::size_t count;
+        std::atomic <std::size_t> next {0};
+        std::size_t done = 0;
+        std::mutex mutex;
+        std::condition_variable cond;
+
+        void run ()
+        {
+            std::size_t n = 0;
+            for (auto i = next++; i < count; i = next++)
+            {
+                f (i);
+                ++n;
+            }
+            if (n == 0)
+                return;
+            std::lock_guard <std::mutex> lock (mutex);
+            done += n;
+            if (done == count)
+                cond.notify_all ();
+        }
+    };
+
+    auto state = std::make_shared <State> ();
+    state->f = f;
+    state->count = count;
+
+    auto const threads = m_workers.getNumberOfThreads ();
+    auto const helpers = std::min <std::size_t> (count - 1,
+        threads > 1 ? threads - 1 : 0);
+    for (std::size_t i = 0; i < helpers; ++i)
+        addJob (type, name, [state] (Job&) { state->run (); });
+
+    state->run ();
+
+    std::unique_lock <std::mutex> lock (state->mutex);
+    state->cond.wait (lock, [&] { return state->done == state->count; });
 }
 
 int
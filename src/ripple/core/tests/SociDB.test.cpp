@@ -20,6 +20,7 @@
 #include <BeastConfig.h>
 
 #include <ripple/core/ConfigSections.h>
+#include <ripple/core/DatabaseCon.h>
 #include <ripple/core/SociDB.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/TestSuite.h>
@@ -362,12 +363,75 @@ public:
         if (is_regular_file (dbPath))
             remove (dbPath);
     }
+    void testDatabaseConReaders ()
+    {
+        testcase ("readers");
+        DatabaseCon::Setup setup;
+        setup.dataDir = getDatabasePath ();
+        const char* dbInit[] = {
+            "PRAGMA journal_mode=WAL;",
+            "CREATE TABLE IF NOT EXISTS Blobs (  \
+                Seq     BIGINT UNSIGNED,         \
+                Data    BLOB                     \
+            );"};
+        int const dbInitCount = std::extent<decltype(dbInit)>::value;
+        {
+            DatabaseCon con (setup, DatabaseCon::Type::Sqlite,
+                "DatabaseConTest.db", dbInit, dbInitCount, 2);
+
+            // Write through the main session, reusing one bound blob
+            {
+                auto db = con.checkoutDb ();
+                long long seq = 0;
+                soci::blob data (*db);
+                soci::statement st = (db->prepare <<
+                    "INSERT INTO Blobs (Seq, Data) VALUES (:seq, :data);",
+                    soci::use (seq), soci::use (data));
+                std::vector<std::string> const values ({"long value", "x"});
+                for (auto const& v : values)
+                {
+                    ++seq;
+                    data.trim (0);
+                    convert (v, data);
+                    st.execute (true);
+                }
+            }
+
+            // Read it back from the pool
+            auto db = con.checkoutReadDb ();
+            {
+                auto main = con.checkoutDb ();
+                expect (db.get () != main.get ());
+            }
+            soci::blob data (*db);
+            *db << "SELECT Data FROM Blobs WHERE Seq = 2;", soci::into (data);
+            std::string result;
+            convert (data, result);
+            expect (result == "x", result);
+        }
+        {
+            // Without readers, reads share the main session
+            DatabaseCon con (setup, DatabaseCon::Type::Sqlite,
+                "DatabaseConTest.db", dbInit, dbInitCount);
+            auto db = con.checkoutReadDb ();
+            expect (db.get () == &con.getSession ());
+        }
+        using namespace boost::filesystem;
+        for (auto const suffix : {"", "-wal", "-shm"})
+        {
+            path dbPath (getDatabasePath () /
+                (std::string ("DatabaseConTest.db") + suffix));
+            if (is_regular_file (dbPath))
+                remove (dbPath);
+        }
+    }
     void testSQLite ()
     {
         testSQLiteFileNames ();
         testSQLiteSession ();
         testSQLiteSelect ();
         testSQLiteDeleteWithSubselect();
+        testDatabaseConReaders ();
     }
     void run ()
     {
@@ -23,6 +23,8 @@
 #include <ripple/json/to_string.h>
 #include <ripple/json/json_writer.h>
 #include <beast/module/core/text/LexicalCast.h>
+#include <tuple>
+#include <utility>
 
 namespace Json {
 
@@ -146,8 +148,9 @@ Value::CZString::operator = ( const CZString& other )
 bool
 Value::CZString::operator< ( const CZString& other ) const
 {
+    // Static keys are usually the same pointer, which makes a hit cheap.
     if ( cstr_ )
-        return strcmp ( cstr_, other.cstr_ ) < 0;
+        return cstr_ != other.cstr_  &&  strcmp ( cstr_, other.cstr_ ) < 0;
 
     return index_ < other.index_;
 }
@@ -156,7 +159,7 @@ bool
 Value::CZString::operator== ( const CZString& other ) const
 {
     if ( cstr_ )
-        return strcmp ( cstr_, other.cstr_ ) == 0;
+        return cstr_ == other.cstr_  ||  strcmp ( cstr_, other.cstr_ ) == 0;
 
     return index_ == other.index_;
 }
@@ -313,13 +316,17 @@ Value::Value ( const Value& other )
         break;
 
     case stringValue:
-        if ( other.value_.string_ )
+        // A static string is shared rather than duplicated.
+        if ( other.value_.string_  &&  other.allocated_ )
         {
             value_.string_ = valueAllocator ()->duplicateStringValue ( other.value_.string_ );
             allocated_ = true;
         }
         else
-            value_.string_ = 0;
+        {
+            value_.string_ = other.value_.string_;
+            allocated_ = false;
+        }
 
         break;
 
@@ -852,8 +859,8 @@ Value::operator[] ( UInt index )
     if ( it != value_.map_->end ()  &&  (*it).first == key )
         return (*it).second;
 
-    ObjectValues::value_type defaultValue ( key, null );
-    it = value_.map_->insert ( it, defaultValue );
+    it = value_.map_->emplace_hint ( it, std::piecewise_construct,
+        std::forward_as_tuple ( key ), std::forward_as_tuple () );
     return (*it).second;
 }
 
@@ -899,10 +906,10 @@ Value::resolveReference ( const char* key,
     if ( it != value_.map_->end ()  &&  (*it).first == actualKey )
         return (*it).second;
 
-    ObjectValues::value_type defaultValue ( actualKey, null );
-    it = value_.map_->insert ( it, defaultValue );
-    Value& value = (*it).second;
-    return value;
+    // Construct the member in place, so a dynamic key is copied only once.
+    it = value_.map_->emplace_hint ( it, std::piecewise_construct,
+        std::forward_as_tuple ( actualKey ), std::forward_as_tuple () );
+    return (*it).second;
 }
 
 
@@ -966,6 +973,12 @@ Value::append ( const Value& value )
     return (*this)[size ()] = value;
 }
 
+Value&
+Value::append ( Value&& value )
+{
+    return (*this)[size ()] = std::move ( value );
+}
+
 
 Value
 Value::get ( const char* key,
@@ -161,6 +161,55 @@ struct json_value_test : beast::unit_test::suite
         pass ();
     }
 
+    void
+    test_static_string ()
+    {
+        static Json::StaticString const key ("static");
+
+        Json::Value v1 (key);
+        Json::Value v2 = v1;
+        expect (v2.asCString () == key.c_str (), "static string is shared");
+        expect (v1 == v2);
+
+        Json::Value o1;
+        o1[key] = v1;
+        Json::Value const o2 = o1;
+        expect (o2.isMember ("static"));
+        expect (o2[key] == v1);
+    }
+
+    void
+    test_append ()
+    {
+        Json::Value inner (Json::objectValue);
+        inner["x"] = "y";
+
+        Json::Value a (Json::arrayValue);
+        a.append (inner);
+        a.append (std::move (inner));
+        expect (! inner);
+        expect (a.size () == 2);
+        expect (a[0u] == a[1u]);
+        expect (a[1u]["x"] == "y");
+    }
+
+    void
+    test_member_order ()
+    {
+        static Json::StaticString const b ("b");
+
+        Json::Value o;
+        o["c"] = 3;
+        o[b] = 2;
+        o[std::string ("a")] = 1;
+        o[Json::StaticString ("b")] = 4;
+
+        auto const names = o.getMemberNames ();
+        expect (names.size () == 3);
+        expect (names[0] == "a" && names[1] == "b" && names[2] == "c");
+        expect (o[b] == 4);
+    }
+
     void
     test_comparisons()
     {
@@ -224,6 +273,9 @@ struct json_value_test : beast::unit_test::suite
         test_edge_cases ();
         test_copy ();
         test_move ();
+        test_static_string ();
+        test_append ();
+        test_member_order ();
         test_comparisons ();
     }
 };
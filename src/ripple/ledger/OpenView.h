@@ -146,6 +146,16 @@ public:
     void
     apply (TxsRawView& to) const;
 
+    /** Returns `true` if a state item is unchanged since a copy was made.
+
+        The other view must be this view or an earlier copy
+        of it. Anything read through the other view under
+        this key would still be read the same way here.
+    */
+    bool
+    unchangedSince (OpenView const& other,
+        key_type const& key) const;
+
     // ReadView
 
     LedgerInfo const&
@@ -144,12 +144,40 @@ public:
     explicit
     Rules (DigestAwareReadView const& ledger);
 
+    /** Construct rules from a ledger and the configured features.
+
+        The presets are kept, so that code without the
+        configuration can check features with them.
+    */
+    Rules (DigestAwareReadView const& ledger,
+        std::unordered_set<uint256,
+            beast::uhash<>> const& presets);
+
+    /** Construct rules with only the configured features.
+
+        These are the rules of a ledger whose contents
+        have not been analyzed yet.
+    */
+    explicit
+    Rules (std::unordered_set<uint256,
+        beast::uhash<>> const& presets);
+
     /** Returns `true` if a feature is enabled. */
     bool
     enabled (uint256 const& id,
         std::unordered_set<uint256,
             beast::uhash<>> const& presets) const;
 
+    /** Returns `true` if a feature is enabled,
+        by the ledger or by the kept presets.
+    */
+    bool
+    enabled (uint256 const& id) const;
+
+    /** Returns the configured features kept by the rules. */
+    std::unordered_set<uint256, beast::uhash<>> const&
+    presets() const;
+
     /** Returns `true` if these rules don't match the ledger. */
     bool
     changed (DigestAwareReadView const& ledger) const;
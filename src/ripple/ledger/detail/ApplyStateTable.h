@@ -27,6 +27,7 @@
 #include <ripple/protocol/TER.h>
 #include <ripple/protocol/XRPAmount.h>
 #include <beast/utility/Journal.h>
+#include <boost/container/flat_map.hpp>
 #include <memory>
 
 namespace ripple {
@@ -47,7 +48,9 @@ private:
         modify,
     };
 
-    using items_t = std::map<key_type,
+    // A transaction touches few entries, so a sorted vector
+    // beats a node per entry for both lookups and allocations.
+    using items_t = boost::container::flat_map<key_type,
         std::pair<Action, std::shared_ptr<SLE>>>;
 
     items_t items_;
@@ -67,6 +67,11 @@ public:
     read (ReadView const& base,
         Keylet const& k) const;
 
+    // Returns true if both tables hold the same entry for key
+    bool
+    same (RawStateTable const& other,
+        key_type const& key) const;
+
     void
     destroyXRP (XRPAmount const& fee);
 
@@ -358,12 +358,9 @@ ApplyStateTable::peek (ReadView const& base,
         if (! sle)
             return nullptr;
         // Make our own copy
-        using namespace std;
-        iter = items_.emplace_hint (iter,
-            piecewise_construct,
-                forward_as_tuple(sle->key()),
-                    forward_as_tuple(Action::cache,
-                        make_shared<SLE>(*sle)));
+        iter = items_.emplace_hint (iter, sle->key(),
+            std::make_pair(Action::cache,
+                std::make_shared<SLE>(*sle)));
         return iter->second.second;
     }
     auto const& item = iter->second;
@@ -413,11 +410,8 @@ void
 ApplyStateTable::rawErase (ReadView const& base,
     std::shared_ptr<SLE> const& sle)
 {
-    using namespace std;
-    auto const result = items_.emplace(
-        piecewise_construct,
-            forward_as_tuple(sle->key()),
-                forward_as_tuple(Action::erase, sle));
+    auto const result = items_.emplace(sle->key(),
+        std::make_pair(Action::erase, sle));
     if (result.second)
         return;
     auto& item = result.first->second;
@@ -446,11 +440,8 @@ ApplyStateTable::insert (ReadView const& base,
     if (iter == items_.end() ||
         iter->first != sle->key())
     {
-        using namespace std;
-        items_.emplace_hint(iter,
-            piecewise_construct,
-                forward_as_tuple(sle->key()),
-                    forward_as_tuple(Action::insert, sle));
+        items_.emplace_hint(iter, sle->key(),
+            std::make_pair(Action::insert, sle));
         return;
     }
     auto& item = iter->second;
@@ -478,10 +469,8 @@ ApplyStateTable::replace (ReadView const& base,
     if (iter == items_.end() ||
         iter->first != sle->key())
     {
-        using namespace std;
-        items_.emplace_hint(iter, piecewise_construct,
-            forward_as_tuple(sle->key()),
-                forward_as_tuple(Action::modify, sle));
+        items_.emplace_hint(iter, sle->key(),
+            std::make_pair(Action::modify, sle));
         return;
     }
     auto& item = iter->second;
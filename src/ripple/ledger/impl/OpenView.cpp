@@ -167,6 +167,15 @@ OpenView::read (Keylet const& k) const
     return items_.read(*base_, k);
 }
 
+bool
+OpenView::unchangedSince (OpenView const& other,
+    key_type const& key) const
+{
+    if (base_ != other.base_)
+        return false;
+    return items_.same(other.items_, key);
+}
+
 auto
 OpenView::slesBegin() const ->
     std::unique_ptr<sles_type::iter_base>
@@ -334,6 +334,22 @@ RawStateTable::read (ReadView const& base,
     return sle;
 }
 
+bool
+RawStateTable::same (RawStateTable const& other,
+    key_type const& key) const
+{
+    // SLEs are never modified in place once they are
+    // in a table, so sharing the pointer means equal.
+    auto const iter = items_.find(key);
+    auto const otherIter = other.items_.find(key);
+    if (iter == items_.end())
+        return otherIter == other.items_.end();
+    if (otherIter == other.items_.end())
+        return false;
+    return iter->second.first == otherIter->second.first &&
+        iter->second.second == otherIter->second.second;
+}
+
 void
 RawStateTable::destroyXRP(XRPAmount const& fee)
 {
@@ -29,9 +29,21 @@ private:
     std::unordered_set<uint256,
         hardened_hash<>> set_;
     boost::optional<uint256> digest_;
+    std::unordered_set<uint256,
+        beast::uhash<>> presets_;
 
 public:
-    Impl (DigestAwareReadView const& ledger)
+    explicit
+    Impl (std::unordered_set<uint256,
+            beast::uhash<>> const& presets)
+        : presets_(presets)
+    {
+    }
+
+    Impl (DigestAwareReadView const& ledger,
+            std::unordered_set<uint256,
+                beast::uhash<>> const& presets)
+        : presets_(presets)
     {
         auto const k = keylet::amendments();
         digest_ = ledger.digest(k.key);
@@ -55,6 +67,13 @@ public:
         return set_.count(feature) > 0;
     }
 
+    std::unordered_set<uint256,
+        beast::uhash<>> const&
+    presets() const
+    {
+        return presets_;
+    }
+
     bool
     changed (DigestAwareReadView const& ledger) const
     {
@@ -81,7 +100,20 @@ public:
 //------------------------------------------------------------------------------
 
 Rules::Rules (DigestAwareReadView const& ledger)
-    : impl_(std::make_shared<Impl>(ledger))
+    : Rules(ledger, {})
+{
+}
+
+Rules::Rules (DigestAwareReadView const& ledger,
+        std::unordered_set<uint256,
+            beast::uhash<>> const& presets)
+    : impl_(std::make_shared<Impl>(ledger, presets))
+{
+}
+
+Rules::Rules (std::unordered_set<uint256,
+        beast::uhash<>> const& presets)
+    : impl_(std::make_shared<Impl>(presets))
 {
 }
 
@@ -97,6 +129,25 @@ Rules::enabled (uint256 const& id,
     return impl_->enabled(id);
 }
 
+bool
+Rules::enabled (uint256 const& id) const
+{
+    if (! impl_)
+        return false;
+    return impl_->presets().count(id) > 0 ||
+        impl_->enabled(id);
+}
+
+std::unordered_set<uint256, beast::uhash<>> const&
+Rules::presets() const
+{
+    static std::unordered_set<uint256,
+        beast::uhash<>> const none;
+    if (! impl_)
+        return none;
+    return impl_->presets();
+}
+
 bool
 Rules::changed (DigestAwareReadView const& ledger) const
 {
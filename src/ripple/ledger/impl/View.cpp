@@ -24,10 +24,13 @@
 #include <ripple/basics/contract.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/StringUtilities.h>
+#include <ripple/protocol/Feature.h>
 #include <ripple/protocol/st.h>
 #include <ripple/protocol/Quality.h>
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
 #include <cassert>
+#include <limits>
 
 namespace ripple {
 
@@ -1248,6 +1251,16 @@ assetReleased (ApplyView& view,
     return std::make_tuple(released, bIsReleaseFinished);
 }
 
+// Whether trust lines keep the earliest release due on their asset states
+static
+bool
+nextReleaseTimeEnabled (ApplyView const& view)
+{
+    // The rules keep the features enabled by the configuration
+    return (view.flags () & tapENABLE_TESTING) ||
+        view.rules ().enabled (featureNextReleaseTime);
+}
+
 TER
 assetRelease (ApplyView& view,
     AccountID const& uSrcAccountID,
@@ -1256,9 +1269,18 @@ assetRelease (ApplyView& view,
     std::shared_ptr<SLE>& sleRippleState,
         beast::Journal j)
 {
+    // The line remembers when the earliest of its asset states is due.
+    // Before then a scan would release nothing and change nothing.
+    bool const summary = nextReleaseTimeEnabled (view);
+    if (summary && sleRippleState->isFieldPresent (sfNextReleaseTime) &&
+        sleRippleState->getFieldU32 (sfNextReleaseTime) >
+            view.info ().parentCloseTime)
+        return tesSUCCESS;
+
     TER terResult = tesSUCCESS;
     STAmount saBalance = sleRippleState->getFieldAmount(sfBalance);
     STAmount saReserve ({assetCurrency (), noAccount ()});
+    std::uint32_t nextRelease = std::numeric_limits<std::uint32_t>::max ();
     uint256 baseIndex = getAssetStateIndex(uSrcAccountID, uDstAccountID, currency);
     uint256 assetStateIndex = getQualityIndex(baseIndex);
     uint256 assetStateEnd = getQualityNext(assetStateIndex);
@@ -1321,12 +1343,18 @@ assetRelease (ApplyView& view,
 
         // no newly release.
         if (released <= delivered)
+        {
+            nextRelease = std::min (nextRelease,
+                sleAssetState->getFieldU32 (sfNextReleaseTime));
             continue;
+        }
 
         if (!bIsReleaseFinished) {
             // just update delivered amount if there are further releases.
             sleAssetState->setFieldAmount(sfDeliveredAmount, released);
             view.update(sleAssetState);
+            nextRelease = std::min (nextRelease,
+                sleAssetState->getFieldU32 (sfNextReleaseTime));
             JLOG(j.trace) << "asset state updated";
         } else {
             // compact asset state if no more further release.
@@ -1422,6 +1450,14 @@ assetRelease (ApplyView& view,
         view.update (sleRippleState);
     }
 
+    if (summary && tesSUCCESS == terResult &&
+        (!sleRippleState->isFieldPresent (sfNextReleaseTime) ||
+            sleRippleState->getFieldU32 (sfNextReleaseTime) != nextRelease))
+    {
+        sleRippleState->setFieldU32 (sfNextReleaseTime, nextRelease);
+        view.update (sleRippleState);
+    }
+
     JLOG(j.trace) << "final balance:" << saBalance << " reserved:" << saReserve;
 
     return terResult;
@@ -1533,7 +1569,13 @@ issueAsset (ApplyView& view,
             }
             // Move released amount to TrustLine
             if (tesSUCCESS == terResult)
+            {
+                // The new amount may be due before anything else on the line
+                if (nextReleaseTimeEnabled (view) &&
+                        sleRippleState->isFieldPresent (sfNextReleaseTime))
+                    sleRippleState->makeFieldAbsent (sfNextReleaseTime);
                 assetRelease (view, uSenderID, uReceiverID, currency, sleRippleState, j);
+            }
             return {true, terResult};
         }
     }
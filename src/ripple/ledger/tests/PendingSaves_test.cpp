@@ -18,6 +18,7 @@
 #include <BeastConfig.h>
 #include <ripple/app/ledger/PendingSaves.h>
 #include <beast/unit_test/suite.h>
+#include <thread>
 
 namespace ripple {
 namespace test {
@@ -47,6 +48,15 @@ struct PendingSaves_test : public beast::unit_test::suite
         expect (!ps.startWork (0));
         ps.finishWork(0);
         expect (! ps.pending (0));
+
+        // Waiting for a save finished elsewhere
+        ps.await (0);
+        expect (ps.shouldWork (1, true));
+        expect (ps.startWork (1));
+        std::thread t ([&ps] { ps.finishWork (1); });
+        ps.await (1);
+        expect (! ps.pending (1));
+        t.join();
     }
 
     void run() override
@@ -387,6 +387,32 @@ class View_test
         }
     }
 
+    // Verify change detection between shallow copies
+    void
+    testUnchanged()
+    {
+        using namespace jtx;
+        Env env(*this);
+        wipe(env.openLedger);
+        auto const open = env.open();
+        OpenView v0(open.get());
+        v0.rawInsert(sle(1, 1));
+        v0.rawInsert(sle(2, 2));
+        OpenView v1(v0);
+        expect(v1.unchangedSince(v0, k(1).key));
+        expect(v1.unchangedSince(v0, k(3).key));
+        v1.rawReplace(sle(1, 3));
+        v1.rawErase(sle(2));
+        v1.rawInsert(sle(3, 3));
+        expect(! v1.unchangedSince(v0, k(1).key));
+        expect(! v1.unchangedSince(v0, k(2).key));
+        expect(! v1.unchangedSince(v0, k(3).key));
+        expect(v1.unchangedSince(v0, k(4).key));
+        OpenView v2(open.get());
+        expect(v2.unchangedSince(v0, k(4).key));
+        expect(! v2.unchangedSince(v0, k(1).key));
+    }
+
     // Return a list of keys found via sles
     static
     std::vector<uint256>
@@ -571,6 +597,7 @@ class View_test
         testMetaSucc();
         testStacked();
         testContext();
+        testUnchanged();
         testSles();
         testRegressions();
     }
@@ -26,6 +26,7 @@
 #include <ripple/resource/Consumer.h>
 #include <ripple/protocol/Book.h>
 #include <beast/threads/Stoppable.h>
+#include <atomic>
 #include <mutex>
 
 namespace ripple {
@@ -126,6 +127,26 @@ public:
     virtual void send (
         Json::Value const& jvObj, std::string const& sObj, bool broadcast);
 
+    /** Send an encoded binary stream event.
+        Only called when isBinary() is true. The default does nothing,
+        since a subscriber must support binary messages to enable them.
+        @see StreamEvent
+    */
+    virtual void sendBinary (std::string const& event, bool broadcast);
+
+    /** Returns true if transaction and ledger events are sent as binary
+        stream events instead of JSON.
+    */
+    bool isBinary () const
+    {
+        return binary_;
+    }
+
+    void setBinary (bool binary)
+    {
+        binary_ = binary;
+    }
+
     std::uint64_t getSeq ();
 
     void onSendEmpty ();
@@ -156,6 +177,7 @@ private:
     hash_set <AccountID> normalSubscriptions_;
     std::shared_ptr <PathRequest> mPathRequest;
     std::uint64_t                 mSeq;
+    std::atomic <bool>            binary_ {false};
 };
 
 } // ripple
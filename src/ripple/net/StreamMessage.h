@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NET_STREAMMESSAGE_H_INCLUDED
+#define RIPPLE_NET_STREAMMESSAGE_H_INCLUDED
+
+#include <ripple/net/InfoSub.h>
+#include <ripple/json/to_string.h>
+#include <boost/optional.hpp>
+#include <functional>
+#include <string>
+
+namespace ripple {
+
+/** An event published to subscribers in the form each one asked for.
+
+    The JSON and binary forms are built the first time a subscriber needs
+    them, at most once each, so an event nobody wants as JSON is never
+    expanded to JSON. Not thread safe; publish from one thread at a time.
+*/
+class StreamMessage
+{
+public:
+    using JsonFunction = std::function<Json::Value()>;
+    using BinaryFunction = std::function<std::string()>;
+
+    /** Create a message.
+        @param json Builds the JSON form.
+        @param binary Builds the binary form. If empty, binary subscribers
+                      are sent the JSON form.
+    */
+    StreamMessage (JsonFunction json, BinaryFunction binary = {})
+        : makeJson_ (std::move (json))
+        , makeBinary_ (std::move (binary))
+    {
+    }
+
+    StreamMessage (StreamMessage const&) = delete;
+    StreamMessage& operator= (StreamMessage const&) = delete;
+
+    void
+    send (InfoSub& sub, bool broadcast)
+    {
+        if (makeBinary_ && sub.isBinary ())
+        {
+            if (! binary_)
+                binary_ = makeBinary_ ();
+            sub.sendBinary (*binary_, broadcast);
+            return;
+        }
+
+        if (! json_)
+        {
+            json_ = makeJson_ ();
+            sJson_ = to_string (*json_);
+        }
+        sub.send (*json_, sJson_, broadcast);
+    }
+
+private:
+    JsonFunction makeJson_;
+    BinaryFunction makeBinary_;
+    boost::optional<Json::Value> json_;
+    std::string sJson_;
+    boost::optional<std::string> binary_;
+};
+
+} // ripple
+
+#endif
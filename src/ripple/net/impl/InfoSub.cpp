@@ -82,6 +82,10 @@ void InfoSub::send (
     send (jvObj, broadcast);
 }
 
+void InfoSub::sendBinary (std::string const&, bool)
+{
+}
+
 std::uint64_t InfoSub::getSeq ()
 {
     return mSeq;
@@ -23,6 +23,7 @@
 #include <ripple/json/json_value.h>
 #include <ripple/overlay/Peer.h>
 #include <ripple/overlay/PeerSet.h>
+#include <ripple/protocol/PublicKey.h>
 #include <ripple/server/Handoff.h>
 #include <beast/asio/ssl_bundle.h>
 #include <beast/http/message.h>
@@ -71,6 +72,7 @@ public:
         bool expire = false;
         beast::IP::Address public_ip;
         int ipLimit = 0;
+        bool reduceRelay = false;
     };
 
     using PeerSequence = std::vector <Peer::ptr>;
@@ -153,11 +155,13 @@ public:
     relay (protocol::TMProposeSet& m,
         uint256 const& uid) = 0;
 
-    /** Relay a validation. */
+    /** Relay a validation.
+        The validator's key is used to honor squelch requests.
+    */
     virtual
     void
     relay (protocol::TMValidation& m,
-        uint256 const& uid) = 0;
+        uint256 const& uid, PublicKey const& validator) = 0;
 
     virtual
     void
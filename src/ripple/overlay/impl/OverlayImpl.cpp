@@ -19,6 +19,7 @@
 
 #include <BeastConfig.h>
 #include <ripple/app/misc/HashRouter.h>
+#include <ripple/app/misc/UniqueNodeList.h>
 #include <ripple/core/DatabaseCon.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/Log.h>
@@ -119,6 +120,9 @@ OverlayImpl::Timer::on_timer (error_code ec)
     if ((++overlay_.timer_count_ % Tuning::checkSeconds) == 0)
         overlay_.check();
 
+    if (overlay_.setup_.reduceRelay)
+        overlay_.slots_.onTimer();
+
     timer_.expires_from_now (std::chrono::seconds(1));
     timer_.async_wait(overlay_.strand_.wrap(std::bind(
         &Timer::on_timer, shared_from_this(),
@@ -150,6 +154,21 @@ OverlayImpl::OverlayImpl (
     , m_resolver (resolver)
     , next_id_(1)
     , timer_count_(0)
+    , slots_ (stopwatch(),
+        [this](PublicKey const& validator, Peer::id_t id,
+            std::chrono::seconds duration)
+        {
+            auto const peer = findPeerByShortID (id);
+            if (! peer)
+                return;
+            protocol::TMSquelch m;
+            m.set_squelch (duration.count() != 0);
+            m.set_validatorpubkey (validator.data(), validator.size());
+            if (m.squelch())
+                m.set_squelchduration (
+                    static_cast<std::uint32_t>(duration.count()));
+            peer->send (std::make_shared<Message>(m, protocol::mtSQUELCH));
+        })
 {
     beast::PropertyStream::Source::add (m_peerFinder.get());
 }
@@ -659,6 +678,10 @@ void
 OverlayImpl::onPeerDeactivate (Peer::id_t id,
     RippleAddress const& publicKey)
 {
+    // Must not hold mutex_, the slots may unsquelch other peers
+    if (setup_.reduceRelay)
+        slots_.deletePeer (id);
+
     std::lock_guard <decltype(mutex_)> lock (mutex_);
     m_shortIdMap.erase(id);
     m_publicKeyMap.erase(publicKey);
@@ -748,6 +771,30 @@ OverlayImpl::reportTraffic (
     m_traffic.addCount (cat, isInbound, number);
 }
 
+void
+OverlayImpl::updateSlot (Slice const& validator, Peer::id_t id)
+{
+    if (! setup_.reduceRelay || ! publicKeyType (validator))
+        return;
+    if (! app_.getUNL ().nodeInUNL (RippleAddress::createNodePublic (
+            Blob (validator.data(), validator.data() + validator.size()))))
+        return;
+    slots_.update (PublicKey (validator), id);
+}
+
+void
+OverlayImpl::updateSlots (uint256 const& suppression, Slice const& validator)
+{
+    if (! setup_.reduceRelay)
+        return;
+    std::set<HashRouter::PeerShortID> peers;
+    if (! app_.getHashRouter ().setFlagsGetPeers (
+            suppression, slotChecked, peers))
+        return;
+    for (auto const id : peers)
+        updateSlot (validator, id);
+}
+
 std::size_t
 OverlayImpl::selectPeers (PeerSet& set, std::size_t limit,
     std::function<bool(std::shared_ptr<Peer> const&)> score)
@@ -941,10 +988,19 @@ OverlayImpl::relay (protocol::TMProposeSet& m,
         return;
     auto const sm = std::make_shared<Message>(
         m, protocol::mtPROPOSE_LEDGER);
+    boost::optional<PublicKey> validator;
+    if (setup_.reduceRelay && publicKeyType (makeSlice (m.nodepubkey())))
+        validator.emplace (makeSlice (m.nodepubkey()));
     for_each([&](std::shared_ptr<PeerImp> const& p)
     {
         if (skip.find(p->id()) != skip.end())
             return;
+        if (validator && p->isSquelched (*validator))
+        {
+            reportTraffic (TrafficCount::category::CT_squelch_suppressed,
+                false, static_cast<int>(sm->getBuffer().size()));
+            return;
+        }
         if (! m.has_hops() || p->hopsAware())
             p->send(sm);
     });
@@ -952,7 +1008,7 @@ OverlayImpl::relay (protocol::TMProposeSet& m,
 
 void
 OverlayImpl::relay (protocol::TMValidation& m,
-    uint256 const& uid)
+    uint256 const& uid, PublicKey const& validator)
 {
     if (m.has_hops() && m.hops() >= maxTTL)
         return;
@@ -966,6 +1022,12 @@ OverlayImpl::relay (protocol::TMValidation& m,
     {
         if (skip.find(p->id()) != skip.end())
             return;
+        if (setup_.reduceRelay && p->isSquelched (validator))
+        {
+            reportTraffic (TrafficCount::category::CT_squelch_suppressed,
+                false, static_cast<int>(sm->getBuffer().size()));
+            return;
+        }
         if (! m.has_hops() || p->hopsAware())
             p->send(sm);
     });
@@ -1060,6 +1122,7 @@ setup_Overlay (BasicConfig const& config)
     auto const& section = config.section("overlay");
     setup.context = make_SSLContext();
     setup.expire = get<bool>(section, "expire", false);
+    setup.reduceRelay = get<bool>(section, "reduce_relay", false);
 
     set (setup.ipLimit, "ip_limit", section);
     if (setup.ipLimit < 0)
@@ -21,9 +21,11 @@
 #define RIPPLE_OVERLAY_OVERLAYIMPL_H_INCLUDED
 
 #include <ripple/app/main/Application.h>
+#include <ripple/app/misc/HashRouter.h>
 #include <ripple/core/Job.h>
 #include <ripple/overlay/Overlay.h>
 #include <ripple/overlay/impl/Manifest.h>
+#include <ripple/overlay/impl/ReduceRelay.h>
 #include <ripple/overlay/impl/TrafficCount.h>
 #include <ripple/server/Handoff.h>
 #include <ripple/server/ServerHandler.h>
@@ -121,6 +123,7 @@ private:
     std::atomic <Peer::id_t> next_id_;
     ManifestCache manifestCache_;
     int timer_count_;
+    reduce_relay::Slots slots_;
 
     //--------------------------------------------------------------------------
 
@@ -194,7 +197,7 @@ public:
 
     void
     relay (protocol::TMValidation& m,
-        uint256 const& uid) override;
+        uint256 const& uid, PublicKey const& validator) override;
 
     virtual
     void
@@ -275,6 +278,23 @@ public:
         bool isInbound,
         int bytes);
 
+    /** Record that a peer delivered a message from a validator.
+        Used by reduce-relay to select upstream peers; messages from
+        validators that are not in our UNL are ignored.
+    */
+    void
+    updateSlot (Slice const& validator, Peer::id_t id);
+
+    /** Record every peer that delivered a proposal or validation.
+        Called once the message's signature has been checked; later
+        duplicates are recorded as they arrive, see slotChecked.
+    */
+    void
+    updateSlots (uint256 const& suppression, Slice const& validator);
+
+    /** HashRouter flag set once a message can be counted for its slot. */
+    static int const slotChecked = SF_PRIVATE1;
+
 private:
     std::shared_ptr<HTTP::Writer>
     makeRedirectResponse (PeerFinder::Slot::ptr const& slot,
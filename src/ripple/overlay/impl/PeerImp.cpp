@@ -125,6 +125,8 @@ PeerImp::run()
             }
         }
     }
+    reduceRelay_ = overlay_.setup().reduceRelay &&
+        hello_.has_reducerelay() && hello_.reducerelay();
     if (m_inbound)
     {
         doAccept();
@@ -203,7 +205,8 @@ PeerImp::send (Message::pointer const& m)
 
     auto sendq_size = send_queue_.size();
 
-    if (sendq_size < Tuning::targetSendQueue)
+    // Bursts of consensus traffic do not count against the peer
+    if (send_queue_.backlog() < Tuning::targetSendQueue)
     {
         // To detect a peer that does not read from their
         // side of the connection, we expect a peer to have
@@ -236,6 +239,23 @@ PeerImp::charge (Resource::Charge const& fee)
 
 //------------------------------------------------------------------------------
 
+bool
+PeerImp::isSquelched (PublicKey const& validator)
+{
+    if (! reduceRelay_)
+        return false;
+    std::lock_guard<std::mutex> lock (squelchLock_);
+    auto const iter = squelched_.find (validator);
+    if (iter == squelched_.end())
+        return false;
+    if (iter->second > clock_type::now())
+        return true;
+    squelched_.erase (iter);
+    return false;
+}
+
+//------------------------------------------------------------------------------
+
 bool
 PeerImp::crawl() const
 {
@@ -297,6 +317,8 @@ PeerImp::json()
             ret[jss::latency] = static_cast<Json::UInt> (latency.count());
     }
 
+    ret[jss::send_queue] = send_queue_.json();
+
     ret[jss::uptime] = static_cast<Json::UInt>(
         std::chrono::duration_cast<std::chrono::seconds>(uptime()).count());
 
@@ -666,7 +688,8 @@ PeerImp::makeResponse (bool crawl,
     resp.headers.append("Server", BuildInfo::getFullVersionString());
     resp.headers.append ("Crawl", crawl ? "public" : "private");
     protocol::TMHello hello = buildHello(sharedValue,
-        overlay_.setup().public_ip, remote, app_);
+        overlay_.setup().public_ip, remote,
+            overlay_.setup().reduceRelay, app_);
     appendHello(resp, hello);
     return resp;
 }
@@ -1247,8 +1270,13 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMProposeSet> const& m)
         Blob(set.nodepubkey ().begin (), set.nodepubkey ().end ()),
         Blob(set.signature ().begin (), set.signature ().end ()));
 
-    if (! app_.getHashRouter ().addSuppressionPeer (suppression, id_))
+    int flags;
+    if (! app_.getHashRouter ().addSuppressionPeer (suppression, id_, flags))
     {
+        // Duplicates count too, they tell us which peers are upstreams.
+        // Until the signature is checked, the router remembers the peer.
+        if (reduceRelay_ && (flags & OverlayImpl::slotChecked))
+            overlay_.updateSlot (makeSlice (set.nodepubkey()), id_);
         p_journal_.trace << "Proposal: duplicate";
         return;
     }
@@ -1583,9 +1611,13 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMValidation> const& m)
             return;
         }
 
+        int flags;
         if (! app_.getHashRouter ().addSuppressionPeer(
-            sha512Half(makeSlice(m->validation())), id_))
+            sha512Half(makeSlice(m->validation())), id_, flags))
         {
+            if (reduceRelay_ && (flags & OverlayImpl::slotChecked))
+                overlay_.updateSlot (makeSlice (
+                    val->getSignerPublic().getNodePublic()), id_);
             p_journal_.trace << "Validation: duplicate";
             return;
         }
@@ -1629,7 +1661,7 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMGetObjectByHash> const& m)
     if (packet.query ())
     {
         // this is a query
-        if (send_queue_.size() >= Tuning::dropSendQueue)
+        if (send_queue_.backlog() >= Tuning::dropSendQueue)
         {
             if (p_journal_.debug) p_journal_.debug <<
                 "GetObject: Large send queue";
@@ -1747,6 +1779,45 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMGetObjectByHash> const& m)
     }
 }
 
+void
+PeerImp::onMessage (std::shared_ptr <protocol::TMSquelch> const& m)
+{
+    if (! reduceRelay_)
+    {
+        p_journal_.debug << "Squelch: reduce-relay not negotiated";
+        fee_ = Resource::feeUnwantedData;
+        return;
+    }
+
+    auto const slice = makeSlice (m->validatorpubkey());
+    if (! publicKeyType (slice))
+    {
+        p_journal_.warning << "Squelch: malformed validator key";
+        fee_ = Resource::feeBadData;
+        return;
+    }
+
+    PublicKey const validator (slice);
+    std::lock_guard<std::mutex> lock (squelchLock_);
+    if (! m->squelch())
+    {
+        squelched_.erase (validator);
+        return;
+    }
+
+    // Never honor a squelch for longer than we would ask for ourselves
+    std::chrono::seconds duration (m->has_squelchduration() ?
+        m->squelchduration() : 0);
+    if (duration < reduce_relay::minSquelchDuration ||
+        duration > reduce_relay::maxSquelchDuration)
+    {
+        p_journal_.debug << "Squelch: invalid duration " << duration.count();
+        fee_ = Resource::feeBadData;
+        return;
+    }
+    squelched_[validator] = clock_type::now() + duration;
+}
+
 //--------------------------------------------------------------------------
 
 void
@@ -1908,6 +1979,10 @@ PeerImp::checkPropose (Job& job,
         return;
     }
 
+    if (reduceRelay_)
+        overlay_.updateSlots (proposal->getSuppressionID (),
+            makeSlice (set.nodepubkey ()));
+
     if (isTrusted)
     {
         app_.getOPs ().processTrustedProposal (
@@ -1952,9 +2027,15 @@ PeerImp::checkValidation (STValidation::pointer val,
             return;
         }
 
+        if (reduceRelay_)
+            overlay_.updateSlots (sha512Half (makeSlice (
+                packet->validation ())), makeSlice (
+                    val->getSignerPublic().getNodePublic()));
+
         if (app_.getOPs ().recvValidation(
                 val, std::to_string(id())))
-            overlay_.relay(*packet, signingHash);
+            overlay_.relay(*packet, signingHash, PublicKey (makeSlice (
+                val->getSignerPublic().getNodePublic())));
     }
     catch (std::exception const&)
     {
@@ -2090,7 +2171,7 @@ PeerImp::getLedger (std::shared_ptr<protocol::TMGetLedger> const& m)
     }
     else
     {
-        if (send_queue_.size() >= Tuning::dropSendQueue)
+        if (send_queue_.backlog() >= Tuning::dropSendQueue)
         {
             if (p_journal_.debug) p_journal_.debug <<
                 "GetLedger: Large send queue";
@@ -21,17 +21,20 @@
 #define RIPPLE_OVERLAY_PEERIMP_H_INCLUDED
 
 #include <ripple/app/ledger/LedgerProposal.h>
+#include <ripple/basics/UnorderedContainers.h>
 #include <ripple/basics/Log.h> // deprecated
 #include <ripple/nodestore/Database.h>
 #include <ripple/overlay/predicates.h>
 #include <ripple/overlay/impl/ProtocolMessage.h>
 #include <ripple/overlay/impl/OverlayImpl.h>
+#include <ripple/overlay/impl/SendQueue.h>
 #include <ripple/resource/Fees.h>
 #include <ripple/core/Config.h>
 #include <ripple/core/Job.h>
 #include <ripple/core/LoadFeeTrack.h>
 #include <ripple/core/LoadEvent.h>
 #include <ripple/protocol/Protocol.h>
+#include <ripple/protocol/PublicKey.h>
 #include <ripple/protocol/STTx.h>
 #include <ripple/protocol/STValidation.h>
 #include <beast/ByteOrder.h>
@@ -44,7 +47,7 @@
 #include <beast/utility/WrappedSink.h>
 #include <cstdint>
 #include <deque>
-#include <queue>
+#include <mutex>
 
 namespace ripple {
 
@@ -156,13 +159,18 @@ private:
     beast::http::message http_message_;
     beast::http::body http_body_;
     beast::asio::streambuf write_buffer_;
-    std::queue<Message::pointer> send_queue_;
+    SendQueue send_queue_;
     bool gracefulClose_ = false;
     int large_sendq_ = 0;
     int no_ping_ = 0;
     std::unique_ptr <LoadEvent> load_event_;
     bool hopsAware_ = false;
 
+    // Reduce-relay is used only if both sides advertised it
+    bool reduceRelay_ = false;
+    std::mutex mutable squelchLock_;
+    hash_map<PublicKey, clock_type::time_point> squelched_;
+
     friend class OverlayImpl;
 
 public:
@@ -258,6 +266,12 @@ public:
         return hopsAware_;
     }
 
+    /** Returns `true` if this peer asked us not to relay
+        the messages of the given validator.
+    */
+    bool
+    isSquelched (PublicKey const& validator);
+
     void
     check();
 
@@ -425,6 +439,7 @@ public:
     void onMessage (std::shared_ptr <protocol::TMHaveTransactionSet> const& m);
     void onMessage (std::shared_ptr <protocol::TMValidation> const& m);
     void onMessage (std::shared_ptr <protocol::TMGetObjectByHash> const& m);
+    void onMessage (std::shared_ptr <protocol::TMSquelch> const& m);
 
 private:
     State state() const
@@ -0,0 +1,281 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_REDUCERELAY_H_INCLUDED
+#define RIPPLE_OVERLAY_REDUCERELAY_H_INCLUDED
+
+#include <ripple/overlay/Peer.h>
+#include <ripple/protocol/PublicKey.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/chrono.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace ripple {
+
+namespace reduce_relay {
+
+/** Number of upstream peers kept for each validator. */
+static std::size_t const maxSelectedPeers = 5;
+
+/** Messages a peer must deliver before it can be selected. */
+static std::uint32_t const messageThreshold = 20;
+
+/** Bounds of the (randomized) squelch duration sent to a peer. */
+static std::chrono::seconds const minSquelchDuration (300);
+static std::chrono::seconds const maxSquelchDuration (600);
+
+/** How long a selection is kept before it is rotated. */
+static std::chrono::seconds const selectionLifetime (240);
+
+/** A validator or a selected peer silent for this long is idle. */
+static std::chrono::seconds const idled (8);
+
+/** Chooses, for every validator, a small set of upstream peers.
+
+    Each time a proposal or validation arrives we record which peer
+    delivered it. Once enough peers have delivered enough messages the
+    slot picks maxSelectedPeers of them at random and asks every other
+    peer to squelch that validator for a random duration. Selections are
+    rotated periodically, and whenever a selected peer goes idle or
+    disconnects, so that a single slow upstream cannot starve us.
+
+    The squelch callback is invoked with the slot lock held; it must not
+    call back into the Slots object.
+*/
+class Slots
+{
+public:
+    using clock_type = Stopwatch;
+    using time_point = clock_type::time_point;
+    using id_t = Peer::id_t;
+
+    /** Called to (un)squelch a validator on a peer.
+        A duration of zero means unsquelch.
+    */
+    using squelch_handler = std::function<void(
+        PublicKey const& validator, id_t peer,
+            std::chrono::seconds duration)>;
+
+    Slots (clock_type& clock, squelch_handler handler)
+        : clock_ (clock)
+        , handler_ (std::move (handler))
+        , gen_ (std::random_device{}())
+    {
+    }
+
+    Slots (Slots const&) = delete;
+    Slots& operator= (Slots const&) = delete;
+
+    /** Record that peer relayed a message originated by validator. */
+    void
+    update (PublicKey const& validator, id_t peer)
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        auto const now = clock_.now();
+        auto& slot = slots_[validator];
+        slot.lastMessage = now;
+
+        auto iter = slot.peers.find (peer);
+        if (iter == slot.peers.end())
+        {
+            iter = slot.peers.emplace (peer, PeerInfo{}).first;
+            // A new peer showing up after selection is squelched
+            // right away, we already have enough upstreams.
+            if (slot.selected)
+            {
+                squelch (validator, peer, iter->second, now);
+                return;
+            }
+        }
+
+        auto& info = iter->second;
+        info.lastMessage = now;
+        if (slot.selected || info.state == State::squelched)
+            return;
+
+        if (++info.count < messageThreshold)
+            return;
+
+        std::vector<id_t> candidates;
+        for (auto const& p : slot.peers)
+            if (p.second.count >= messageThreshold)
+                candidates.push_back (p.first);
+        if (candidates.size() < maxSelectedPeers)
+            return;
+
+        std::shuffle (candidates.begin(), candidates.end(), gen_);
+        candidates.resize (maxSelectedPeers);
+
+        slot.selected = true;
+        slot.selectedAt = now;
+        for (auto& p : slot.peers)
+        {
+            if (std::find (candidates.begin(), candidates.end(),
+                    p.first) != candidates.end())
+                p.second.state = State::selected;
+            else
+                squelch (validator, p.first, p.second, now);
+        }
+    }
+
+    /** Forget a peer, for example when it disconnects. */
+    void
+    deletePeer (id_t peer)
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        for (auto& v : slots_)
+        {
+            auto const iter = v.second.peers.find (peer);
+            if (iter == v.second.peers.end())
+                continue;
+            bool const wasSelected =
+                iter->second.state == State::selected;
+            v.second.peers.erase (iter);
+            if (wasSelected)
+                reset (v.first, v.second);
+        }
+    }
+
+    /** Expire idle slots and rotate stale selections.
+        Called once per second from the overlay timer.
+    */
+    void
+    onTimer ()
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        auto const now = clock_.now();
+        for (auto iter = slots_.begin(); iter != slots_.end();)
+        {
+            auto& slot = iter->second;
+            if (now - slot.lastMessage > idled)
+            {
+                reset (iter->first, slot);
+                iter = slots_.erase (iter);
+                continue;
+            }
+
+            if (slot.selected)
+            {
+                bool rotate = now - slot.selectedAt > selectionLifetime;
+                for (auto const& p : slot.peers)
+                {
+                    if (p.second.state == State::selected &&
+                            now - p.second.lastMessage > idled)
+                        rotate = true;
+                }
+                if (rotate)
+                    reset (iter->first, slot);
+            }
+            ++iter;
+        }
+    }
+
+    /** Returns the number of validators being tracked. */
+    std::size_t
+    size () const
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        return slots_.size();
+    }
+
+    /** Returns the peers currently selected for a validator. */
+    std::vector<id_t>
+    getSelected (PublicKey const& validator) const
+    {
+        std::vector<id_t> result;
+        std::lock_guard<std::mutex> lock (mutex_);
+        auto const iter = slots_.find (validator);
+        if (iter == slots_.end())
+            return result;
+        for (auto const& p : iter->second.peers)
+            if (p.second.state == State::selected)
+                result.push_back (p.first);
+        std::sort (result.begin(), result.end());
+        return result;
+    }
+
+private:
+    enum class State
+    {
+        counting,
+        selected,
+        squelched
+    };
+
+    struct PeerInfo
+    {
+        State state = State::counting;
+        std::uint32_t count = 0;
+        time_point lastMessage;
+        time_point expire;
+    };
+
+    struct Slot
+    {
+        bool selected = false;
+        time_point selectedAt;
+        time_point lastMessage;
+        hash_map<id_t, PeerInfo> peers;
+    };
+
+    void
+    squelch (PublicKey const& validator, id_t peer,
+        PeerInfo& info, time_point now)
+    {
+        std::uniform_int_distribution<std::chrono::seconds::rep> dist (
+            minSquelchDuration.count(), maxSquelchDuration.count());
+        std::chrono::seconds const duration (dist (gen_));
+        info.state = State::squelched;
+        info.expire = now + duration;
+        handler_ (validator, peer, duration);
+    }
+
+    // Unsquelch everyone and go back to counting
+    void
+    reset (PublicKey const& validator, Slot& slot)
+    {
+        auto const now = clock_.now();
+        for (auto& p : slot.peers)
+        {
+            if (p.second.state == State::squelched &&
+                    p.second.expire > now)
+                handler_ (validator, p.first, std::chrono::seconds (0));
+            p.second = PeerInfo{};
+        }
+        slot.selected = false;
+    }
+
+    clock_type& clock_;
+    squelch_handler handler_;
+    std::mt19937 gen_;
+    std::mutex mutable mutex_;
+    hash_map<PublicKey, Slot> slots_;
+};
+
+} // reduce_relay
+
+} // ripple
+
+#endif
@@ -0,0 +1,228 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_SENDQUEUE_H_INCLUDED
+#define RIPPLE_OVERLAY_SENDQUEUE_H_INCLUDED
+
+#include <ripple/overlay/Message.h>
+#include <ripple/overlay/impl/TrafficCount.h>
+#include <ripple/json/json_value.h>
+#include <ripple/protocol/JsonFields.h>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+
+namespace ripple {
+
+/** The outgoing messages of a peer, split into priority classes.
+
+    Messages are dequeued in priority order, so proposals, validations
+    and candidate transaction sets do not wait behind a backlog of ledger
+    data we are serving. A lower class passed over maxBypass times in a
+    row is served next, so it is never starved. The message returned by
+    front() stays selected until pop() is called, because its buffer is
+    in use by the pending write.
+
+    Only the queue operations must be called on the peer's strand; the
+    statistics are atomic and may be read from any thread.
+*/
+class SendQueue
+{
+public:
+    enum Priority
+    {
+        consensus,  // proposals, validations, candidate sets, peer status
+        normal,     // transactions, overlay management, our own queries
+        bulk,       // ledger data we are sharing
+        priorities  // must be last
+    };
+
+    /** Sends a waiting class can be passed over before it goes next. */
+    static std::size_t const maxBypass = 8;
+
+    static
+    Priority
+    priority (TrafficCount::category cat)
+    {
+        switch (cat)
+        {
+        case TrafficCount::category::CT_base:
+        case TrafficCount::category::CT_proposal:
+        case TrafficCount::category::CT_validation:
+        case TrafficCount::category::CT_squelch:
+        // Consensus needs the candidate sets to converge
+        case TrafficCount::category::CT_share_trans:
+            return consensus;
+        case TrafficCount::category::CT_share_ledger:
+            return bulk;
+        default:
+            break;
+        }
+        return normal;
+    }
+
+    static
+    char const*
+    getName (Priority p)
+    {
+        switch (p)
+        {
+        case consensus: return "consensus";
+        case normal:    return "normal";
+        case bulk:      return "bulk";
+        default:
+            break;
+        }
+        assert (false);
+        return "unknown";
+    }
+
+    SendQueue() = default;
+    SendQueue (SendQueue const&) = delete;
+    SendQueue& operator= (SendQueue const&) = delete;
+
+    /** Returns the number of messages, including the one being sent. */
+    std::size_t
+    size() const
+    {
+        return size_.load();
+    }
+
+    /** Returns the number of messages waiting in one class. */
+    std::size_t
+    size (Priority p) const
+    {
+        return stats_[p].queued.load();
+    }
+
+    /** Returns the number of messages waiting behind consensus traffic.
+        This is the backlog that tells whether the peer keeps up.
+    */
+    std::size_t
+    backlog() const
+    {
+        return size (normal) + size (bulk);
+    }
+
+    bool
+    empty() const
+    {
+        return size() == 0;
+    }
+
+    void
+    push (Message::pointer const& m)
+    {
+        auto const p = priority (
+            static_cast<TrafficCount::category>(m->getCategory()));
+        queues_[p].push_back (m);
+        auto& stats = stats_[p];
+        auto const queued = ++stats.queued;
+        if (queued > stats.peak.load())
+            stats.peak = queued;
+        ++size_;
+    }
+
+    /** Returns the message to write next.
+        Precondition: ! empty()
+    */
+    Message::pointer const&
+    front()
+    {
+        assert (! empty());
+        if (! current_)
+        {
+            // The highest class, unless a lower one waited too long
+            int next = priorities;
+            for (int p = consensus; p < priorities; ++p)
+            {
+                if (queues_[p].empty())
+                    continue;
+                if (next == priorities)
+                    next = p;
+                else if (bypassed_[p] >= maxBypass)
+                {
+                    next = p;
+                    break;
+                }
+            }
+            assert (next != priorities);
+
+            for (int p = consensus; p < priorities; ++p)
+            {
+                if (p == next)
+                    bypassed_[p] = 0;
+                else if (! queues_[p].empty())
+                    ++bypassed_[p];
+            }
+
+            auto& q = queues_[next];
+            current_ = std::move (q.front());
+            q.pop_front();
+            --stats_[next].queued;
+            ++stats_[next].sent;
+        }
+        return current_;
+    }
+
+    /** Remove the message returned by front(). */
+    void
+    pop()
+    {
+        front();
+        current_.reset();
+        --size_;
+    }
+
+    /** Per-class queue depth and counters for the peers RPC. */
+    Json::Value
+    json() const
+    {
+        Json::Value ret (Json::objectValue);
+        for (int p = consensus; p < priorities; ++p)
+        {
+            auto const& stats = stats_[p];
+            auto& j = ret[getName (static_cast<Priority>(p))];
+            j[jss::queued] = static_cast<Json::UInt>(stats.queued.load());
+            j[jss::peak] = static_cast<Json::UInt>(stats.peak.load());
+            j[jss::sent] = static_cast<Json::UInt>(stats.sent.load());
+        }
+        return ret;
+    }
+
+private:
+    struct Stats
+    {
+        std::atomic<std::size_t> queued {0};
+        std::atomic<std::size_t> peak {0};
+        std::atomic<std::uint64_t> sent {0};
+    };
+
+    std::array<std::deque<Message::pointer>, priorities> queues_;
+    std::array<Stats, priorities> stats_;
+    std::array<std::size_t, priorities> bypassed_ {};
+    Message::pointer current_;
+    std::atomic<std::size_t> size_ {0};
+};
+
+} // ripple
+
+#endif
@@ -50,11 +50,14 @@ enum
 std::pair<uint256, bool>
 makeSharedValue (SSL* ssl, beast::Journal journal);
 
-/** Build a TMHello protocol message. */
+/** Build a TMHello protocol message.
+    @param reduceRelay `true` to advertise support for TMSquelch.
+*/
 protocol::TMHello
 buildHello (uint256 const& sharedValue,
     beast::IP::Address public_ip,
-    beast::IP::Endpoint remote, Application& app);
+    beast::IP::Endpoint remote, bool reduceRelay,
+        Application& app);
 
 /** Insert HTTP headers based on the TMHello protocol message. */
 void
@@ -72,6 +72,8 @@ public:
         CT_share_ledger,   // ledgers we share
         CT_get_trans,      // transaction sets we try to get
         CT_share_trans,    // transaction sets we get
+        CT_squelch,        // reduce-relay squelch requests
+        CT_squelch_suppressed, // relays we skipped because of a squelch
         CT_unknown         // must be last
     };
 
@@ -0,0 +1,165 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/overlay/impl/ReduceRelay.h>
+#include <ripple/protocol/SecretKey.h>
+#include <beast/unit_test/suite.h>
+#include <map>
+
+namespace ripple {
+
+class ReduceRelay_test : public beast::unit_test::suite
+{
+    using Slots = reduce_relay::Slots;
+
+    // peer id -> seconds squelched, zero when unsquelched
+    std::map<Peer::id_t, std::chrono::seconds> squelched_;
+    int unsquelches_ = 0;
+
+    Slots::squelch_handler
+    handler()
+    {
+        return [this](PublicKey const&, Peer::id_t id,
+            std::chrono::seconds duration)
+        {
+            if (duration.count() == 0)
+                ++unsquelches_;
+            squelched_[id] = duration;
+        };
+    }
+
+    void
+    reset()
+    {
+        squelched_.clear();
+        unsquelches_ = 0;
+    }
+
+    // Every peer in [first, last] delivers n messages
+    static
+    void
+    deliver (Slots& slots, PublicKey const& validator,
+        Peer::id_t first, Peer::id_t last, std::uint32_t n)
+    {
+        for (std::uint32_t i = 0; i < n; ++i)
+            for (auto id = first; id <= last; ++id)
+                slots.update (validator, id);
+    }
+
+public:
+    void
+    testSelection()
+    {
+        testcase ("selection");
+        reset();
+        TestStopwatch clock;
+        Slots slots (clock, handler());
+        auto const validator = randomKeyPair(KeyType::secp256k1).first;
+
+        // Not enough peers: nothing is selected
+        deliver (slots, validator, 1, 4, reduce_relay::messageThreshold);
+        expect (slots.getSelected (validator).empty());
+        expect (squelched_.empty());
+
+        // Two more peers cross the threshold: five are kept
+        deliver (slots, validator, 5, 6, reduce_relay::messageThreshold);
+        auto const selected = slots.getSelected (validator);
+        expect (selected.size() == reduce_relay::maxSelectedPeers);
+        expect (squelched_.size() == 1);
+        for (auto const& s : squelched_)
+        {
+            expect (std::find (selected.begin(), selected.end(),
+                s.first) == selected.end());
+            expect (s.second >= reduce_relay::minSquelchDuration);
+            expect (s.second <= reduce_relay::maxSquelchDuration);
+        }
+
+        // A late peer is squelched immediately
+        slots.update (validator, 7);
+        expect (squelched_.size() == 2);
+        expect (squelched_[7].count() != 0);
+    }
+
+    void
+    testDeletePeer()
+    {
+        testcase ("delete peer");
+        reset();
+        TestStopwatch clock;
+        Slots slots (clock, handler());
+        auto const validator = randomKeyPair(KeyType::secp256k1).first;
+
+        deliver (slots, validator, 1, 7, reduce_relay::messageThreshold);
+        auto const selected = slots.getSelected (validator);
+        expect (selected.size() == reduce_relay::maxSelectedPeers);
+        expect (squelched_.size() == 2);
+
+        // Losing a selected upstream unsquelches everyone
+        slots.deletePeer (selected.front());
+        expect (slots.getSelected (validator).empty());
+        expect (unsquelches_ == 2);
+    }
+
+    void
+    testTimer()
+    {
+        testcase ("timer");
+        reset();
+        TestStopwatch clock;
+        Slots slots (clock, handler());
+        auto const validator = randomKeyPair(KeyType::secp256k1).first;
+
+        deliver (slots, validator, 1, 6, reduce_relay::messageThreshold);
+        expect (slots.getSelected (validator).size() ==
+            reduce_relay::maxSelectedPeers);
+
+        // Selection is rotated once it gets old
+        auto const selected = slots.getSelected (validator);
+        for (auto elapsed = std::chrono::seconds (0);
+            elapsed <= reduce_relay::selectionLifetime;
+                elapsed += std::chrono::seconds (1))
+        {
+            ++clock;
+            for (auto id : selected)
+                slots.update (validator, id);
+            slots.onTimer();
+        }
+        expect (slots.getSelected (validator).empty());
+        expect (unsquelches_ == 1);
+
+        // An idle validator is forgotten
+        expect (slots.size() == 1);
+        clock.advance (reduce_relay::idled + std::chrono::seconds (1));
+        slots.onTimer();
+        expect (slots.size() == 0);
+    }
+
+    void
+    run()
+    {
+        testSelection();
+        testDeletePeer();
+        testTimer();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ReduceRelay,overlay,ripple);
+
+}
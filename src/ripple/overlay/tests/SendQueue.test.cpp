@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/overlay/impl/SendQueue.h>
+#include <beast/unit_test/suite.h>
+
+namespace ripple {
+
+class SendQueue_test : public beast::unit_test::suite
+{
+    static
+    Message::pointer
+    makePing()
+    {
+        protocol::TMPing m;
+        m.set_type (protocol::TMPing::ptPING);
+        return std::make_shared<Message> (m, protocol::mtPING);
+    }
+
+    static
+    Message::pointer
+    makeLedgerData()
+    {
+        protocol::TMLedgerData m;
+        m.set_ledgerhash (std::string (32, '\0'));
+        m.set_ledgerseq (1);
+        m.set_type (protocol::liBASE);
+        return std::make_shared<Message> (m, protocol::mtLEDGER_DATA);
+    }
+
+    static
+    Message::pointer
+    makeCandidateSet()
+    {
+        protocol::TMHaveTransactionSet m;
+        m.set_status (protocol::tsHAVE);
+        m.set_hash (std::string (32, '\0'));
+        return std::make_shared<Message> (m, protocol::mtHAVE_SET);
+    }
+
+public:
+    void
+    testPriority()
+    {
+        testcase ("priority");
+        SendQueue q;
+        expect (q.empty());
+
+        // The first bulk message is being written when the rest arrive
+        auto const first = makeLedgerData();
+        q.push (first);
+        expect (q.front() == first);
+        q.push (makeLedgerData());
+        q.push (makeLedgerData());
+        auto const ping = makePing();
+        q.push (ping);
+        expect (q.size() == 4);
+        expect (q.size (SendQueue::bulk) == 2);
+        expect (q.size (SendQueue::consensus) == 1);
+
+        // The write in progress is never preempted
+        expect (q.front() == first);
+        q.pop();
+
+        // Consensus traffic jumps ahead of the bulk backlog
+        expect (q.front() == ping);
+        q.pop();
+        expect (q.size() == 2);
+        expect (q.size (SendQueue::consensus) == 0);
+        q.pop();
+        q.pop();
+        expect (q.empty());
+
+        auto const j = q.json();
+        expect (j["bulk"][jss::sent].asUInt() == 3);
+        expect (j["bulk"][jss::peak].asUInt() == 2);
+        expect (j["consensus"][jss::sent].asUInt() == 1);
+        expect (j["normal"][jss::queued].asUInt() == 0);
+    }
+
+    void
+    testFairness()
+    {
+        testcase ("fairness");
+        SendQueue q;
+
+        // Candidate sets are consensus traffic
+        q.push (makeCandidateSet());
+        expect (q.size (SendQueue::consensus) == 1);
+        expect (q.backlog() == 0);
+        q.pop();
+
+        // A steady stream of consensus traffic lets bulk through
+        auto const bulk = makeLedgerData();
+        q.push (bulk);
+        expect (q.front() == bulk);
+        q.pop();
+        q.push (makeLedgerData());
+        expect (q.backlog() == 1);
+
+        std::size_t sent = 0;
+        bool bulkSent = false;
+        while (! bulkSent && sent < 2 * SendQueue::maxBypass)
+        {
+            q.push (makePing());
+            bulkSent = q.front()->getCategory() ==
+                static_cast<int>(TrafficCount::category::CT_share_ledger);
+            q.pop();
+            ++sent;
+        }
+        expect (bulkSent);
+        expect (sent == SendQueue::maxBypass + 1);
+        expect (q.backlog() == 0);
+        expect (q.size (SendQueue::consensus) == 1);
+    }
+
+    void
+    run()
+    {
+        testPriority();
+        testFairness();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SendQueue,overlay,ripple);
+
+}
@@ -38,6 +38,7 @@ extern uint256 const featureMultiSign;
 extern uint256 const featureSusPay;
 extern uint256 const featureTrustSetAuth;
 extern uint256 const featureFeeEscalation;
+extern uint256 const featureNextReleaseTime;
 
 } // ripple
 
@@ -181,6 +181,14 @@ public:
         return jsonName;
     }
 
+    /** Returns the JSON name as a key which Json::Value does not copy.
+        Fields are never destroyed, so the name outlives any Json::Value.
+    */
+    Json::StaticString getJsonKey () const
+    {
+        return Json::StaticString (jsonName.c_str ());
+    }
+
     bool isGeneric () const
     {
         return fieldCode == 0;
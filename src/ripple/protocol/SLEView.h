@@ -0,0 +1,116 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_PROTOCOL_SLEVIEW_H_INCLUDED
+#define RIPPLE_PROTOCOL_SLEVIEW_H_INCLUDED
+
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/protocol/STVector256.h>
+#include <ripple/basics/Slice.h>
+#include <memory>
+#include <vector>
+
+namespace ripple {
+
+/** A read-only ledger entry decoded in place.
+
+    The view refers to the serialized entry held by its owner, usually
+    a SHAMapItem in the state map, without copying it. Construction only
+    locates the top level fields; a field is decoded when it is read.
+    Scans that look at a few fields of many entries use this instead of
+    building a full STLedgerEntry for each one.
+
+    Getters follow STObject: a field the entry's format allows but which
+    is absent reads as its default value, any other field throws.
+*/
+class SLEView
+{
+public:
+    /** Create a view of serialized data kept alive by owner. */
+    SLEView (std::shared_ptr<void const> owner,
+        Slice const& data, uint256 const& key);
+
+    SLEView (SLEView const&) = default;
+    SLEView& operator= (SLEView const&) = default;
+
+    uint256 const&
+    key() const
+    {
+        return key_;
+    }
+
+    LedgerEntryType
+    getType() const
+    {
+        return type_;
+    }
+
+    /** Returns the complete serialized entry. */
+    Slice const&
+    slice() const
+    {
+        return data_;
+    }
+
+    bool
+    isFieldPresent (SField const& field) const;
+
+    std::uint8_t getFieldU8 (SField const& field) const;
+    std::uint16_t getFieldU16 (SField const& field) const;
+    std::uint32_t getFieldU32 (SField const& field) const;
+    std::uint64_t getFieldU64 (SField const& field) const;
+    uint128 getFieldH128 (SField const& field) const;
+    uint160 getFieldH160 (SField const& field) const;
+    uint256 getFieldH256 (SField const& field) const;
+    AccountID getAccountID (SField const& field) const;
+    Blob getFieldVL (SField const& field) const;
+    STAmount getFieldAmount (SField const& field) const;
+    STVector256 getFieldV256 (SField const& field) const;
+
+    /** Decode the entire entry. */
+    std::shared_ptr<STLedgerEntry>
+    materialize() const;
+
+private:
+    struct Field
+    {
+        SField const* field;
+        Slice data;         // value, including any length prefix
+    };
+
+    Field const*
+    find (SField const& field,
+        SerializedTypeID type) const;
+
+    template <class T, class V>
+    V
+    get (SField const& field, SerializedTypeID type) const;
+
+    std::shared_ptr<void const> owner_;
+    Slice data_;
+    uint256 key_;
+    LedgerEntryType type_;
+    SOTemplate const* format_;
+    std::vector<Field> fields_;
+};
+
+} // ripple
+
+#endif
@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_PROTOCOL_STARENA_H_INCLUDED
+#define RIPPLE_PROTOCOL_STARENA_H_INCLUDED
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace ripple {
+
+/** Thread local arena for the heap storage of serialized types.
+
+    While a Scope is alive on a thread, the serialized objects that do
+    not fit in an STVar's inline buffer (nested objects, arrays, path
+    sets and so on) are bump allocated from blocks owned by the thread,
+    instead of each coming from the global heap.
+
+    A block counts the objects carved out of it and goes back to the
+    system once the last of them is destroyed and the thread has moved
+    on to a new block. Objects may therefore outlive the scope and may
+    be destroyed on any thread; they only keep their block alive.
+*/
+class STArena
+{
+public:
+    /** Route allocations on this thread to the arena while alive. */
+    class Scope
+    {
+    public:
+        Scope();
+        ~Scope();
+
+        Scope (Scope const&) = delete;
+        Scope& operator= (Scope const&) = delete;
+    };
+
+    /** Returns true if a Scope is alive on this thread. */
+    static
+    bool
+    active();
+
+    /** Returns the number of arena blocks not yet released. */
+    static
+    std::size_t
+    blocks();
+
+    /** Allocate storage, from the arena if a Scope is alive. */
+    static
+    void*
+    allocate (std::size_t bytes);
+
+    /** Release storage obtained from allocate(), from any thread. */
+    static
+    void
+    deallocate (void* p);
+
+    /** Construct a T in storage obtained from allocate(). */
+    template <class T, class... Args>
+    static
+    T*
+    make (Args&&... args)
+    {
+        void* const p = allocate (sizeof(T));
+        try
+        {
+            return new(p) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate (p);
+            throw;
+        }
+    }
+};
+
+} // ripple
+
+#endif
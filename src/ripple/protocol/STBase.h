@@ -22,6 +22,7 @@
 
 #include <ripple/basics/contract.h>
 #include <ripple/protocol/SField.h>
+#include <ripple/protocol/STArena.h>
 #include <ripple/protocol/Serializer.h>
 #include <ostream>
 #include <memory>
@@ -156,13 +157,42 @@ protected:
     {
         using U = std::decay_t<T>;
         if (sizeof(U) > n)
-            return new U(std::forward<T>(val));
+            return STArena::make<U>(std::forward<T>(val));
         return new(buf) U(std::forward<T>(val));
     }
 };
 
 //------------------------------------------------------------------------------
 
+/** Returns the field as a T, or nullptr if it is not one.
+
+    A field is nearly always exactly the type its accessor asks for,
+    which comparing the dynamic type confirms much more cheaply than
+    a dynamic_cast. Other cases, such as a missing optional field,
+    fall back to dynamic_cast.
+*/
+template <class T>
+inline
+T*
+fieldCast (STBase* b)
+{
+    if (b && typeid(*b) == typeid(T))
+        return static_cast<T*>(b);
+    return dynamic_cast<T*>(b);
+}
+
+template <class T>
+inline
+T const*
+fieldCast (STBase const* b)
+{
+    if (b && typeid(*b) == typeid(T))
+        return static_cast<T const*>(b);
+    return dynamic_cast<T const*>(b);
+}
+
+//------------------------------------------------------------------------------
+
 std::ostream& operator<< (std::ostream& out, const STBase& t);
 
 } // ripple
@@ -439,12 +439,26 @@ public:
         return &v_[offset].get();
     }
 
-    int getFieldIndex (SField const& field) const;
+    // Objects with a template find fields by direct index
+    int getFieldIndex (SField const& field) const
+    {
+        if (mType != nullptr)
+            return mType->getIndex (field);
+        return getFreeFieldIndex (field);
+    }
     SField const& getFieldSType (int index) const;
 
     const STBase& peekAtField (SField const& field) const;
     STBase& getField (SField const& field);
-    const STBase* peekAtPField (SField const& field) const;
+    const STBase* peekAtPField (SField const& field) const
+    {
+        int const index = getFieldIndex (field);
+
+        if (index == -1)
+            return nullptr;
+
+        return peekAtPIndex (index);
+    }
     STBase* getPField (SField const& field, bool createOkay = false);
 
     // these throw if the field type doesn't match, or return default values
@@ -540,7 +554,7 @@ public:
             rf = makeFieldPresent (field);
 
         using Bits = STBitString<160>;
-        if (auto cf = dynamic_cast<Bits*> (rf))
+        if (auto cf = fieldCast<Bits> (rf))
             cf->setValue (v);
         else
             Throw<std::runtime_error> ("Wrong field type");
@@ -566,6 +580,9 @@ public:
 private:
     void add (Serializer & s, bool withSigningFields) const;
 
+    // Linear search, for objects without a template
+    int getFreeFieldIndex (SField const& field) const;
+
     // Sort the entries in an STObject into the order that they will be
     // serialized.  Note: they are not sorted into pointer value order, they
     // are sorted by SField::fieldCode.
@@ -602,7 +619,7 @@ private:
         if (id == STI_NOTPRESENT)
             return V (); // optional field not present
 
-        const T* cf = dynamic_cast<const T*> (rf);
+        const T* cf = fieldCast<T> (rf);
 
         if (! cf)
             Throw<std::runtime_error> ("Wrong field type");
@@ -628,7 +645,7 @@ private:
         if (id == STI_NOTPRESENT)
             return empty; // optional field not present
 
-        const T* cf = dynamic_cast<const T*> (rf);
+        const T* cf = fieldCast<T> (rf);
 
         if (! cf)
             Throw<std::runtime_error> ("Wrong field type");
@@ -650,7 +667,7 @@ private:
         if (rf->getSType () == STI_NOTPRESENT)
             rf = makeFieldPresent (field);
 
-        T* cf = dynamic_cast<T*> (rf);
+        T* cf = fieldCast<T>(rf);
 
         if (! cf)
             Throw<std::runtime_error> ("Wrong field type");
@@ -670,7 +687,7 @@ private:
         if (rf->getSType () == STI_NOTPRESENT)
             rf = makeFieldPresent (field);
 
-        T* cf = dynamic_cast<T*> (rf);
+        T* cf = fieldCast<T>(rf);
 
         if (! cf)
             Throw<std::runtime_error> ("Wrong field type");
@@ -690,7 +707,7 @@ private:
         if (rf->getSType () == STI_NOTPRESENT)
             rf = makeFieldPresent (field);
 
-        T* cf = dynamic_cast<T*> (rf);
+        T* cf = fieldCast<T>(rf);
 
         if (! cf)
             Throw<std::runtime_error> ("Wrong field type");
@@ -737,7 +754,7 @@ inline
 T const*
 STObject::Proxy<T>::find() const
 {
-    return dynamic_cast<T const*>(
+    return fieldCast<T>(
         st_->peekAtPField(*f_));
 }
 
@@ -754,10 +771,10 @@ STObject::Proxy<T>::assign(U&& u)
     }
     T* t;
     if (style_ == SOE_INVALID)
-        t = dynamic_cast<T*>(
+        t = fieldCast<T>(
             st_->getPField(*f_, true));
     else
-        t = dynamic_cast<T*>(
+        t = fieldCast<T>(
             st_->makeFieldPresent(*f_));
     assert(t);
     *t = std::forward<U>(u);
@@ -913,7 +930,7 @@ STObject::operator[](TypedField<T> const& f) const
         // with no template
         Throw<missing_field_error> (f);
     auto const u =
-        dynamic_cast<T const*>(b);
+        fieldCast<T>(b);
     if (! u)
     {
         assert(mType);
@@ -939,7 +956,7 @@ STObject::operator[](OptionaledField<T> const& of) const
     if (! b)
         return boost::none;
     auto const u =
-        dynamic_cast<T const*>(b);
+        fieldCast<T>(b);
     if (! u)
     {
         assert(mType);
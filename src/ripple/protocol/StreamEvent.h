@@ -0,0 +1,90 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_PROTOCOL_STREAMEVENT_H_INCLUDED
+#define RIPPLE_PROTOCOL_STREAMEVENT_H_INCLUDED
+
+#include <ripple/basics/Blob.h>
+#include <ripple/basics/Slice.h>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <string>
+
+namespace ripple {
+
+/** An event of a binary subscription stream.
+
+    Subscribers which ask for binary streams receive each transaction and
+    ledger event as one binary message instead of JSON. The message is a
+    fixed header followed by two canonical serializations:
+
+        offset  size  field
+        0       1     version, currently 1
+        1       1     type
+        2       2     flags
+        4       4     ledger sequence
+        8       4     ledger close time, zero if not closed
+        12      4     engine result (TER, signed)
+        16      4     size of the object
+        20      4     size of the metadata
+        24            the object, followed by the metadata
+
+    Integers are big-endian. For a transaction the object is the STTx and
+    the metadata is the TxMeta, empty if the transaction was not applied.
+    For a closed ledger the object is the ledger header as it is hashed and
+    there is no metadata.
+*/
+struct StreamEvent
+{
+    enum Type : std::uint8_t
+    {
+        transaction = 1,
+        ledgerClosed = 2
+    };
+
+    // Flags
+    static std::uint16_t const validated = 0x0001;
+
+    static std::uint8_t const version = 1;
+    static std::size_t const headerSize = 24;
+
+    Type type = transaction;
+    std::uint16_t flags = 0;
+    std::uint32_t ledgerSeq = 0;
+    std::uint32_t closeTime = 0;
+    std::int32_t result = 0;
+    Blob object;
+    Blob meta;
+};
+
+/** Encode a binary stream event. */
+std::string
+encodeStreamEvent (StreamEvent::Type type, std::uint16_t flags,
+    std::uint32_t ledgerSeq, std::uint32_t closeTime, std::int32_t result,
+        Slice const& object, Slice const& meta);
+
+/** Decode a binary stream event.
+    @return The event, or boost::none if the message is malformed.
+*/
+boost::optional<StreamEvent>
+decodeStreamEvent (Slice const& message);
+
+} // ripple
+
+#endif
@@ -49,5 +49,6 @@ uint256 const featureMultiSign = feature("MultiSign");
 uint256 const featureSusPay = feature("SusPay");
 uint256 const featureTrustSetAuth = feature("TrustSetAuth");
 uint256 const featureFeeEscalation = feature("FeeEscalation");
+uint256 const featureNextReleaseTime = feature("NextReleaseTime");
 
 } // ripple
@@ -102,6 +102,7 @@ LedgerFormats::LedgerFormats ()
             << SOElement (sfHighNode,            SOE_OPTIONAL)
             << SOElement (sfHighQualityIn,       SOE_OPTIONAL)
             << SOElement (sfHighQualityOut,      SOE_OPTIONAL)
+            << SOElement (sfNextReleaseTime,     SOE_OPTIONAL)  // earliest asset release due
             ;
 
     add ("SuspendedPayment", ltSUSPAY) <<
@@ -0,0 +1,287 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/protocol/SLEView.h>
+#include <ripple/basics/contract.h>
+#include <ripple/protocol/LedgerFormats.h>
+#include <ripple/protocol/STAccount.h>
+#include <ripple/protocol/STBlob.h>
+#include <ripple/protocol/STInteger.h>
+#include <ripple/protocol/STPathSet.h>
+#include <boost/optional.hpp>
+
+namespace ripple {
+
+namespace {
+
+void skipValue (SerialIter& sit, int type);
+
+// Skip the fields of an inner object, through its end marker
+void
+skipObject (SerialIter& sit)
+{
+    for (;;)
+    {
+        int type;
+        int name;
+        sit.getFieldID (type, name);
+        if (type == STI_OBJECT && name == 1)
+            return;
+        skipValue (sit, type);
+    }
+}
+
+// Skip the objects of an array, through its end marker
+void
+skipArray (SerialIter& sit)
+{
+    for (;;)
+    {
+        int type;
+        int name;
+        sit.getFieldID (type, name);
+        if (type == STI_ARRAY && name == 1)
+            return;
+        if (type != STI_OBJECT)
+            Throw<std::runtime_error> ("Non-object in array");
+        skipObject (sit);
+    }
+}
+
+void
+skipPathSet (SerialIter& sit)
+{
+    for (;;)
+    {
+        int const type = sit.get8 ();
+        if (type == STPathElement::typeNone)
+            return;
+        if (type == STPathElement::typeBoundary)
+            continue;
+        if (type & ~STPathElement::typeAll)
+            Throw<std::runtime_error> ("bad path element");
+        if (type & STPathElement::typeAccount)
+            sit.skip (160 / 8);
+        if (type & STPathElement::typeCurrency)
+            sit.skip (160 / 8);
+        if (type & STPathElement::typeIssuer)
+            sit.skip (160 / 8);
+    }
+}
+
+void
+skipValue (SerialIter& sit, int type)
+{
+    switch (type)
+    {
+    case STI_UINT8:     sit.skip (1); break;
+    case STI_UINT16:    sit.skip (2); break;
+    case STI_UINT32:    sit.skip (4); break;
+    case STI_UINT64:    sit.skip (8); break;
+    case STI_HASH128:   sit.skip (128 / 8); break;
+    case STI_HASH160:   sit.skip (160 / 8); break;
+    case STI_HASH256:   sit.skip (256 / 8); break;
+
+    case STI_AMOUNT:
+        // Issued amounts are followed by the currency and issuer
+        if (sit.get64 () & 0x8000000000000000ull)
+            sit.skip (2 * 160 / 8);
+        break;
+
+    case STI_VL:
+    case STI_ACCOUNT:
+    case STI_VECTOR256:
+        sit.skip (sit.getVLDataLength ());
+        break;
+
+    case STI_PATHSET:   skipPathSet (sit); break;
+    case STI_OBJECT:    skipObject (sit); break;
+    case STI_ARRAY:     skipArray (sit); break;
+
+    default:
+        Throw<std::runtime_error> ("Unknown field type");
+    }
+}
+
+} // namespace
+
+SLEView::SLEView (std::shared_ptr<void const> owner,
+        Slice const& data, uint256 const& key)
+    : owner_ (std::move (owner))
+    , data_ (data)
+    , key_ (key)
+    , format_ (nullptr)
+{
+    SerialIter sit (data_);
+    fields_.reserve (24);
+    boost::optional<std::uint16_t> type;
+    while (! sit.empty ())
+    {
+        int fieldType;
+        int fieldName;
+        sit.getFieldID (fieldType, fieldName);
+        auto const& f = SField::getField (fieldType, fieldName);
+        if (f.isInvalid ())
+            Throw<std::runtime_error> ("Unknown field");
+
+        auto const start = data_.size () - sit.getBytesLeft ();
+        skipValue (sit, fieldType);
+        auto const end = data_.size () - sit.getBytesLeft ();
+        fields_.push_back ({&f, Slice (data_.data () + start, end - start)});
+
+        if (f == sfLedgerEntryType)
+            type = SerialIter (fields_.back ().data).get16 ();
+    }
+
+    auto const item = type ? LedgerFormats::getInstance ().findByType (
+        static_cast <LedgerEntryType> (*type)) : nullptr;
+    if (item == nullptr)
+        Throw<std::runtime_error> ("invalid ledger entry type");
+    type_ = item->getType ();
+    format_ = &item->elements;
+}
+
+auto
+SLEView::find (SField const& field, SerializedTypeID type) const ->
+    Field const*
+{
+    if (field.fieldType != type)
+        Throw<std::runtime_error> ("Wrong field type");
+
+    for (auto const& f : fields_)
+    {
+        if (*f.field == field)
+            return &f;
+    }
+
+    if (format_->getIndex (field) == -1)
+        Throw<std::runtime_error> ("Field not found");
+
+    return nullptr;
+}
+
+template <class T, class V>
+V
+SLEView::get (SField const& field, SerializedTypeID type) const
+{
+    auto const f = find (field, type);
+    if (! f)
+        return V ();
+    SerialIter sit (f->data);
+    return T (sit, field).value ();
+}
+
+bool
+SLEView::isFieldPresent (SField const& field) const
+{
+    for (auto const& f : fields_)
+    {
+        if (*f.field == field)
+            return true;
+    }
+    return false;
+}
+
+std::uint8_t
+SLEView::getFieldU8 (SField const& field) const
+{
+    return get <STUInt8, std::uint8_t> (field, STI_UINT8);
+}
+
+std::uint16_t
+SLEView::getFieldU16 (SField const& field) const
+{
+    return get <STUInt16, std::uint16_t> (field, STI_UINT16);
+}
+
+std::uint32_t
+SLEView::getFieldU32 (SField const& field) const
+{
+    return get <STUInt32, std::uint32_t> (field, STI_UINT32);
+}
+
+std::uint64_t
+SLEView::getFieldU64 (SField const& field) const
+{
+    return get <STUInt64, std::uint64_t> (field, STI_UINT64);
+}
+
+uint128
+SLEView::getFieldH128 (SField const& field) const
+{
+    return get <STHash128, uint128> (field, STI_HASH128);
+}
+
+uint160
+SLEView::getFieldH160 (SField const& field) const
+{
+    return get <STHash160, uint160> (field, STI_HASH160);
+}
+
+uint256
+SLEView::getFieldH256 (SField const& field) const
+{
+    return get <STHash256, uint256> (field, STI_HASH256);
+}
+
+AccountID
+SLEView::getAccountID (SField const& field) const
+{
+    return get <STAccount, AccountID> (field, STI_ACCOUNT);
+}
+
+Blob
+SLEView::getFieldVL (SField const& field) const
+{
+    auto const f = find (field, STI_VL);
+    if (! f)
+        return Blob ();
+    SerialIter sit (f->data);
+    return sit.getVL ();
+}
+
+STAmount
+SLEView::getFieldAmount (SField const& field) const
+{
+    auto const f = find (field, STI_AMOUNT);
+    if (! f)
+        return STAmount ();
+    SerialIter sit (f->data);
+    return STAmount (sit, field);
+}
+
+STVector256
+SLEView::getFieldV256 (SField const& field) const
+{
+    auto const f = find (field, STI_VECTOR256);
+    if (! f)
+        return STVector256 ();
+    SerialIter sit (f->data);
+    return STVector256 (sit, field);
+}
+
+std::shared_ptr<STLedgerEntry>
+SLEView::materialize() const
+{
+    SerialIter sit (data_);
+    return std::make_shared<STLedgerEntry> (sit, key_);
+}
+
+} // ripple
@@ -0,0 +1,166 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/protocol/STArena.h>
+#include <ripple/basics/contract.h>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+
+namespace ripple {
+
+namespace {
+
+struct Block
+{
+    // Live allocations, plus one while this is the thread's current block
+    std::atomic<std::size_t> count {1};
+    std::uint8_t* free;
+    std::uint8_t* end;
+};
+
+// Every allocation is preceded by the block it came from, or by
+// nullptr if it came from the global heap. The header keeps the
+// allocations aligned the way operator new aligns them.
+std::size_t const headerSize = 16;
+
+std::size_t const blockSize = 64 * 1024;
+
+// Larger requests would waste most of a block
+std::size_t const maxArenaBytes = blockSize / 16;
+
+static_assert (headerSize >= sizeof(Block*), "");
+static_assert (headerSize % alignof(Block) == 0, "");
+
+std::atomic<std::size_t> liveBlocks {0};
+
+inline
+std::size_t
+roundUp (std::size_t bytes)
+{
+    return (bytes + headerSize - 1) & ~(headerSize - 1);
+}
+
+void
+release (Block* b)
+{
+    if (--b->count != 0)
+        return;
+    b->~Block();
+    std::free (b);
+    --liveBlocks;
+}
+
+Block*
+makeBlock ()
+{
+    auto const mem = static_cast<std::uint8_t*>(std::malloc (blockSize));
+    if (! mem)
+        Throw<std::bad_alloc> ();
+    auto const b = new(mem) Block;
+    b->free = mem + roundUp (sizeof(Block));
+    b->end = mem + blockSize;
+    ++liveBlocks;
+    return b;
+}
+
+struct ThreadArena
+{
+    int depth = 0;
+    Block* current = nullptr;
+
+    ~ThreadArena()
+    {
+        if (current)
+            release (current);
+    }
+};
+
+thread_local ThreadArena threadArena;
+
+} // namespace
+
+STArena::Scope::Scope()
+{
+    ++threadArena.depth;
+}
+
+STArena::Scope::~Scope()
+{
+    --threadArena.depth;
+}
+
+bool
+STArena::active()
+{
+    return threadArena.depth > 0;
+}
+
+std::size_t
+STArena::blocks()
+{
+    return liveBlocks.load();
+}
+
+void*
+STArena::allocate (std::size_t bytes)
+{
+    auto const n = headerSize + roundUp (bytes);
+    std::uint8_t* p;
+    Block* b = nullptr;
+
+    auto& arena = threadArena;
+    if (arena.depth > 0 && n <= maxArenaBytes)
+    {
+        if (! arena.current ||
+            static_cast<std::size_t>(
+                arena.current->end - arena.current->free) < n)
+        {
+            auto const next = makeBlock ();
+            if (arena.current)
+                release (arena.current);
+            arena.current = next;
+        }
+        b = arena.current;
+        p = b->free;
+        b->free += n;
+        ++b->count;
+    }
+    else
+    {
+        p = static_cast<std::uint8_t*>(::operator new (n));
+    }
+
+    *reinterpret_cast<Block**>(p) = b;
+    return p + headerSize;
+}
+
+void
+STArena::deallocate (void* p)
+{
+    auto const mem = static_cast<std::uint8_t*>(p) - headerSize;
+    auto const b = *reinterpret_cast<Block**>(mem);
+    if (b)
+        release (b);
+    else
+        ::operator delete (mem);
+}
+
+} // ripple
@@ -152,8 +152,10 @@ Json::Value STArray::getJson (int p) const
         {
             Json::Value& inner = v.append (Json::objectValue);
             auto const& fname = object.getFName ();
-            auto k = fname.hasName () ? fname.fieldName : std::to_string(index);
-            inner[k] = object.getJson (p);
+            if (fname.hasName ())
+                inner[fname.getJsonKey ()] = object.getJson (p);
+            else
+                inner[std::to_string(index)] = object.getJson (p);
             index++;
         }
     }
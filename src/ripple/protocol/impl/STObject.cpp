@@ -332,11 +332,8 @@ uint256 STObject::getSigningHash (std::uint32_t prefix) const
     return s.getSHA512Half ();
 }
 
-int STObject::getFieldIndex (SField const& field) const
+int STObject::getFreeFieldIndex (SField const& field) const
 {
-    if (mType != nullptr)
-        return mType->getIndex (field);
-
     int i = 0;
     for (auto const& elem : v_)
     {
@@ -373,16 +370,6 @@ STObject::getFieldSType (int index) const
     return v_[index]->getFName ();
 }
 
-const STBase* STObject::peekAtPField (SField const& field) const
-{
-    int index = getFieldIndex (field);
-
-    if (index == -1)
-        return nullptr;
-
-    return peekAtPIndex (index);
-}
-
 STBase* STObject::getPField (SField const& field, bool createOkay)
 {
     int index = getFieldIndex (field);
@@ -420,7 +407,7 @@ STArray& STObject::peekFieldArray (SField const& field)
 
 bool STObject::setFlag (std::uint32_t f)
 {
-    STUInt32* t = dynamic_cast<STUInt32*> (getPField (sfFlags, true));
+    STUInt32* t = fieldCast<STUInt32> (getPField (sfFlags, true));
 
     if (!t)
         return false;
@@ -431,7 +418,7 @@ bool STObject::setFlag (std::uint32_t f)
 
 bool STObject::clearFlag (std::uint32_t f)
 {
-    STUInt32* t = dynamic_cast<STUInt32*> (getPField (sfFlags));
+    STUInt32* t = fieldCast<STUInt32> (getPField (sfFlags));
 
     if (!t)
         return false;
@@ -447,7 +434,7 @@ bool STObject::isFlag (std::uint32_t f) const
 
 std::uint32_t STObject::getFlags (void) const
 {
-    const STUInt32* t = dynamic_cast<const STUInt32*> (peekAtPField (sfFlags));
+    const STUInt32* t = fieldCast<STUInt32> (peekAtPField (sfFlags));
 
     if (!t)
         return 0;
@@ -688,9 +675,10 @@ Json::Value STObject::getJson (int options) const
         if (elem->getSType () != STI_NOTPRESENT)
         {
             auto const& n = elem->getFName ();
-            auto key = n.hasName () ? std::string(n.getJsonName ()) :
-                    std::to_string (index);
-            ret[key] = elem->getJson (options);
+            if (n.hasName ())
+                ret[n.getJsonKey ()] = elem->getJson (options);
+            else
+                ret[std::to_string (index)] = elem->getJson (options);
         }
     }
     return ret;
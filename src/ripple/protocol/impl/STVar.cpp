@@ -175,10 +175,17 @@ STVar::STVar (SerializedTypeID id, SField const& name)
 void
 STVar::destroy()
 {
-    if (on_heap())
-        delete p_;
-    else
+    if (! on_heap())
+    {
+        p_->~STBase();
+    }
+    else if (p_)
+    {
+        // Heap storage comes from STArena, see STBase::emplace
+        void* const mem = dynamic_cast<void*>(p_);
         p_->~STBase();
+        STArena::deallocate(mem);
+    }
 }
 
 } // detail
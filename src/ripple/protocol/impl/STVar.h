@@ -104,7 +104,7 @@ private:
     construct(Args&&... args)
     {
         if(sizeof(T) > sizeof(d_))
-            p_ = new T(
+            p_ = STArena::make<T>(
                 std::forward<Args>(args)...);
         else
             p_ = new(&d_) T(
@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/protocol/StreamEvent.h>
+#include <ripple/protocol/Serializer.h>
+
+namespace ripple {
+
+std::string
+encodeStreamEvent (StreamEvent::Type type, std::uint16_t flags,
+    std::uint32_t ledgerSeq, std::uint32_t closeTime, std::int32_t result,
+        Slice const& object, Slice const& meta)
+{
+    Serializer s (StreamEvent::headerSize + object.size() + meta.size());
+    s.add8 (StreamEvent::version);
+    s.add8 (type);
+    s.add16 (flags);
+    s.add32 (ledgerSeq);
+    s.add32 (closeTime);
+    s.add32 (static_cast<std::uint32_t> (result));
+    s.add32 (static_cast<std::uint32_t> (object.size()));
+    s.add32 (static_cast<std::uint32_t> (meta.size()));
+    if (object.size() != 0)
+        s.addRaw (object.data(), object.size());
+    if (meta.size() != 0)
+        s.addRaw (meta.data(), meta.size());
+    return s.getString();
+}
+
+boost::optional<StreamEvent>
+decodeStreamEvent (Slice const& message)
+{
+    if (message.size() < StreamEvent::headerSize)
+        return boost::none;
+
+    SerialIter sit (message);
+    if (sit.get8() != StreamEvent::version)
+        return boost::none;
+
+    StreamEvent event;
+    auto const type = sit.get8();
+    if (type != StreamEvent::transaction && type != StreamEvent::ledgerClosed)
+        return boost::none;
+    event.type = static_cast<StreamEvent::Type> (type);
+    event.flags = sit.get16();
+    event.ledgerSeq = sit.get32();
+    event.closeTime = sit.get32();
+    event.result = static_cast<std::int32_t> (sit.get32());
+
+    std::size_t const objectSize = sit.get32();
+    std::size_t const metaSize = sit.get32();
+    if (static_cast<std::size_t> (sit.getBytesLeft()) != objectSize + metaSize)
+        return boost::none;
+
+    auto const object = sit.getSlice (objectSize);
+    event.object.assign (object.data(), object.data() + object.size());
+    auto const meta = sit.getSlice (metaSize);
+    event.meta.assign (meta.data(), meta.data() + meta.size());
+    return event;
+}
+
+} // ripple
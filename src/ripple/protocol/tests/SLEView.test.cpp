@@ -0,0 +1,161 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/protocol/SLEView.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/SecretKey.h>
+#include <ripple/protocol/STArray.h>
+#include <beast/unit_test/suite.h>
+
+namespace ripple {
+
+class SLEView_test : public beast::unit_test::suite
+{
+    static
+    AccountID
+    account (std::string const& name)
+    {
+        return calcAccountID (generateKeyPair (KeyType::secp256k1,
+            generateSeed (name)).first);
+    }
+
+    // Serialize the entry into a buffer owned by the view
+    static
+    SLEView
+    makeView (STLedgerEntry const& sle)
+    {
+        auto s = std::make_shared<Serializer> ();
+        sle.add (*s);
+        return SLEView (s, s->slice (), sle.key ());
+    }
+
+public:
+    void
+    testTrustLine()
+    {
+        testcase ("trust line");
+
+        auto const alice = account ("alice");
+        auto const gw = account ("gateway");
+        Issue const usd (to_currency ("USD"), gw);
+        auto const sle = std::make_shared<SLE> (ltRIPPLE_STATE,
+            getRippleStateIndex (alice, gw, usd.currency));
+        sle->setFieldAmount (sfBalance, STAmount (usd, 125, -1));
+        sle->setFieldAmount (sfLowLimit, STAmount (Issue (usd.currency,
+            alice), 1000));
+        sle->setFieldAmount (sfHighLimit, STAmount (usd, 0));
+        sle->setFieldU32 (sfFlags, lsfLowReserve);
+        sle->setFieldU64 (sfLowNode, 7);
+        sle->setFieldH256 (sfPreviousTxnID, uint256 (42));
+        sle->setFieldU32 (sfPreviousTxnLgrSeq, 9);
+
+        auto const view = makeView (*sle);
+        expect (view.getType () == ltRIPPLE_STATE);
+        expect (view.key () == sle->key ());
+        expect (view.getFieldAmount (sfBalance) ==
+            sle->getFieldAmount (sfBalance));
+        expect (view.getFieldAmount (sfLowLimit) ==
+            sle->getFieldAmount (sfLowLimit));
+        expect (view.getFieldAmount (sfLowLimit).getIssuer () == alice);
+        expect (view.getFieldU32 (sfFlags) == lsfLowReserve);
+        expect (view.getFieldU64 (sfLowNode) == 7);
+        expect (view.getFieldH256 (sfPreviousTxnID) == uint256 (42));
+
+        // Absent optional fields read as defaults
+        expect (! view.isFieldPresent (sfHighNode));
+        expect (view.getFieldU64 (sfHighNode) == 0);
+        expect (view.getFieldU32 (sfLowQualityIn) == 0);
+
+        // Fields outside the format, or read as another type, throw
+        except<std::runtime_error> ([&]
+            { view.getAccountID (sfOwner); });
+        except<std::runtime_error> ([&]
+            { view.getFieldU16 (sfBalance); });
+
+        expect (*view.materialize () == *sle);
+    }
+
+    void
+    testDirectory()
+    {
+        testcase ("directory");
+
+        auto const alice = account ("alice");
+        auto const sle = std::make_shared<SLE> (keylet::ownerDir (alice));
+        sle->setAccountID (sfOwner, alice);
+        sle->setFieldH256 (sfRootIndex, sle->key ());
+        STVector256 indexes;
+        indexes.push_back (uint256 (1));
+        indexes.push_back (uint256 (2));
+        sle->setFieldV256 (sfIndexes, indexes);
+        sle->setFieldU64 (sfIndexNext, 3);
+
+        auto const view = makeView (*sle);
+        expect (view.getType () == ltDIR_NODE);
+        expect (view.getAccountID (sfOwner) == alice);
+        expect (view.getFieldH256 (sfRootIndex) == sle->key ());
+        expect (view.getFieldV256 (sfIndexes).value () == indexes.value ());
+        expect (view.getFieldU64 (sfIndexNext) == 3);
+        expect (view.getFieldH160 (sfTakerPaysCurrency) == zero);
+        expect (*view.materialize () == *sle);
+    }
+
+    void
+    testSignerList()
+    {
+        testcase ("signer list");
+
+        auto const alice = account ("alice");
+        auto const sle = std::make_shared<SLE> (keylet::signers (alice));
+        sle->setFieldU64 (sfOwnerNode, 1);
+        sle->setFieldU32 (sfSignerQuorum, 2);
+        sle->setFieldU32 (sfSignerListID, 0);
+        sle->setFieldH256 (sfPreviousTxnID, uint256 (5));
+        sle->setFieldU32 (sfPreviousTxnLgrSeq, 6);
+        STArray signers;
+        for (auto const& name : {"bob", "carol"})
+        {
+            signers.emplace_back (sfSignerEntry);
+            signers.back ().setAccountID (sfAccount, account (name));
+            signers.back ().setFieldU16 (sfSignerWeight, 1);
+        }
+        sle->setFieldArray (sfSignerEntries, signers);
+
+        // Fields around the array are still located
+        auto const view = makeView (*sle);
+        expect (view.getType () == ltSIGNER_LIST);
+        expect (view.isFieldPresent (sfSignerEntries));
+        expect (view.getFieldU32 (sfSignerQuorum) == 2);
+        expect (view.getFieldU32 (sfPreviousTxnLgrSeq) == 6);
+        expect (*view.materialize () == *sle);
+    }
+
+    void
+    run()
+    {
+        testTrustLine();
+        testDirectory();
+        testSignerList();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SLEView,protocol,ripple);
+
+} // ripple
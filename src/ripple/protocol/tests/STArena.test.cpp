@@ -0,0 +1,175 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/protocol/STArena.h>
+#include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/SecretKey.h>
+#include <beast/unit_test/suite.h>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+
+class STArena_test : public beast::unit_test::suite
+{
+public:
+    // A trust line: its amounts are too large for STVar's inline buffer
+    static
+    std::shared_ptr<SLE>
+    makeLine (std::uint32_t i)
+    {
+        auto const alice = calcAccountID (
+            generateKeyPair (KeyType::secp256k1,
+                generateSeed ("alice")).first);
+        Issue const usd (to_currency ("USD"), alice);
+        auto sle = std::make_shared<SLE> (ltRIPPLE_STATE,
+            getTicketIndex (alice, i));
+        sle->setFieldAmount (sfBalance, STAmount (usd, i));
+        sle->setFieldAmount (sfLowLimit, STAmount (usd, 1000));
+        sle->setFieldAmount (sfHighLimit, STAmount (usd, 2000));
+        sle->setFieldU32 (sfFlags, i);
+        return sle;
+    }
+
+    void
+    testScope()
+    {
+        testcase ("scope");
+
+        auto const line = makeLine (1);
+        auto const blocks = STArena::blocks();
+        expect (! STArena::active());
+
+        std::vector<std::shared_ptr<SLE>> copies;
+        {
+            STArena::Scope outer;
+            {
+                STArena::Scope inner;
+                expect (STArena::active());
+            }
+            expect (STArena::active());
+            for (std::uint32_t i = 0; i < 1000; ++i)
+                copies.push_back (std::make_shared<SLE> (*line));
+            expect (STArena::blocks() > blocks);
+        }
+        expect (! STArena::active());
+
+        // Objects outlive the scope that allocated them
+        for (auto const& sle : copies)
+        {
+            expect (sle->getFieldAmount (sfBalance) ==
+                line->getFieldAmount (sfBalance));
+            expect (sle->getFieldAmount (sfHighLimit) ==
+                line->getFieldAmount (sfHighLimit));
+        }
+
+        // Only the thread's current block survives the copies
+        copies.clear();
+        expect (STArena::blocks() <= blocks + 1);
+    }
+
+    void
+    testThreads()
+    {
+        testcase ("threads");
+
+        auto const line = makeLine (2);
+        auto const blocks = STArena::blocks();
+        std::vector<std::shared_ptr<SLE>> copies;
+        std::thread t ([&]
+            {
+                STArena::Scope scope;
+                for (std::uint32_t i = 0; i < 100; ++i)
+                    copies.push_back (std::make_shared<SLE> (*line));
+            });
+        t.join();
+
+        // The allocating thread is gone, its block is kept alive
+        expect (STArena::blocks() == blocks + 1);
+        for (auto const& sle : copies)
+            expect (sle->getFieldU32 (sfFlags) == 2);
+        copies.clear();
+        expect (STArena::blocks() == blocks);
+    }
+
+    void
+    run()
+    {
+        testScope();
+        testThreads();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(STArena,protocol,ripple);
+
+//------------------------------------------------------------------------------
+
+// Compares copying ledger entries with and without the arena
+class STArena_timing_test : public beast::unit_test::suite
+{
+public:
+    template <class F>
+    std::chrono::microseconds
+    time (F&& f)
+    {
+        using namespace std::chrono;
+        auto const start = steady_clock::now();
+        f();
+        return duration_cast<microseconds> (steady_clock::now() - start);
+    }
+
+    void
+    copyAll (std::vector<std::shared_ptr<SLE>> const& lines)
+    {
+        std::vector<std::shared_ptr<SLE>> copies;
+        copies.reserve (lines.size());
+        for (int pass = 0; pass < 10; ++pass)
+        {
+            for (auto const& sle : lines)
+                copies.push_back (std::make_shared<SLE> (*sle));
+            copies.clear();
+        }
+    }
+
+    void
+    run()
+    {
+        std::vector<std::shared_ptr<SLE>> lines;
+        for (std::uint32_t i = 0; i < 10000; ++i)
+            lines.push_back (STArena_test::makeLine (i));
+
+        auto const heap = time ([&]{ copyAll (lines); });
+        auto const arena = time ([&]
+            {
+                STArena::Scope scope;
+                copyAll (lines);
+            });
+        log << "heap:  " << heap.count() << "us";
+        log << "arena: " << arena.count() << "us";
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(STArena_timing,protocol,ripple);
+
+} // ripple
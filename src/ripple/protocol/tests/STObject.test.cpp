@@ -252,6 +252,16 @@ public:
             expect(!! st[~sf1]);
             expect(!! st[~sf2]);
             expect(!! st[~sf3]);
+
+            // Indexed lookups through the typed getters
+            expect(st.getFieldU32(sf2) == 2);
+            expect(st.getFieldU32(sf3) == 0);
+            expect(! st.isFieldPresent(sf4));
+            expect(st.getFieldVL(sf4).empty());
+            except<std::runtime_error>([&]()
+                { st.getFieldU64(sf1); });
+            except<std::runtime_error>([&]()
+                { st.getFieldU32(sfBalance); });
         }
 
         // write free object
@@ -0,0 +1,100 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/protocol/StreamEvent.h>
+#include <beast/unit_test/suite.h>
+
+namespace ripple {
+
+class StreamEvent_test : public beast::unit_test::suite
+{
+public:
+    void
+    testRoundTrip()
+    {
+        testcase ("round trip");
+
+        Blob const object {1, 2, 3, 4, 5};
+        Blob const meta {6, 7};
+        auto const message = encodeStreamEvent (StreamEvent::transaction,
+            StreamEvent::validated, 12345, 67890, -99,
+                makeSlice (object), makeSlice (meta));
+        expect (message.size() == StreamEvent::headerSize + 7);
+        expect (message[0] == StreamEvent::version);
+
+        auto const event = decodeStreamEvent (makeSlice (message));
+        if (! expect (event))
+            return;
+        expect (event->type == StreamEvent::transaction);
+        expect (event->flags == StreamEvent::validated);
+        expect (event->ledgerSeq == 12345);
+        expect (event->closeTime == 67890);
+        expect (event->result == -99);
+        expect (event->object == object);
+        expect (event->meta == meta);
+
+        // A ledger event carries no metadata
+        auto const ledger = decodeStreamEvent (makeSlice (encodeStreamEvent (
+            StreamEvent::ledgerClosed, 0, 1, 2, 0,
+                makeSlice (object), Slice (nullptr, 0))));
+        if (! expect (ledger))
+            return;
+        expect (ledger->type == StreamEvent::ledgerClosed);
+        expect (ledger->object == object);
+        expect (ledger->meta.empty());
+    }
+
+    void
+    testMalformed()
+    {
+        testcase ("malformed");
+
+        Blob const object {1, 2, 3};
+        auto const message = encodeStreamEvent (StreamEvent::transaction,
+            0, 1, 2, 0, makeSlice (object), Slice (nullptr, 0));
+
+        // Truncated header or payload
+        expect (! decodeStreamEvent (Slice (message.data(), 10)));
+        expect (! decodeStreamEvent (
+            Slice (message.data(), message.size() - 1)));
+
+        // Trailing garbage
+        expect (! decodeStreamEvent (makeSlice (message + "x")));
+
+        // Unknown version and type
+        auto bad = message;
+        bad[0] = 2;
+        expect (! decodeStreamEvent (makeSlice (bad)));
+        bad = message;
+        bad[1] = 9;
+        expect (! decodeStreamEvent (makeSlice (bad)));
+    }
+
+    void
+    run()
+    {
+        testRoundTrip();
+        testMalformed();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(StreamEvent,protocol,ripple);
+
+}
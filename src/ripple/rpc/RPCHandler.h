@@ -21,6 +21,7 @@
 #define RIPPLE_RPC_RPCHANDLER_H_INCLUDED
 
 #include <ripple/core/Config.h>
+#include <ripple/json/Output.h>
 #include <ripple/net/InfoSub.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/Status.h>
@@ -36,6 +37,13 @@ Status doCommand (RPC::Context&, Json::Value&);
 /** Execute an RPC command and store the results in an std::string. */
 void executeRPC (RPC::Context&, std::string&);
 
+/** Execute an RPC command and write the results to an Output.
+
+    Handlers which provide a Json::Object method write their result as it is
+    produced, so the response is never materialized as a Json::Value tree.
+*/
+void executeRPC (RPC::Context&, Json::Output const&);
+
 Role roleRequired (std::string const& method );
 
 } // RPC
@@ -28,6 +28,7 @@
 #include <ripple/protocol/JsonFields.h>
 #include <ripple/resource/Fees.h>
 #include <ripple/rpc/Context.h>
+#include <ripple/rpc/impl/AsyncIO.h>
 #include <ripple/rpc/impl/LookupLedger.h>
 #include <ripple/server/Role.h>
 
@@ -145,9 +146,13 @@ Json::Value doAccountTxOld (RPC::Context& context)
 
         if (bBinary)
         {
-            auto txns = context.netOps.getAccountTxsB (
-                *raAccount, uLedgerMin, uLedgerMax, bDescending, offset, limit,
-                isUnlimited (context.role));
+            NetworkOPs::MetaTxsList txns;
+            RPC::asyncIO (context, "AccountTxOld", [&]
+            {
+                txns = context.netOps.getAccountTxsB (
+                    *raAccount, uLedgerMin, uLedgerMax, bDescending, offset,
+                    limit, isUnlimited (context.role));
+            });
 
             for (auto it = txns.begin (), end = txns.end (); it != end; ++it)
             {
@@ -167,9 +172,13 @@ Json::Value doAccountTxOld (RPC::Context& context)
         }
         else
         {
-            auto txns = context.netOps.getAccountTxs (
-                *raAccount, uLedgerMin, uLedgerMax, bDescending, offset, limit,
-                isUnlimited (context.role));
+            NetworkOPs::AccountTxs txns;
+            RPC::asyncIO (context, "AccountTxOld", [&]
+            {
+                txns = context.netOps.getAccountTxs (
+                    *raAccount, uLedgerMin, uLedgerMax, bDescending, offset,
+                    limit, isUnlimited (context.role));
+            });
 
             for (auto it = txns.begin (), end = txns.end (); it != end; ++it)
             {
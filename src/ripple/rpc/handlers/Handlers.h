@@ -21,6 +21,7 @@
 #define RIPPLE_RPC_HANDLERS_HANDLERS_H_INCLUDED
 
 #include <ripple/rpc/handlers/LedgerHandler.h>
+#include <ripple/rpc/handlers/LedgerDataHandler.h>
 
 namespace ripple {
 
@@ -50,7 +51,6 @@ Json::Value doLedgerAccept          (RPC::Context&);
 Json::Value doLedgerCleaner         (RPC::Context&);
 Json::Value doLedgerClosed          (RPC::Context&);
 Json::Value doLedgerCurrent         (RPC::Context&);
-Json::Value doLedgerData            (RPC::Context&);
 Json::Value doLedgerEntry           (RPC::Context&);
 Json::Value doLedgerHeader          (RPC::Context&);
 Json::Value doLedgerRequest         (RPC::Context&);
@@ -79,6 +79,7 @@ Json::Value doSubscribe             (RPC::Context&);
 Json::Value doTransactionEntry      (RPC::Context&);
 Json::Value doTx                    (RPC::Context&);
 Json::Value doTxHistory             (RPC::Context&);
+Json::Value doTxQueue               (RPC::Context&);
 Json::Value doUnlAdd                (RPC::Context&);
 Json::Value doUnlDelete             (RPC::Context&);
 Json::Value doUnlFetch              (RPC::Context&);
@@ -53,6 +53,11 @@ Json::Value doSubscribe (RPC::Context& context)
         if (context.role != Role::ADMIN)
             return rpcError (rpcNO_PERMISSION);
 
+        // Binary stream events need a websocket to carry the frames.
+        if (context.params.isMember (jss::binary) &&
+                context.params[jss::binary].asBool ())
+            return rpcError (rpcINVALID_PARAMS);
+
         std::string strUrl      = context.params[jss::url].asString ();
         std::string strUsername = context.params.isMember (jss::url_username) ?
                 context.params[jss::url_username].asString () : "";
@@ -101,6 +106,9 @@ Json::Value doSubscribe (RPC::Context& context)
     else
     {
         ispSub  = context.infoSub;
+
+        if (context.params.isMember (jss::binary))
+            ispSub->setBinary (context.params[jss::binary].asBool ());
     }
 
     if (!context.params.isMember (jss::streams))
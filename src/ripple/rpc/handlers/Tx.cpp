@@ -23,10 +23,12 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/app/misc/Transaction.h>
+#include <ripple/app/misc/TxStore.h>
 #include <ripple/net/RPCErr.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/JsonFields.h>
 #include <ripple/rpc/Context.h>
+#include <ripple/rpc/impl/AsyncIO.h>
 #include <ripple/rpc/impl/Utilities.h>
 
 namespace ripple {
@@ -97,8 +99,31 @@ Json::Value doTx (RPC::Context& context)
     if (!isHexTxID (txid))
         return rpcError (rpcNOT_IMPL);
 
-    auto txn = context.app.getMasterTransaction ().fetch (
-        from_hex_text<uint256>(txid), true);
+    auto const id = from_hex_text<uint256>(txid);
+    auto txn = context.app.getMasterTransaction ().fetch (id, false);
+
+    // Go to the transaction database without holding the job thread
+    boost::optional<TxStore::Tx> stored;
+    if (!txn)
+    {
+        RPC::asyncIO (context, "Tx", [&]
+        {
+            txn = context.app.getMasterTransaction ().fetch (id, true);
+
+            // History we no longer keep may be in the external store
+            auto const store = context.app.getTxStore ();
+            if (!txn && store)
+                stored = store->getTx (id);
+        });
+
+        if (stored)
+        {
+            txn = Transaction::transactionFromSQL (
+                std::uint64_t (stored->ledgerSeq),
+                    std::string (1, TXN_SQL_VALIDATED),
+                        stored->rawTxn, context.app);
+        }
+    }
 
     if (!txn)
         return rpcError (rpcTXN_NOT_FOUND);
@@ -141,6 +166,25 @@ Json::Value doTx (RPC::Context& context)
                 context, lgr->info().seq, lgr->getHash ());
     }
 
+    // The store only holds validated ledgers
+    if (stored && !ret.isMember (jss::meta) && !stored->rawMeta.empty ())
+    {
+        if (binary)
+        {
+            ret[jss::meta] = strHex (makeSlice (stored->rawMeta));
+        }
+        else
+        {
+            auto txMeta = std::make_shared<TxMeta> (txn->getID (),
+                stored->ledgerSeq, stored->rawMeta,
+                    context.app.journal ("TxMeta"));
+            auto meta = txMeta->getJson (0);
+            addPaymentDeliveredAmount (meta, context, txn, txMeta);
+            ret[jss::meta] = meta;
+        }
+        ret[jss::validated] = true;
+    }
+
     return ret;
 }
 
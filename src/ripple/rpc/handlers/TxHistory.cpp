@@ -18,8 +18,10 @@
 //==============================================================================
 
 #include <BeastConfig.h>
+#include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/Transaction.h>
+#include <ripple/app/misc/TxStore.h>
 #include <ripple/core/DatabaseCon.h>
 #include <ripple/core/SociDB.h>
 #include <ripple/net/RPCErr.h>
@@ -27,6 +29,7 @@
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/resource/Fees.h>
 #include <ripple/rpc/Context.h>
+#include <ripple/rpc/impl/AsyncIO.h>
 #include <ripple/server/Role.h>
 #include <boost/format.hpp>
 
@@ -35,9 +38,49 @@ namespace ripple {
 // {
 //   start: <index>
 // }
+// Served from the external transaction store, which can scan several
+// ledgers at once. Sorting the whole SQL table is too slow to allow.
+static
+Json::Value
+storeTxHistory (RPC::Context& context, TxStore& store,
+    unsigned int startIndex)
+{
+    // How far back from the last validated ledger we look
+    static LedgerIndex const maxLedgers = 4096;
+
+    auto const validated = context.ledgerMaster.getValidatedLedger ();
+    if (!validated)
+        return rpcError (rpcNO_CURRENT);
+
+    LedgerIndex const last = validated->info ().seq;
+    LedgerIndex const first = last > maxLedgers ? last - maxLedgers + 1 : 1;
+
+    std::vector<TxStore::Tx> found;
+    RPC::asyncIO (context, "TxHistory", [&]
+    {
+        found = store.getTxHistory (first, last, startIndex, 20);
+    });
+
+    Json::Value obj;
+    Json::Value txs (Json::arrayValue);
+
+    obj[jss::index] = startIndex;
+
+    std::string const status (1, TXN_SQL_VALIDATED);
+    for (auto const& tx : found)
+    {
+        if (auto trans = Transaction::transactionFromSQL (
+                std::uint64_t (tx.ledgerSeq), status, tx.rawTxn, context.app))
+            txs.append (trans->getJson (0));
+    }
+
+    obj[jss::txs] = txs;
+
+    return obj;
+}
+
 Json::Value doTxHistory (RPC::Context& context)
 {
-    return rpcError (rpcNOT_SUPPORTED);
     context.loadType = Resource::feeMediumBurdenRPC;
 
     if (!context.params.isMember (jss::start))
@@ -48,6 +91,11 @@ Json::Value doTxHistory (RPC::Context& context)
     if ((startIndex > 10000) &&  (! isUnlimited (context.role)))
         return rpcError (rpcNO_PERMISSION);
 
+    if (auto store = context.app.getTxStore ())
+        return storeTxHistory (context, *store, startIndex);
+
+    return rpcError (rpcNOT_SUPPORTED);
+
     Json::Value obj;
     Json::Value txs;
 
@@ -62,7 +110,7 @@ Json::Value doTxHistory (RPC::Context& context)
     {
         bool isMySQL = context.app.getTxnDB ().getType () == DatabaseCon::Type::MySQL;
         
-        auto db = context.app.getTxnDB ().checkoutDb ();
+        auto db = context.app.getTxnDB ().checkoutReadDb ();
 
         boost::optional<std::uint64_t> ledgerSeq;
         boost::optional<std::string> status;
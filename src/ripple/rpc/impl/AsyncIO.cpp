@@ -0,0 +1,80 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/rpc/impl/AsyncIO.h>
+#include <ripple/app/main/Application.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/rpc/Context.h>
+#include <exception>
+
+namespace ripple {
+namespace RPC {
+
+void
+asyncIO (Context& context, std::string const& name,
+    std::function <void()> const& f)
+{
+    asyncIO (context.app.getJobQueue (), jtCLIENT_DB, context.jobCoro,
+        name, f);
+}
+
+void
+asyncIO (JobQueue& jobQueue, JobType type,
+    std::shared_ptr<JobCoro> const& jobCoro, std::string const& name,
+    std::function <void()> const& f)
+{
+    if (! jobCoro)
+    {
+        f ();
+        return;
+    }
+
+    // f and error live on the suspended coroutine's stack, which is
+    // kept until the job below resumes it.
+    std::exception_ptr error;
+    bool const queued = jobQueue.addJob (type, name,
+        [&f, &error, jobCoro](Job&)
+        {
+            try
+            {
+                f ();
+            }
+            catch (...)
+            {
+                error = std::current_exception ();
+            }
+            jobCoro->post ();
+        });
+
+    // A queue that won't run the job would never resume the coroutine
+    if (! queued)
+    {
+        f ();
+        return;
+    }
+
+    jobCoro->yield ();
+
+    if (error)
+        std::rethrow_exception (error);
+}
+
+} // RPC
+} // ripple
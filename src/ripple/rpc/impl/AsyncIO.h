@@ -0,0 +1,62 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RPC_ASYNCIO_H_INCLUDED
+#define RIPPLE_RPC_ASYNCIO_H_INCLUDED
+
+#include <ripple/core/Job.h>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace ripple {
+
+class JobCoro;
+class JobQueue;
+
+namespace RPC {
+
+struct Context;
+
+/** Run blocking I/O for a command without holding its job thread.
+
+    When the command runs on a coroutine, f is run by a jtCLIENT_DB job
+    and the coroutine is suspended until f returns, releasing the client
+    job thread meanwhile. Without a coroutine, or when the job queue
+    refuses the job, f is called directly.
+
+    Any exception thrown by f is rethrown to the caller.
+*/
+void
+asyncIO (Context& context, std::string const& name,
+    std::function <void()> const& f);
+
+/** Run f on a job of the given type while jobCoro is suspended.
+
+    This is asyncIO without a Context. The coroutine may be null.
+*/
+void
+asyncIO (JobQueue& jobQueue, JobType type,
+    std::shared_ptr<JobCoro> const& jobCoro, std::string const& name,
+    std::function <void()> const& f);
+
+} // RPC
+} // ripple
+
+#endif
@@ -70,6 +70,7 @@ class HandlerTable {
 
         // This is where the new-style handlers are added.
         addHandler<LedgerHandler>();
+        addHandler<LedgerDataHandler>();
         addHandler<VersionHandler>();
     }
 
@@ -125,7 +126,6 @@ Handler handlerArray[] {
     {   "ledger_cleaner",       byRef (&doLedgerCleaner),       Role::ADMIN,   NEEDS_NETWORK_CONNECTION  },
     {   "ledger_closed",        byRef (&doLedgerClosed),        Role::USER,  NO_CONDITION   },
     {   "ledger_current",       byRef (&doLedgerCurrent),       Role::USER,  NEEDS_CURRENT_LEDGER  },
-    {   "ledger_data",          byRef (&doLedgerData),          Role::USER,  NO_CONDITION  },
     {   "ledger_entry",         byRef (&doLedgerEntry),         Role::USER,  NO_CONDITION  },
     {   "ledger_header",        byRef (&doLedgerHeader),        Role::USER,  NO_CONDITION  },
     {   "ledger_request",       byRef (&doLedgerRequest),       Role::ADMIN,   NO_CONDITION     },
@@ -152,6 +152,7 @@ Handler handlerArray[] {
     {   "transaction_entry",    byRef (&doTransactionEntry),    Role::USER,  NO_CONDITION  },
     {   "tx",                   byRef (&doTx),                  Role::USER,  NEEDS_NETWORK_CONNECTION  },
     {   "tx_history",           byRef (&doTxHistory),           Role::USER,    NO_CONDITION     },
+    {   "tx_queue",             byRef (&doTxQueue),             Role::ADMIN,   NO_CONDITION     },
     {   "unl_add",              byRef (&doUnlAdd),              Role::ADMIN,   NO_CONDITION     },
     {   "unl_delete",           byRef (&doUnlDelete),           Role::ADMIN,   NO_CONDITION     },
     {   "unl_list",             byRef (&doUnlList),             Role::ADMIN,   NO_CONDITION     },
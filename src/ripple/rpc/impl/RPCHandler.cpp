@@ -22,6 +22,8 @@
 #include <ripple/rpc/RPCHandler.h>
 #include <ripple/rpc/impl/Tuning.h>
 #include <ripple/rpc/impl/Handler.h>
+#include <ripple/rpc/impl/LookupLedger.h>
+#include <ripple/rpc/impl/ResultCache.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/misc/NetworkOPs.h>
@@ -30,6 +32,7 @@
 #include <ripple/core/Config.h>
 #include <ripple/core/JobQueue.h>
 #include <ripple/json/Object.h>
+#include <ripple/json/Output.h>
 #include <ripple/json/to_string.h>
 #include <ripple/net/InfoSub.h>
 #include <ripple/net/RPCErr.h>
@@ -202,12 +205,95 @@ Status callMethod (
     }
 }
 
+// Old-style handlers report errors in the result rather than the Status.
+bool hasError (Json::Value const& result)
+{
+    return result.isMember (jss::error);
+}
+
+bool hasError (Json::Object const&)
+{
+    return false;
+}
+
+struct CacheKey
+{
+    std::string key;
+    std::string ledgerHash;
+};
+
+// The key of a request about a validated ledger. Requests naming the same
+// ledger by hash, by sequence or as "validated" share an entry.
+boost::optional<CacheKey> makeCacheKey (
+    Context& context, std::string const& name)
+{
+    if (! context.app.getRPCResultCache ().enabled () ||
+        ! isCacheable (name, context.params))
+        return boost::none;
+
+    std::shared_ptr<ReadView const> ledger;
+    try
+    {
+        Json::Value lookup;
+        if (lookupLedger (ledger, context, lookup) ||
+            ! lookup[jss::validated].asBool ())
+            return boost::none;
+    }
+    catch (std::exception const&)
+    {
+        // The command reports the bad request itself
+        return boost::none;
+    }
+
+    CacheKey result;
+    result.ledgerHash = to_string (ledger->info ().hash);
+    result.key = RPC::makeCacheKey (
+        name, context.params, context.role, result.ledgerHash);
+    return result;
+}
+
+template <class Method>
+Status callCachedMethod (
+    Context& context, Method method, std::string const& name,
+        Json::Object& result)
+{
+    return callMethod (context, method, name, result);
+}
+
+template <class Method>
+Status callCachedMethod (
+    Context& context, Method method, std::string const& name,
+        Json::Value& result)
+{
+    auto const key = makeCacheKey (context, name);
+    if (! key)
+        return callMethod (context, method, name, result);
+
+    auto& cache = context.app.getRPCResultCache ();
+    if (cache.fetch (key->key, result))
+        return Status::OK;
+
+    auto const status = callMethod (context, method, name, result);
+
+    // A "validated" request can race with a new validated ledger.
+    // Read the result without adding members to it.
+    Json::Value const& reply = result;
+    if (! status && ! hasError (reply) &&
+        reply[jss::validated].asBool () &&
+        reply[jss::ledger_hash].asString () == key->ledgerHash)
+    {
+        cache.insert (key->key, result);
+    }
+    return status;
+}
+
 template <class Method, class Object>
 void getResult (
     Context& context, Method method, Object& object, std::string const& name)
 {
     auto&& result = Json::addObject (object, jss::result);
-    if (auto status = callMethod (context, method, name, result))
+    auto status = callCachedMethod (context, method, name, result);
+    if (status || hasError (result))
     {
         JLOG (context.j.debug) << "rpcError: " << status.toString();
         result[jss::status] = jss::error;
@@ -219,6 +305,21 @@ void getResult (
     }
 }
 
+// Commands relayed for someone else are logged with who it was for.
+bool isRelayed (Context& context)
+{
+    return ! context.headers.user.empty() ||
+        ! context.headers.forwardedFor.empty();
+}
+
+void logCommand (
+    Context& context, char const* event, std::string const& name)
+{
+    context.j.debug << event << " command: " << name <<
+        ", X-User: " << context.headers.user << ", X-Forwarded-For: " <<
+            context.headers.forwardedFor;
+}
+
 } // namespace
 
 Status doCommand (
@@ -233,24 +334,20 @@ Status doCommand (
 
     if (auto method = handler->valueMethod_)
     {
-        if (! context.headers.user.empty() ||
-            ! context.headers.forwardedFor.empty())
+        if (isRelayed (context))
         {
-            context.j.debug << "start command: " << handler->name_ <<
-                ", X-User: " << context.headers.user << ", X-Forwarded-For: " <<
-                    context.headers.forwardedFor;
+            logCommand (context, "start", handler->name_);
 
-            auto ret = callMethod (context, method, handler->name_, result);
+            auto ret = callCachedMethod (
+                context, method, handler->name_, result);
 
-            context.j.debug << "finish command: " << handler->name_ <<
-                ", X-User: " << context.headers.user << ", X-Forwarded-For: " <<
-                    context.headers.forwardedFor;
+            logCommand (context, "finish", handler->name_);
 
             return ret;
         }
         else
         {
-            return callMethod (context, method, handler->name_, result);
+            return callCachedMethod (context, method, handler->name_, result);
         }
     }
 
@@ -260,30 +357,49 @@ Status doCommand (
 /** Execute an RPC command and store the results in a string. */
 void executeRPC (
     RPC::Context& context, std::string& output)
+{
+    executeRPC (context, Json::stringOutput (output));
+}
+
+void executeRPC (
+    RPC::Context& context, Json::Output const& output)
 {
     boost::optional <Handler const&> handler;
     if (auto error = fillHandler (context, handler))
     {
-        auto wo = Json::stringWriterObject (output);
+        Json::WriterObject wo (output);
         auto&& sub = Json::addObject (*wo, jss::result);
         inject_error (error, sub);
-    }
-    else if (auto method = handler->objectMethod_)
-    {
-        auto wo = Json::stringWriterObject (output);
-        getResult (context, method, *wo, handler->name_);
-    }
-    else if (auto method = handler->valueMethod_)
-    {
-        auto object = Json::Value (Json::objectValue);
-        getResult (context, method, object, handler->name_);
-        output = to_string (object);
+        sub[jss::status] = jss::error;
+        sub[jss::request] = context.params;
     }
     else
     {
-        // Can't ever get here.
-        assert (false);
-        Throw<std::logic_error> ("RPC handler with no method");
+        bool const logged = isRelayed (context);
+        if (logged)
+            logCommand (context, "start", handler->name_);
+
+        if (handler->objectMethod_ &&
+            ! isCacheable (handler->name_, context.params))
+        {
+            Json::WriterObject wo (output);
+            getResult (context, handler->objectMethod_, *wo, handler->name_);
+        }
+        else if (auto method = handler->valueMethod_)
+        {
+            auto object = Json::Value (Json::objectValue);
+            getResult (context, method, object, handler->name_);
+            Json::outputJson (object, output);
+        }
+        else
+        {
+            // Can't ever get here.
+            assert (false);
+            Throw<std::logic_error> ("RPC handler with no method");
+        }
+
+        if (logged)
+            logCommand (context, "finish", handler->name_);
     }
 }
 
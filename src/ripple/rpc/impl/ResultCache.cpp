@@ -0,0 +1,187 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/rpc/impl/ResultCache.h>
+#include <ripple/core/Config.h>
+#include <ripple/core/ConfigSections.h>
+#include <ripple/json/to_string.h>
+#include <ripple/protocol/JsonFields.h>
+#include <set>
+
+namespace ripple {
+namespace RPC {
+
+ResultCache::ResultCache (Setup const& setup)
+    : setup_ (setup)
+{
+}
+
+bool
+ResultCache::fetch (std::string const& key, Json::Value& result)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto const iter = index_.find (key);
+    if (iter == index_.end ())
+    {
+        ++misses_;
+        return false;
+    }
+
+    ++hits_;
+    entries_.splice (entries_.begin (), entries_, iter->second);
+    result = iter->second->result;
+    return true;
+}
+
+void
+ResultCache::insert (std::string const& key, Json::Value const& result)
+{
+    // Roughly what the entry costs: the key and the serialized result
+    auto const bytes = key.size () + to_string (result).size ();
+    if (! enabled () || bytes > setup_.maxBytes)
+        return;
+
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto const iter = index_.find (key);
+    if (iter != index_.end ())
+    {
+        // Another client computed it meanwhile
+        entries_.splice (entries_.begin (), entries_, iter->second);
+        return;
+    }
+
+    entries_.push_front (Entry {key, result, bytes});
+    index_.emplace (key, entries_.begin ());
+    bytes_ += bytes;
+    evict ();
+}
+
+void
+ResultCache::evict ()
+{
+    while (entries_.size () > setup_.maxEntries || bytes_ > setup_.maxBytes)
+    {
+        auto const& entry = entries_.back ();
+        bytes_ -= entry.bytes;
+        index_.erase (entry.key);
+        entries_.pop_back ();
+    }
+}
+
+std::size_t
+ResultCache::size () const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    return entries_.size ();
+}
+
+std::size_t
+ResultCache::bytes () const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    return bytes_;
+}
+
+Json::Value
+ResultCache::getJson () const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    Json::Value ret (Json::objectValue);
+    ret[jss::entries] = static_cast<Json::UInt> (entries_.size ());
+    ret[jss::bytes] = static_cast<Json::UInt> (bytes_);
+    ret[jss::hits] = static_cast<Json::UInt> (hits_);
+    ret[jss::misses] = static_cast<Json::UInt> (misses_);
+    auto const total = hits_ + misses_;
+    ret[jss::hit_rate] = total == 0 ? 0.0 :
+        static_cast<double> (hits_) / total;
+    return ret;
+}
+
+ResultCache::Setup
+setup_ResultCache (Config const& config)
+{
+    ResultCache::Setup setup;
+    auto const& section = config.section (SECTION_RPC_CACHE);
+    setup.maxEntries = get<std::size_t> (section, "size", setup.maxEntries);
+    setup.maxBytes = get<std::size_t> (section, "cache_mb",
+        setup.maxBytes / (1024 * 1024)) * 1024 * 1024;
+    return setup;
+}
+
+bool
+isCacheable (std::string const& name, Json::Value const& params)
+{
+    static std::set<std::string> const methods {
+        "account_info",
+        "account_lines",
+        "account_offers",
+        "book_offers",
+        "gateway_balances",
+        "ledger",
+        "ledger_entry",
+        "ledger_header",
+    };
+
+    if (methods.find (name) == methods.end ())
+        return false;
+
+    // Only the header of a ledger, the rest is too large to keep
+    if (name == "ledger")
+    {
+        for (auto field : {jss::full, jss::transactions, jss::accounts,
+            jss::expand})
+        {
+            if (params[field].asBool ())
+                return false;
+        }
+        if (params["dividend"].asBool () || params["activate"].asBool ())
+            return false;
+    }
+
+    // Without a ledger in the request, the open ledger is used
+    if (! params.isMember (jss::ledger) &&
+        ! params.isMember (jss::ledger_hash) &&
+        ! params.isMember (jss::ledger_index))
+        return false;
+
+    for (auto field : {jss::ledger, jss::ledger_index})
+    {
+        auto const& index = params[field];
+        if (index.isString () &&
+            (index.asString () == "current" || index.asString () == "closed"))
+            return false;
+    }
+    return true;
+}
+
+std::string
+makeCacheKey (std::string const& name, Json::Value params,
+    Role role, std::string const& ledgerHash)
+{
+    for (auto field : {jss::command, jss::id, jss::ledger,
+        jss::ledger_hash, jss::ledger_index})
+        params.removeMember (field);
+
+    return name + (isUnlimited (role) ? " u " : " g ") +
+        ledgerHash + " " + to_string (params);
+}
+
+} // RPC
+} // ripple
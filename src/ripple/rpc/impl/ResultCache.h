@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RPC_RESULTCACHE_H_INCLUDED
+#define RIPPLE_RPC_RESULTCACHE_H_INCLUDED
+
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/json/json_value.h>
+#include <ripple/server/Role.h>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+
+namespace ripple {
+
+class Config;
+
+namespace RPC {
+
+/** Results of read-only commands about validated ledgers.
+
+    A validated ledger never changes, so a result computed for one can be
+    returned to every client asking the same question about it. Entries
+    are evicted least recently used first, once either the entry or the
+    byte budget is exceeded. The cache is thread safe.
+*/
+class ResultCache
+{
+public:
+    struct Setup
+    {
+        // Zero disables the cache
+        std::size_t maxEntries = 4096;
+        std::size_t maxBytes = 64 * 1024 * 1024;
+    };
+
+    explicit
+    ResultCache (Setup const& setup);
+
+    ResultCache (ResultCache const&) = delete;
+    ResultCache& operator= (ResultCache const&) = delete;
+
+    bool
+    enabled () const
+    {
+        return setup_.maxEntries != 0 && setup_.maxBytes != 0;
+    }
+
+    /** Copy a cached result, returns false on a miss. */
+    bool
+    fetch (std::string const& key, Json::Value& result);
+
+    /** Remember the result of a command.
+        Results larger than the byte budget are not kept.
+    */
+    void
+    insert (std::string const& key, Json::Value const& result);
+
+    std::size_t
+    size () const;
+
+    std::size_t
+    bytes () const;
+
+    /** Sizes and hit counters for get_counts. */
+    Json::Value
+    getJson () const;
+
+private:
+    struct Entry
+    {
+        std::string key;
+        Json::Value result;
+        std::size_t bytes;
+    };
+
+    using list_type = std::list<Entry>;
+
+    void
+    evict ();
+
+    Setup const setup_;
+    std::mutex mutable mutex_;
+    list_type entries_;   // most recently used first
+    hash_map<std::string, list_type::iterator> index_;
+    std::size_t bytes_ = 0;
+    std::uint64_t hits_ = 0;
+    std::uint64_t misses_ = 0;
+};
+
+ResultCache::Setup
+setup_ResultCache (Config const& config);
+
+/** Returns true if the result of a command may be cached.
+    The command must be read-only, with a result that depends only on the
+    request and the ledger it names, which can't be the open or the last
+    closed ledger.
+*/
+bool
+isCacheable (std::string const& name, Json::Value const& params);
+
+/** The cache key of a request about a validated ledger.
+    Requests naming the same ledger by hash, by sequence or as "validated"
+    share a key. Page sizes depend on the role, so roles don't.
+*/
+std::string
+makeCacheKey (std::string const& name, Json::Value params,
+    Role role, std::string const& ledgerHash);
+
+} // RPC
+} // ripple
+
+#endif
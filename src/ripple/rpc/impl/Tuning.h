@@ -54,6 +54,10 @@ static int const maxJobQueueClients = 500;
 static int const maxValidatedLedgerAge = 120;
 static int const maxRequestSize = 1000000;
 
+/** Unsent bytes of an HTTP reply above which the command waits for the
+    client to read more. */
+static std::size_t const maxQueuedReply = 1024 * 1024;
+
 /** Maximum number of pages in one response from a binary LedgerData request. */
 static int const binaryPageLength = 2048;
 
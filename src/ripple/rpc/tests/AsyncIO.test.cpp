@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+#include <BeastConfig.h>
+#include <ripple/rpc/impl/AsyncIO.h>
+#include <ripple/basics/contract.h>
+#include <ripple/basics/Log.h>
+#include <ripple/core/JobCoro.h>
+#include <ripple/core/JobQueue.h>
+#include <beast/insight/NullCollector.h>
+#include <beast/threads/Stoppable.h>
+#include <beast/unit_test/suite.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace ripple {
+namespace RPC {
+
+class AsyncIO_test : public beast::unit_test::suite
+{
+    // A job queue with a single thread, so a coroutine that doesn't
+    // release it keeps every other job from running.
+    struct TestQueue
+    {
+        Logs logs;
+        beast::RootStoppable root {"AsyncIO_test"};
+        JobQueue jq {beast::insight::NullCollector::New (), root,
+            beast::Journal (), logs};
+
+        TestQueue ()
+        {
+            jq.setThreadCount (1, true);
+            root.prepare ();
+            root.start ();
+        }
+
+        ~TestQueue ()
+        {
+            root.stop ();
+        }
+    };
+
+    // Wait for a coroutine to finish
+    bool
+    wait (std::atomic<bool> const& done)
+    {
+        using namespace std::chrono_literals;
+        auto const start = std::chrono::steady_clock::now ();
+        while (! done && std::chrono::steady_clock::now () - start < 1s)
+            std::this_thread::sleep_for (1ms);
+        return done;
+    }
+
+public:
+    void
+    testSuspend ()
+    {
+        testcase ("suspend");
+
+        TestQueue q;
+        std::atomic<bool> ran {false};
+        std::atomic<bool> suspended {false};
+        std::atomic<bool> done {false};
+        q.jq.postCoro (jtCLIENT, "AsyncIO-Test",
+            [&](std::shared_ptr<JobCoro> jc)
+            {
+                asyncIO (q.jq, jtCLIENT_DB, jc, "AsyncIO-Test",
+                    [&]()
+                    {
+                        // The coroutine gave up the only thread
+                        ran = true;
+                        suspended =
+                            q.jq.getJobCountTotal (jtCLIENT) == 0 &&
+                            q.jq.getJobCountTotal (jtCLIENT_DB) == 1;
+                    });
+                done = ran.load ();
+            });
+
+        expect (wait (done));
+        expect (ran.load ());
+        expect (suspended.load ());
+    }
+
+    void
+    testException ()
+    {
+        testcase ("exception");
+
+        TestQueue q;
+        std::atomic<bool> inJob {false};
+        std::atomic<bool> caught {false};
+        std::atomic<bool> done {false};
+        q.jq.postCoro (jtCLIENT, "AsyncIO-Test",
+            [&](std::shared_ptr<JobCoro> jc)
+            {
+                try
+                {
+                    asyncIO (q.jq, jtCLIENT_DB, jc, "AsyncIO-Test",
+                        [&]()
+                        {
+                            inJob =
+                                q.jq.getJobCountTotal (jtCLIENT_DB) == 1;
+                            Throw<std::runtime_error> ("AsyncIO-Test");
+                        });
+                }
+                catch (std::runtime_error const& e)
+                {
+                    caught = std::string (e.what ()) == "AsyncIO-Test";
+                }
+                done = true;
+            });
+
+        expect (wait (done));
+        expect (inJob.load ());
+        expect (caught.load ());
+    }
+
+    void
+    testRefused ()
+    {
+        testcase ("refused");
+
+        using namespace std::chrono_literals;
+        std::atomic<bool> started {false};
+        std::atomic<bool> ran {false};
+        std::atomic<bool> inCoro {false};
+        std::atomic<bool> done {false};
+        {
+            TestQueue q;
+            q.jq.postCoro (jtCLIENT, "AsyncIO-Test",
+                [&](std::shared_ptr<JobCoro> jc)
+                {
+                    started = true;
+
+                    // A stopping queue refuses jobs that are skipped
+                    // on stop, so f is called by the coroutine.
+                    auto const start = std::chrono::steady_clock::now ();
+                    while (! q.jq.isStopping () &&
+                            std::chrono::steady_clock::now () - start < 1s)
+                        std::this_thread::sleep_for (1ms);
+                    auto const id = std::this_thread::get_id ();
+                    asyncIO (q.jq, jtPROPOSAL_ut, jc, "AsyncIO-Test",
+                        [&]()
+                        {
+                            ran = true;
+                            inCoro = std::this_thread::get_id () == id &&
+                                q.jq.getJobCountTotal (jtPROPOSAL_ut) == 0;
+                        });
+                    done = true;
+                });
+
+            // Stopping waits for the coroutine to return
+            expect (wait (started));
+        }
+        expect (done.load ());
+        expect (ran.load ());
+        expect (inCoro.load ());
+    }
+
+    void
+    run ()
+    {
+        testSuspend ();
+        testException ();
+        testRefused ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(AsyncIO,rpc,ripple);
+
+} // RPC
+} // ripple
@@ -0,0 +1,220 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/rpc/impl/ResultCache.h>
+#include <ripple/json/to_string.h>
+#include <ripple/protocol/JsonFields.h>
+#include <beast/unit_test/suite.h>
+
+namespace ripple {
+namespace RPC {
+
+class ResultCache_test : public beast::unit_test::suite
+{
+    static
+    Json::Value
+    makeResult (int i)
+    {
+        Json::Value result (Json::objectValue);
+        result[jss::ledger_index] = i;
+        result[jss::validated] = true;
+        return result;
+    }
+
+public:
+    void testFetch ()
+    {
+        testcase ("fetch");
+
+        ResultCache cache (ResultCache::Setup {});
+        expect (cache.enabled ());
+
+        Json::Value result;
+        expect (! cache.fetch ("a", result));
+        cache.insert ("a", makeResult (1));
+        expect (cache.fetch ("a", result));
+        expect (result == makeResult (1));
+        expect (cache.size () == 1);
+
+        // Inserting again keeps the first result
+        cache.insert ("a", makeResult (2));
+        expect (cache.fetch ("a", result));
+        expect (result[jss::ledger_index].asInt () == 1);
+        expect (cache.size () == 1);
+
+        auto const j = cache.getJson ();
+        expect (j[jss::hits].asUInt () == 2);
+        expect (j[jss::misses].asUInt () == 1);
+        expect (j[jss::entries].asUInt () == 1);
+        expect (j[jss::hit_rate].asDouble () > 0.6);
+    }
+
+    void testBudgets ()
+    {
+        testcase ("budgets");
+
+        // The least recently used entry goes first
+        {
+            ResultCache::Setup setup;
+            setup.maxEntries = 2;
+            ResultCache cache (setup);
+            cache.insert ("a", makeResult (1));
+            cache.insert ("b", makeResult (2));
+            Json::Value result;
+            expect (cache.fetch ("a", result));
+            cache.insert ("c", makeResult (3));
+            expect (cache.size () == 2);
+            expect (cache.fetch ("a", result));
+            expect (! cache.fetch ("b", result));
+            expect (cache.fetch ("c", result));
+        }
+
+        // Bytes are released as entries are evicted
+        {
+            auto const entry = 1 + to_string (makeResult (1)).size ();
+            ResultCache::Setup setup;
+            setup.maxBytes = 2 * entry;
+            ResultCache cache (setup);
+            cache.insert ("a", makeResult (1));
+            cache.insert ("b", makeResult (2));
+            expect (cache.bytes () == 2 * entry);
+            cache.insert ("c", makeResult (3));
+            expect (cache.size () == 2);
+            expect (cache.bytes () == 2 * entry);
+
+            // Too large to ever fit
+            Json::Value big (Json::objectValue);
+            big[jss::data] = std::string (2 * entry, 'x');
+            cache.insert ("d", big);
+            Json::Value result;
+            expect (! cache.fetch ("d", result));
+            expect (cache.size () == 2);
+        }
+
+        // Disabled
+        {
+            ResultCache::Setup setup;
+            setup.maxEntries = 0;
+            ResultCache cache (setup);
+            expect (! cache.enabled ());
+            cache.insert ("a", makeResult (1));
+            expect (cache.size () == 0);
+        }
+    }
+
+    void testCacheable ()
+    {
+        testcase ("cacheable");
+
+        auto request = [](char const* field, Json::Value const& value)
+        {
+            Json::Value params (Json::objectValue);
+            params[field] = value;
+            return params;
+        };
+
+        auto const hash = std::string (64, 'A');
+        expect (isCacheable ("account_info", request ("ledger_hash", hash)));
+        expect (isCacheable ("account_info", request ("ledger_index", 5)));
+        expect (isCacheable ("account_info",
+            request ("ledger_index", "validated")));
+        expect (isCacheable ("account_info", request ("ledger", hash)));
+
+        // The open and the last closed ledger change
+        expect (! isCacheable ("account_info", Json::objectValue));
+        expect (! isCacheable ("account_info",
+            request ("ledger_index", "current")));
+        expect (! isCacheable ("account_info",
+            request ("ledger_index", "closed")));
+        expect (! isCacheable ("account_info", request ("ledger", "closed")));
+
+        // Only read-only commands
+        expect (! isCacheable ("submit", request ("ledger_index", 5)));
+        expect (! isCacheable ("account_tx", request ("ledger_index", 5)));
+
+        // Only the header of a ledger
+        auto ledger = request ("ledger_index", 5);
+        expect (isCacheable ("ledger", ledger));
+        for (auto field : {"full", "transactions", "accounts", "expand"})
+        {
+            auto params = ledger;
+            params[field] = true;
+            expect (! isCacheable ("ledger", params), field);
+            params[field] = false;
+            expect (isCacheable ("ledger", params), field);
+        }
+    }
+
+    void testKey ()
+    {
+        testcase ("key");
+
+        auto const hash = std::string (64, 'A');
+        Json::Value request (Json::objectValue);
+        request[jss::command] = "account_info";
+        request[jss::account] = "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh";
+        auto const key = makeCacheKey (
+            "account_info", request, Role::GUEST, hash);
+
+        // The ledger can be named by hash, by index or as "validated"
+        for (auto field : {"ledger_hash", "ledger_index", "ledger"})
+        {
+            for (auto const& value : {Json::Value (hash),
+                Json::Value (5), Json::Value ("validated")})
+            {
+                auto params = request;
+                params[field] = value;
+                params[jss::id] = 7;
+                expect (makeCacheKey ("account_info", params,
+                    Role::GUEST, hash) == key, field);
+            }
+        }
+
+        // Another ledger, command, request or role
+        expect (makeCacheKey ("account_info", request, Role::GUEST,
+            std::string (64, 'B')) != key);
+        expect (makeCacheKey ("account_lines", request, Role::GUEST,
+            hash) != key);
+        auto strict = request;
+        strict[jss::strict] = true;
+        expect (makeCacheKey ("account_info", strict, Role::GUEST,
+            hash) != key);
+        expect (makeCacheKey ("account_info", request, Role::ADMIN,
+            hash) != key);
+        expect (makeCacheKey ("account_info", request, Role::IDENTIFIED,
+            hash) == makeCacheKey ("account_info", request, Role::ADMIN,
+                hash));
+        expect (makeCacheKey ("account_info", request, Role::USER,
+            hash) == key);
+    }
+
+    void run ()
+    {
+        testFetch ();
+        testBudgets ();
+        testCacheable ();
+        testKey ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ResultCache,rpc,ripple);
+
+} // RPC
+} // ripple
@@ -122,6 +122,17 @@ public:
 
     /** @} */
 
+    /** Wait for the data written to be sent.
+        If more than `bytes` of the data passed to write remain to be
+        sent, the handler is called from the sending thread once no more
+        than that remain, or when sending fails.
+        @return `false` if the handler will not be called because
+                there is nothing to wait for.
+    */
+    virtual
+    bool
+    wait_write (std::size_t bytes, std::function <void(void)> handler) = 0;
+
     /** Detach the session.
         This holds the session open so that the response can be sent
         asynchronously. Calls to io_service::run made by the server
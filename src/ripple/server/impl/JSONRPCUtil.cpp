@@ -24,7 +24,9 @@
 #include <ripple/protocol/BuildInfo.h>
 #include <ripple/protocol/SystemParameters.h>
 #include <ripple/json/to_string.h>
+#include <ripple/rpc/impl/Tuning.h>
 #include <boost/algorithm/string.hpp>
+#include <cstdio>
 
 namespace ripple {
 
@@ -115,4 +117,82 @@ void HTTPReply (
     output ("\r\n");
 }
 
+std::size_t HTTPChunkedReply (
+    std::function <void (Json::Output const&)> const& body,
+    Json::Output const& output, beast::Journal j)
+{
+    // Content is collected into chunks of about this size.
+    static std::size_t const chunkSize = 64 * 1024;
+
+    output ("HTTP/1.1 200 OK\r\n");
+    output (getHTTPHeaderTimestamp ());
+    output ("Connection: Keep-Alive\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "Content-Type: application/json; charset=UTF-8\r\n");
+    output ("Server: " + systemName () + "-json-rpc/");
+    output (BuildInfo::getFullVersionString ());
+    output ("\r\n"
+            "\r\n");
+
+    std::size_t size = 0;
+    std::string chunk;
+    chunk.reserve (chunkSize);
+
+    auto flush = [&]()
+    {
+        if (chunk.empty ())
+            return;
+        char header[24];
+        std::snprintf (header, sizeof (header), "%zx\r\n", chunk.size ());
+        output (header);
+        output (chunk);
+        output ("\r\n");
+        size += chunk.size ();
+        chunk.clear ();
+    };
+
+    body ([&](boost::string_ref const& b)
+    {
+        chunk.append (b.data (), b.size ());
+        if (chunk.size () >= chunkSize)
+            flush ();
+    });
+
+    // Terminate the content the same way HTTPReply does.
+    auto const content = size + chunk.size ();
+    chunk += "\r\n";
+    flush ();
+    output ("0\r\n"
+            "\r\n");
+
+    JLOG (j.trace)
+        << "HTTP Reply 200 chunked, " << content << " bytes";
+    return content;
+}
+
+bool canChunkHTTPReply (beast::http::message const& request)
+{
+    return request.version () >= std::make_pair (1, 1);
+}
+
+Json::Output makeOutput (HTTP::Session& session)
+{
+    return [&](boost::string_ref const& b)
+    {
+        session.write (b.data(), b.size());
+    };
+}
+
+Json::Output makeOutput (HTTP::Session& session,
+    std::shared_ptr<JobCoro> const& jobCoro)
+{
+    return [&session, jobCoro](boost::string_ref const& b)
+    {
+        session.write (b.data(), b.size());
+        if (session.wait_write (RPC::Tuning::maxQueuedReply,
+                [jobCoro]() { jobCoro->post(); }))
+            jobCoro->yield();
+    };
+}
+
 } // ripple
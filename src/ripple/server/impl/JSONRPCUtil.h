@@ -20,14 +20,50 @@
 #ifndef RIPPLE_SERVER_JSONRPCUTIL_H_INCLUDED
 #define RIPPLE_SERVER_JSONRPCUTIL_H_INCLUDED
 
+#include <ripple/core/JobCoro.h>
 #include <ripple/json/json_value.h>
 #include <ripple/json/Output.h>
+#include <ripple/server/Port.h>
+#include <ripple/server/Session.h>
+#include <beast/http/message.h>
+#include <functional>
 
 namespace ripple {
 
 void HTTPReply (
     int nStatus, std::string const& strMsg, Json::Output const&, beast::Journal j);
 
+/** Write a 200 reply whose body is produced incrementally.
+
+    The body function is called with an Output to write the content to. The
+    content is sent with chunked transfer encoding as it is produced, so it is
+    never held in memory in full.
+
+    @return The number of content bytes written.
+*/
+std::size_t HTTPChunkedReply (
+    std::function <void (Json::Output const&)> const& body,
+    Json::Output const&, beast::Journal j);
+
+/** Returns `true` if the reply to a request can be chunked.
+
+    HTTP/1.0 clients don't understand chunked transfer encoding, so
+    their replies are sent whole with a Content-Length.
+*/
+bool canChunkHTTPReply (beast::http::message const& request);
+
+/** Make an Output that writes to a session. */
+Json::Output makeOutput (HTTP::Session& session);
+
+/** Make an Output that writes a reply to a session from a coroutine.
+
+    A reply that a slow client isn't reading suspends the coroutine while
+    more than RPC::Tuning::maxQueuedReply bytes of it wait to be sent,
+    instead of piling up in the session's write queue.
+*/
+Json::Output makeOutput (HTTP::Session& session,
+    std::shared_ptr<JobCoro> const& jobCoro);
+
 } // ripple
 
 #endif
@@ -98,6 +98,10 @@ protected:
     beast::http::message message_;
     beast::http::body body_;
     std::list <buffer> write_queue_;
+    std::size_t write_queued_ = 0;
+    std::size_t wait_bytes_ = 0;
+    std::function <void(void)> wait_handler_;
+    bool write_failed_ = false;
     std::mutex mutex_;
     bool graceful_ = false;
     bool complete_ = false;
@@ -216,6 +220,10 @@ protected:
     write (std::shared_ptr <Writer> const& writer,
         bool keep_alive) override;
 
+    bool
+    wait_write (std::size_t bytes,
+        std::function <void(void)> handler) override;
+
     std::shared_ptr<Session>
     detach() override;
 
@@ -296,6 +304,16 @@ Peer<Impl>::fail (error_code ec, char const* what)
             std::string(what) << ": " << ec.message();
         impl().stream_.lowest_layer().close (ec);
     }
+
+    // Nothing more will be sent, so don't leave a writer waiting
+    std::function <void(void)> handler;
+    {
+        std::lock_guard <std::mutex> lock (mutex_);
+        write_failed_ = true;
+        handler.swap (wait_handler_);
+    }
+    if (handler)
+        handler();
 }
 
 template <class Impl>
@@ -422,20 +440,25 @@ Peer<Impl>::do_write (yield_context yield)
     for(;;)
     {
         bytes_out_ += bytes;
-        void const* data;
+        void const* data = nullptr;
+        std::function <void(void)> handler;
         {
             std::lock_guard <std::mutex> lock (mutex_);
             assert(! write_queue_.empty());
             buffer& b1 = write_queue_.front();
             b1.used += bytes;
+            write_queued_ -= bytes;
+            if (wait_handler_ && write_queued_ <= wait_bytes_)
+                handler.swap (wait_handler_);
             if (b1.used >= b1.bytes)
             {
                 write_queue_.pop_front();
-                if (write_queue_.empty())
-                    break;
-                buffer& b2 = write_queue_.front();
-                data = b2.data.get();
-                bytes = b2.bytes;
+                if (! write_queue_.empty())
+                {
+                    buffer& b2 = write_queue_.front();
+                    data = b2.data.get();
+                    bytes = b2.bytes;
+                }
             }
             else
             {
@@ -444,6 +467,11 @@ Peer<Impl>::do_write (yield_context yield)
             }
         }
 
+        if (handler)
+            handler();
+        if (! data)
+            break;
+
         start_timer();
         bytes = boost::asio::async_write (impl().stream_,
             boost::asio::buffer (data, bytes),
@@ -515,8 +543,12 @@ Peer<Impl>::write (void const* buffer, std::size_t bytes)
     bool empty;
     {
         std::lock_guard <std::mutex> lock (mutex_);
+        // Nothing queued now would ever be sent
+        if (write_failed_)
+            return;
         empty = write_queue_.empty();
         write_queue_.emplace_back (buffer, bytes);
+        write_queued_ += bytes;
     }
 
     if (empty)
@@ -524,6 +556,19 @@ Peer<Impl>::write (void const* buffer, std::size_t bytes)
             impl().shared_from_this(), std::placeholders::_1));
 }
 
+template <class Impl>
+bool
+Peer<Impl>::wait_write (std::size_t bytes,
+    std::function <void(void)> handler)
+{
+    std::lock_guard <std::mutex> lock (mutex_);
+    if (write_failed_ || write_queued_ <= bytes)
+        return false;
+    wait_bytes_ = bytes;
+    wait_handler_ = std::move (handler);
+    return true;
+}
+
 template <class Impl>
 void
 Peer<Impl>::write (std::shared_ptr <Writer> const& writer,
@@ -148,15 +148,6 @@ ServerHandlerImp::onHandoff (HTTP::Session& session,
     return Handoff{};
 }
 
-static inline
-Json::Output makeOutput (HTTP::Session& session)
-{
-    return [&](boost::string_ref const& b)
-    {
-        session.write (b.data(), b.size());
-    };
-}
-
 void
 ServerHandlerImp::onRequest (HTTP::Session& session)
 {
@@ -213,8 +204,10 @@ ServerHandlerImp::processSession (std::shared_ptr<HTTP::Session> const& session,
     }
     else
     processRequest (session->port(), to_string (session->body()),
-        session->remoteAddress().at_port (0), makeOutput (*session), jobCoro,
-        session->forwarded_for(), session->user());
+        session->remoteAddress().at_port (0),
+        makeOutput (*session, jobCoro), jobCoro,
+        session->forwarded_for(), session->user(),
+        canChunkHTTPReply (session->request()));
 
     if (session->request().keep_alive())
         session->complete();
@@ -226,7 +219,7 @@ void
 ServerHandlerImp::processRequest (HTTP::Port const& port,
     std::string const& request, beast::IP::Endpoint const& remoteIPAddress,
         Output&& output, std::shared_ptr<JobCoro> jobCoro,
-        std::string forwardedFor, std::string user)
+        std::string forwardedFor, std::string user, bool chunked)
 {
     auto rpcJ = app_.journal ("RPC");
     // Move off the webserver thread onto the JobQueue.
@@ -361,47 +354,49 @@ ServerHandlerImp::processRequest (HTTP::Port const& port,
     RPC::Context context {m_journal, params, app_, loadType, m_networkOPs,
         app_.getLedgerMaster(), role, jobCoro, InfoSub::pointer(),
         {user, forwardedFor}};
-    Json::Value result;
-    RPC::doCommand (context, result);
 
-    // Always report "status".  On an error report the request as received.
-    if (result.isMember (jss::error))
+    // The reply is written as the handler produces it. Only the beginning
+    // is kept, for the log.
+    static std::size_t const maxLogSize = 10000;
+    bool const logReply = m_journal.info.active();
+    std::string logged;
+    auto writeReply = [&](Output const& out)
+    {
+        RPC::executeRPC (context,
+            [&](boost::string_ref const& b)
+            {
+                if (logReply && logged.size() < maxLogSize)
+                    logged.append (b.data(),
+                        std::min (b.size(), maxLogSize - logged.size()));
+                out (b);
+            });
+        out ("\n");
+    };
+
+    std::size_t size;
+    if (chunked)
     {
-        result[jss::status] = jss::error;
-        result[jss::request] = params;
-        JLOG (m_journal.debug)  <<
-            "rpcError: " << result [jss::error] <<
-            ": " << result [jss::error_message];
+        size = HTTPChunkedReply (writeReply, output, rpcJ);
     }
     else
     {
-        result[jss::status]  = jss::success;
+        std::string response;
+        writeReply (Json::stringOutput (response));
+        size = response.size();
+        HTTPReply (200, response, output, rpcJ);
     }
 
-    Json::Value reply (Json::objectValue);
-    reply[jss::result] = std::move (result);
-    auto response = to_string (reply);
-
     rpc_time_.notify (static_cast <beast::insight::Event::value_type> (
         std::chrono::duration_cast <std::chrono::milliseconds> (
             std::chrono::high_resolution_clock::now () - start)));
     ++rpc_requests_;
     rpc_size_.notify (static_cast <beast::insight::Event::value_type> (
-        response.size ()));
+        size));
 
-    response += '\n';
     usage.charge (loadType);
 
-    if (m_journal.info.active())
-    {
-        static const int maxSize = 10000;
-        if (response.size() <= maxSize)
-            m_journal.info << "Reply: " << response;
-        else
-            m_journal.info << "Reply: " << response.substr (0, maxSize);
-    }
-
-    HTTPReply (200, response, output, rpcJ);
+    if (logReply)
+        m_journal.info << "Reply: " << logged;
 }
 
 //------------------------------------------------------------------------------
@@ -115,7 +115,7 @@ private:
     processRequest (HTTP::Port const& port, std::string const& request,
         beast::IP::Endpoint const& remoteIPAddress, Output&&,
         std::shared_ptr<JobCoro> jobCoro,
-        std::string forwardedFor, std::string user);
+        std::string forwardedFor, std::string user, bool chunked);
 
     //
     // PropertyStream
@@ -0,0 +1,337 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+#include <BeastConfig.h>
+#include <ripple/core/JobCoro.h>
+#include <ripple/core/JobQueue.h>
+#include <ripple/rpc/impl/Tuning.h>
+#include <ripple/server/Port.h>
+#include <ripple/server/Session.h>
+#include <ripple/server/impl/JSONRPCUtil.h>
+#include <ripple/test/jtx.h>
+#include <boost/optional.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+class JSONRPCUtil_test : public beast::unit_test::suite
+{
+    // A session whose written data stays queued until it is drained
+    class TestSession : public HTTP::Session
+    {
+        std::mutex mutex_;
+        std::string written_;
+        std::size_t queued_ = 0;
+        std::function <void(void)> handler_;
+        HTTP::Port port_;
+        beast::http::message request_;
+        beast::http::body body_;
+
+    public:
+        beast::Journal
+        journal() override
+        {
+            return {};
+        }
+
+        HTTP::Port const&
+        port() override
+        {
+            return port_;
+        }
+
+        beast::IP::Endpoint
+        remoteAddress() override
+        {
+            return {};
+        }
+
+        std::string
+        user() override
+        {
+            return {};
+        }
+
+        std::string
+        forwarded_for() override
+        {
+            return {};
+        }
+
+        beast::http::message&
+        request() override
+        {
+            return request_;
+        }
+
+        beast::http::body const&
+        body() override
+        {
+            return body_;
+        }
+
+        void
+        write (void const* buffer, std::size_t bytes) override
+        {
+            std::lock_guard <std::mutex> lock (mutex_);
+            written_.append (static_cast <char const*> (buffer), bytes);
+            queued_ += bytes;
+        }
+
+        void
+        write (std::shared_ptr <HTTP::Writer> const&, bool) override
+        {
+        }
+
+        bool
+        wait_write (std::size_t bytes,
+            std::function <void(void)> handler) override
+        {
+            std::lock_guard <std::mutex> lock (mutex_);
+            if (queued_ <= bytes)
+                return false;
+            handler_ = std::move (handler);
+            return true;
+        }
+
+        std::shared_ptr <HTTP::Session>
+        detach() override
+        {
+            return {};
+        }
+
+        void
+        complete() override
+        {
+        }
+
+        void
+        close (bool) override
+        {
+        }
+
+        bool
+        waiting()
+        {
+            std::lock_guard <std::mutex> lock (mutex_);
+            return bool (handler_);
+        }
+
+        // Send everything queued and call a waiting handler
+        void
+        drain()
+        {
+            std::function <void(void)> handler;
+            {
+                std::lock_guard <std::mutex> lock (mutex_);
+                queued_ = 0;
+                handler.swap (handler_);
+            }
+            if (handler)
+                handler();
+        }
+
+        std::string
+        written()
+        {
+            std::lock_guard <std::mutex> lock (mutex_);
+            return written_;
+        }
+    };
+
+    // Decode the body of a chunked reply, keeping the chunk sizes
+    static
+    boost::optional <std::string>
+    unchunk (std::string const& reply, std::vector <std::size_t>& sizes)
+    {
+        auto pos = reply.find ("\r\n\r\n");
+        if (pos == std::string::npos)
+            return boost::none;
+        pos += 4;
+
+        std::string content;
+        while (true)
+        {
+            auto const eol = reply.find ("\r\n", pos);
+            if (eol == std::string::npos)
+                return boost::none;
+            auto const size = std::stoul (
+                reply.substr (pos, eol - pos), nullptr, 16);
+            pos = eol + 2;
+            if (size == 0)
+            {
+                if (reply.substr (pos) != "\r\n")
+                    return boost::none;
+                return content;
+            }
+            if (reply.size () < pos + size + 2 ||
+                    reply.compare (pos + size, 2, "\r\n") != 0)
+                return boost::none;
+            content.append (reply, pos, size);
+            sizes.push_back (size);
+            pos += size + 2;
+        }
+    }
+
+public:
+    void
+    testChunks()
+    {
+        testcase ("chunks");
+
+        std::string content;
+        for (int i = 0; i < 10; ++i)
+            content += std::string (20000, 'a' + i);
+
+        std::string reply;
+        auto const size = HTTPChunkedReply (
+            [&](Json::Output const& out)
+            {
+                for (std::size_t i = 0; i < content.size (); i += 20000)
+                    out (content.substr (i, 20000));
+            },
+            Json::stringOutput (reply), beast::Journal ());
+
+        expect (size == content.size ());
+        expect (reply.compare (0, 17, "HTTP/1.1 200 OK\r\n") == 0);
+        expect (reply.find ("Transfer-Encoding: chunked\r\n") !=
+            std::string::npos);
+        expect (reply.find ("Content-Length") == std::string::npos);
+
+        // Pieces are collected into chunks of at least 64KB, and the
+        // content is terminated like a whole reply.
+        std::vector <std::size_t> sizes;
+        auto const body = unchunk (reply, sizes);
+        if (! expect (body))
+            return;
+        expect (*body == content + "\r\n");
+        expect (sizes == std::vector <std::size_t> ({80000, 80000, 40002}));
+    }
+
+    void
+    testEmpty()
+    {
+        testcase ("empty");
+
+        std::string reply;
+        auto const size = HTTPChunkedReply (
+            [](Json::Output const&) {},
+            Json::stringOutput (reply), beast::Journal ());
+
+        expect (size == 0);
+        std::vector <std::size_t> sizes;
+        auto const body = unchunk (reply, sizes);
+        if (! expect (body))
+            return;
+        expect (*body == "\r\n");
+        expect (sizes == std::vector <std::size_t> ({2}));
+    }
+
+    void
+    testFallback()
+    {
+        testcase ("HTTP/1.0 fallback");
+
+        beast::http::message request;
+        request.version (1, 0);
+        expect (! canChunkHTTPReply (request));
+        request.version (1, 1);
+        expect (canChunkHTTPReply (request));
+
+        std::string const content = "{\"result\":{}}\n";
+        std::string reply;
+        HTTPReply (200, content, Json::stringOutput (reply),
+            beast::Journal ());
+        expect (reply.find ("Content-Length: " +
+            std::to_string (content.size () + 2) + "\r\n") !=
+                std::string::npos);
+        expect (reply.find ("Transfer-Encoding") == std::string::npos);
+    }
+
+    void
+    testSuspend()
+    {
+        testcase ("suspend");
+
+        using namespace std::chrono_literals;
+        jtx::Env env (*this);
+        auto& jq = env.app().getJobQueue();
+        jq.setThreadCount (0, false);
+
+        TestSession session;
+        std::string const small (1000, 'a');
+        std::string const large (RPC::Tuning::maxQueuedReply, 'b');
+        std::atomic<int> step {0};
+        std::condition_variable cv;
+        jq.postCoro (jtCLIENT, "JSONRPCUtil-Test",
+            [&](std::shared_ptr<JobCoro> jc)
+            {
+                auto const output = makeOutput (session, jc);
+                // Below the limit the reply is only queued
+                output (small);
+                step = 1;
+                // Above it the coroutine waits for the client
+                output (large);
+                step = 2;
+                cv.notify_one();
+            });
+
+        auto const start = std::chrono::steady_clock::now ();
+        while (! session.waiting () &&
+                std::chrono::steady_clock::now () - start < 1s)
+            std::this_thread::sleep_for (1ms);
+        expect (session.waiting ());
+        std::this_thread::sleep_for (20ms);
+        expect (step == 1);
+
+        session.drain ();
+        {
+            std::mutex m;
+            std::unique_lock<std::mutex> lk (m);
+            expect (cv.wait_for (lk, 1s,
+                [&]()
+                {
+                    return step == 2;
+                }));
+        }
+        jq.shutdown();
+        expect (step == 2);
+        expect (session.written () == small + large);
+    }
+
+    void
+    run()
+    {
+        testChunks();
+        testEmpty();
+        testFallback();
+        testSuspend();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(JSONRPCUtil,server,ripple);
+
+} // test
+} // ripple
@@ -3,38 +3,16 @@
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/core/ConfigSections.h>
+#include <ripple/ledger/TxMeta.h>
 #include <ripple/protocol/JsonFields.h>
 #include <ripple/thrift/HBaseConn.h>
+#include <ripple/thrift/HBaseSchema.h>
 #include <boost/make_shared.hpp>
 
 namespace ripple
 {
 class HBaseLedgerSaver : Application::SetupListener<HBaseLedgerSaver>
 {
-private:
-    // Hbase table defines.
-    static constexpr auto s_tableLocks =    SYSTEM_NAMESPACE ":Locks";  // LedgerData
-    static constexpr auto s_tableLedgers =  SYSTEM_NAMESPACE ":Ledgers";// LedgerData
-    static constexpr auto s_tableTxs =      SYSTEM_NAMESPACE ":Txs";    // Raw & meta data
-    static constexpr auto s_tableTxIndex =  SYSTEM_NAMESPACE ":TxIdx";  // Indexes for Hash -> Ledger,TxnSeq
-
-    boost::format s_keyTxs = boost::format ("%X%u-%u-%u"); // Row Key format: [Hex(LedgerSeq%16)][LedgerSeq]-[TxnType]-[TxnSeq]
-
-    static constexpr auto s_columnFamily =          "d:";
-
-    static constexpr auto s_columnRaw =             "d:r";
-    static constexpr auto s_columnMeta =            "d:m";
-    
-    static constexpr auto s_columnValue =           "d:v";
-
-    static constexpr auto s_columnHash =            "d:h";
-    static constexpr auto s_columnClosingTime =     "d:ct";
-    static constexpr auto s_columnPrevHash =        "d:ph";
-    static constexpr auto s_columnAccountSetHash =  "d:ah";
-    static constexpr auto s_columnTransSetHash =    "d:th";
-    static constexpr auto s_columnVRP =             "d:xrp";
-    static constexpr auto s_columnVBC =             "d:xrs";
-
 public:
     HBaseLedgerSaver (Application& app)
         : m_app (app),
@@ -103,11 +81,11 @@ private:
             try
             {
                 Mutation mput;
-                mput.column = s_columnValue;
+                mput.column = hbase::columnValue;
                 mput.value = "1";
                 std::map<Text, Text> attributes;
                 while (!m_ledgerSaver->getConnection ()->m_client->checkAndPut (
-                    s_tableLocks, m_rowKey, mput.column, "", mput, attributes))
+                    hbase::tableLocks, m_rowKey, mput.column, "", mput, attributes))
                 {
                     JLOG (m_ledgerSaver->m_journal.debug) << "wait for lock";
                     std::this_thread::sleep_for (std::chrono::milliseconds (100));
@@ -132,7 +110,7 @@ private:
                 {
                     std::map<Text, Text> attributes;
                     m_ledgerSaver->getConnection ()->m_client->deleteAllRow (
-                        s_tableLocks, m_rowKey, attributes);
+                        hbase::tableLocks, m_rowKey, attributes);
                     m_locked = false;
                     return true;
                 }
@@ -169,7 +147,7 @@ private:
             try
             {
                 getConnection ()->m_client->get (
-                    cells, s_tableLedgers, ledgerSeqStr, s_columnHash, attributes);
+                    cells, hbase::tableLedgers, ledgerSeqStr, hbase::columnHash, attributes);
             }
             catch (const TException& te)
             {
@@ -192,7 +170,7 @@ private:
                     try
                     {
                         getConnection ()->m_client->deleteAllRow (
-                            s_tableLedgers, ledgerSeqStr, attributes);
+                            hbase::tableLedgers, ledgerSeqStr, attributes);
                     }
                     catch (const TException& te)
                     {
@@ -226,9 +204,8 @@ private:
             JLOG (m_journal.debug) << "scanning dirty txs";
             std::map<Text, Text> attributes;
             std::vector<Text> columns;
-            static boost::format prefix ("%X%u-");
             auto scanner = getConnection ()->m_client->scannerOpenWithPrefix (
-                s_tableTxs, boost::str (prefix % (ledgerSeq % 16) % ledgerSeq), columns, attributes);
+                hbase::tableTxs, hbase::txsPrefix (ledgerSeq), columns, attributes);
 
             std::vector<TRowResult> rowList;
             for (;;)
@@ -238,6 +215,7 @@ private:
                     break;
                 JLOG (m_journal.debug) << "deleting " << rowList.size () << " dirty txs";
                 std::vector<BatchMutation> rowBatches;
+                std::vector<BatchMutation> accountTxsBatches;
                 for (auto& row : rowList)
                 {
                     rowBatches.push_back (BatchMutation ());
@@ -245,8 +223,16 @@ private:
                     auto& mutations = rowBatches.back ().mutations;
                     mutations.push_back (Mutation ());
                     mutations.back ().isDelete = true;
+
+                    addDirtyAccountTxs (row, accountTxsBatches);
                 }
-                getConnection ()->m_client->mutateRows (s_tableTxs, rowBatches, attributes);
+
+                // The account rows go first, so none is left pointing
+                // at a deleted Txs row when a mutation fails
+                if (!accountTxsBatches.empty ())
+                    getConnection ()->m_client->mutateRows (
+                        hbase::tableAccountTxs, accountTxsBatches, attributes);
+                getConnection ()->m_client->mutateRows (hbase::tableTxs, rowBatches, attributes);
             }
 
             getConnection ()->m_client->scannerClose (scanner);
@@ -261,6 +247,7 @@ private:
         // write txs
         std::vector<BatchMutation> txsBatches;
         std::vector<BatchMutation> txIndexBatches;
+        std::vector<BatchMutation> accountTxsBatches;
         for (auto const& vt : aLedger->getMap ())
         {
             uint256 transactionID = vt.second->getTransactionID ();
@@ -268,8 +255,8 @@ private:
             m_app.getMasterTransaction ().inLedger (
                 transactionID, ledgerSeq);
 
-            std::string const rowKey (boost::str (
-                s_keyTxs % (ledgerSeq % 16) % ledgerSeq % vt.second->getTxnType () % vt.second->getTxnSeq ()));
+            std::string const rowKey (hbase::txsKey (
+                ledgerSeq, vt.second->getTxnType (), vt.second->getTxnSeq ()));
 
             // mutations to table Txs
             {
@@ -279,13 +266,13 @@ private:
                 auto& mutations = txsBatches.back ().mutations;
 
                 mutations.push_back (Mutation ());
-                mutations.back ().column = s_columnRaw;
+                mutations.back ().column = hbase::columnRaw;
                 Serializer s;
                 vt.second->getTxn ()->add (s);
                 mutations.back ().value.assign (s.getString ());
                 
                 mutations.push_back (Mutation ());
-                mutations.back ().column = s_columnMeta;
+                mutations.back ().column = hbase::columnMeta;
                 mutations.back ().value.assign (vt.second->getRawMeta ());
             }
 
@@ -297,94 +284,134 @@ private:
                 auto& mutations = txIndexBatches.back ().mutations;
 
                 mutations.push_back (Mutation ());
-                mutations.back ().column = s_columnValue;
+                mutations.back ().column = hbase::columnValue;
                 mutations.back ().value.assign (rowKey);
-            }         
+            }
+
+            // mutations to table AccountTxs
+            for (auto const& account : vt.second->getAffected ())
+            {
+                accountTxsBatches.push_back (BatchMutation ());
+                accountTxsBatches.back ().row = hbase::accountTxsKey (
+                    account, ledgerSeq, vt.second->getTxnSeq ());
+
+                auto& mutations = accountTxsBatches.back ().mutations;
+
+                mutations.push_back (Mutation ());
+                mutations.back ().column = hbase::columnValue;
+                mutations.back ().value.assign (rowKey);
+
+                mutations.push_back (Mutation ());
+                mutations.back ().column = hbase::columnHash;
+                mutations.back ().value.assign (to_string (transactionID));
+            }
         }
         
         // mutations to table Ledgers
         std::vector<Mutation> ledgerMutations;
         ledgerMutations.push_back (Mutation ());
-        ledgerMutations.back ().column = s_columnHash;
+        ledgerMutations.back ().column = hbase::columnHash;
         ledgerMutations.back ().value.assign (ledgerHash);
         ledgerMutations.push_back (Mutation ());
-        ledgerMutations.back ().column = s_columnPrevHash;
+        ledgerMutations.back ().column = hbase::columnPrevHash;
         ledgerMutations.back ().value.assign (to_string (ledger->info ().parentHash));
         ledgerMutations.push_back (Mutation ());
-        ledgerMutations.back ().column = s_columnAccountSetHash;
+        ledgerMutations.back ().column = hbase::columnAccountSetHash;
         ledgerMutations.back ().value.assign (to_string (ledger->info().accountHash));
         ledgerMutations.push_back (Mutation ());
-        ledgerMutations.back ().column = s_columnTransSetHash;
+        ledgerMutations.back ().column = hbase::columnTransSetHash;
         ledgerMutations.back ().value.assign (to_string (ledger->info().txHash));
         ledgerMutations.push_back (Mutation ());
-        ledgerMutations.back ().column = s_columnClosingTime;
+        ledgerMutations.back ().column = hbase::columnClosingTime;
         ledgerMutations.back ().value.assign (to_string (ledger->info ().closeTime));
         ledgerMutations.push_back (Mutation ());
-        ledgerMutations.back ().column = s_columnXRP;
+        ledgerMutations.back ().column = hbase::columnXRP;
         ledgerMutations.back ().value.assign (to_string (ledger->info ().drops));
         ledgerMutations.push_back (Mutation ());
-        ledgerMutations.back ().column = s_columnXRS;
+        ledgerMutations.back ().column = hbase::columnXRS;
         ledgerMutations.back ().value.assign (to_string (ledger->info ().dropsXRS));
 
-        for (int i = 0; i < 3; i++)
-        {
-            try
+        // The ledger row goes last, it marks the ledger as saved
+        if (!mutateWithRetry ("Txs", [&](std::map<Text, Text> const& attributes)
             {
-                std::map<Text, Text> attributes;
                 getConnection ()->m_client->mutateRows (
-                    s_tableTxs, txsBatches, attributes);
-                JLOG (m_journal.info) << "save tx done";
-            }
-            catch (const TException& te)
+                    hbase::tableTxs, txsBatches, attributes);
+            }) ||
+            !mutateWithRetry ("TxIndex", [&](std::map<Text, Text> const& attributes)
             {
-                JLOG (m_journal.error) << "save TX failed, " << te.what ();
-                if (i == 3)
-                {
-                    JLOG (m_journal.error) << "fail to save " << ledgerSeq;
-                    return false;
-                }
-            }
-        }
-        for (int i = 0; i < 3; i++)
-        {
-            try
+                getConnection ()->m_client->mutateRows (
+                    hbase::tableTxIndex, txIndexBatches, attributes);
+            }) ||
+            !mutateWithRetry ("AccountTxs", [&](std::map<Text, Text> const& attributes)
             {
-                std::map<Text, Text> attributes;
                 getConnection ()->m_client->mutateRows (
-                    s_tableTxIndex, txIndexBatches, attributes);
-                JLOG (m_journal.info) << "save TxIndex done";
-            }
-            catch (const TException& te)
+                    hbase::tableAccountTxs, accountTxsBatches, attributes);
+            }) ||
+            !mutateWithRetry ("Ledgers", [&](std::map<Text, Text> const& attributes)
             {
-                JLOG (m_journal.error) << "save TxIndex failed, " << te.what ();
-                if (i == 3)
-                {
-                    JLOG (m_journal.error) << "fail to save " << ledgerSeq;
-                    return false;
-                }
+                getConnection ()->m_client->mutateRow (
+                    hbase::tableLedgers, ledgerSeqStr, ledgerMutations, attributes);
+            }))
+        {
+            JLOG (m_journal.error) << "fail to save " << ledgerSeq;
+            return false;
+        }
+        return true;
+    }
+
+    // Delete the AccountTxs rows of a dirty Txs row, found from the
+    // accounts its metadata affects
+    void addDirtyAccountTxs (
+        apache::hadoop::hbase::thrift::TRowResult const& row,
+            std::vector<apache::hadoop::hbase::thrift::BatchMutation>& batches)
+    {
+        using namespace apache::hadoop::hbase::thrift;
+
+        LedgerIndex seq;
+        std::uint32_t txnSeq;
+        auto const meta = row.columns.find (hbase::columnMeta);
+        if (!hbase::parseTxsKey (row.row, seq, txnSeq) ||
+            meta == row.columns.end ())
+            return;
+
+        try
+        {
+            TxMeta const txMeta (uint256 (), seq, meta->second.value, m_journal);
+            for (auto const& account : txMeta.getAffectedAccounts ())
+            {
+                batches.push_back (BatchMutation ());
+                batches.back ().row = hbase::accountTxsKey (account, seq, txnSeq);
+                batches.back ().mutations.push_back (Mutation ());
+                batches.back ().mutations.back ().isDelete = true;
             }
         }
+        catch (std::exception const& e)
+        {
+            JLOG (m_journal.warning) << "bad meta in dirty tx " << row.row
+                << ", " << e.what ();
+        }
+    }
+
+    template <class Mutate>
+    bool mutateWithRetry (char const* table, Mutate const& mutate)
+    {
+        using namespace apache::thrift;
+        using namespace apache::hadoop::hbase::thrift;
+
         for (int i = 0; i < 3; i++)
         {
             try
             {
                 std::map<Text, Text> attributes;
-                getConnection ()->m_client->mutateRow (
-                    s_tableLedgers, ledgerSeqStr, ledgerMutations, attributes);
-                JLOG (m_journal.info) << "save Ledgers done";
+                mutate (attributes);
+                JLOG (m_journal.info) << "save " << table << " done";
                 return true;
             }
             catch (const TException& te)
             {
-                JLOG (m_journal.error) << "save Ledgers failed, " << te.what ();
-                if (i == 3)
-                {
-                    JLOG (m_journal.error) << "fail to save " << ledgerSeq;
-                    return false;
-                }
+                JLOG (m_journal.error) << "save " << table << " failed, " << te.what ();
             }
         }
-        JLOG (m_journal.error) << "fail to save " << ledgerSeq;
         return false;
     }
 
@@ -406,14 +433,15 @@ private:
 
         std::vector<ColumnDescriptor> columns;
         columns.push_back (ColumnDescriptor ());
-        columns.back ().name = s_columnFamily;
+        columns.back ().name = hbase::columnFamily;
         columns.back ().maxVersions = 1;
         columns.back ().compression = "SNAPPY";
         columns.back ().blockCacheEnabled = true;
         columns.back ().bloomFilterType = "ROW";
 
         // create table if not exists.
-        for (auto& tableName : {s_tableTxs, s_tableTxIndex, s_tableLedgers})
+        for (auto& tableName : {hbase::tableTxs, hbase::tableTxIndex,
+            hbase::tableAccountTxs, hbase::tableLedgers})
         {
             try
             {
@@ -432,22 +460,22 @@ private:
 
         columns.clear ();
         columns.push_back (ColumnDescriptor ());
-        columns.back ().name = s_columnFamily;
+        columns.back ().name = hbase::columnFamily;
         columns.back ().maxVersions = 1;
         columns.back ().inMemory = true;
         columns.back ().blockCacheEnabled = true;
         columns.back ().timeToLive = 3;
         try
         {
-            getConnection ()->m_client->createTable (s_tableLocks, columns);
+            getConnection ()->m_client->createTable (hbase::tableLocks, columns);
         }
         catch (const AlreadyExists& ae)
         {
-            JLOG (m_journal.debug) << "Table " << s_tableLocks << " exists, " << ae.message;
+            JLOG (m_journal.debug) << "Table " << hbase::tableLocks << " exists, " << ae.message;
         }
         catch (const TException& te)
         {
-            JLOG (m_journal.error) << "Create table " << s_tableLocks << " failed, " << te.what ();
+            JLOG (m_journal.error) << "Create table " << hbase::tableLocks << " failed, " << te.what ();
             throw std::runtime_error (te.what ());
         }
     }
@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_THRIFT_HBASESCHEMA_H_INCLUDED
+#define RIPPLE_THRIFT_HBASESCHEMA_H_INCLUDED
+
+#include <ripple/basics/strHex.h>
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/Protocol.h>
+#include <ripple/protocol/SystemParameters.h>
+#include <boost/format.hpp>
+#include <cstdint>
+#include <string>
+
+namespace ripple {
+
+/** Tables, columns and row keys shared by the HBase saver and readers. */
+namespace hbase {
+
+static constexpr auto tableLocks =          SYSTEM_NAMESPACE ":Locks";   // Save locks
+static constexpr auto tableLedgers =        SYSTEM_NAMESPACE ":Ledgers"; // Ledger headers
+static constexpr auto tableTxs =            SYSTEM_NAMESPACE ":Txs";     // Raw & meta data
+static constexpr auto tableTxIndex =        SYSTEM_NAMESPACE ":TxIdx";   // Hash -> Txs row
+static constexpr auto tableAccountTxs =     SYSTEM_NAMESPACE ":AcctTxs"; // Account -> Txs row
+
+static constexpr auto columnFamily =        "d:";
+
+static constexpr auto columnRaw =           "d:r";
+static constexpr auto columnMeta =          "d:m";
+
+static constexpr auto columnValue =         "d:v";
+
+static constexpr auto columnHash =          "d:h";
+static constexpr auto columnClosingTime =   "d:ct";
+static constexpr auto columnPrevHash =      "d:ph";
+static constexpr auto columnAccountSetHash = "d:ah";
+static constexpr auto columnTransSetHash =  "d:th";
+static constexpr auto columnXRP =           "d:xrp";
+static constexpr auto columnXRS =           "d:xrs";
+
+/** Row keys start with one hex digit, spreading them over the regions. */
+static std::uint32_t const saltBuckets = 16;
+
+namespace detail {
+
+// Parse decimal or hex digits up to the delimiter or the end
+inline
+bool
+parseNumber (std::string const& s, std::size_t& pos, char delimiter,
+    bool hex, std::uint32_t& out)
+{
+    std::uint64_t value = 0;
+    auto const start = pos;
+    for (; pos < s.size () && s[pos] != delimiter; ++pos)
+    {
+        auto const c = s[pos];
+        int digit;
+        if (c >= '0' && c <= '9')
+            digit = c - '0';
+        else if (hex && c >= 'A' && c <= 'F')
+            digit = c - 'A' + 10;
+        else
+            return false;
+        value = value * (hex ? 16 : 10) + digit;
+        if (value > 0xFFFFFFFF)
+            return false;
+    }
+    if (pos == start)
+        return false;
+    if (pos < s.size ())
+        ++pos;
+    out = static_cast<std::uint32_t> (value);
+    return true;
+}
+
+} // detail
+
+/** Prefix of the Txs rows of a ledger: [Hex(LedgerSeq%16)][LedgerSeq]- */
+inline
+std::string
+txsPrefix (LedgerIndex seq)
+{
+    return boost::str (boost::format ("%X%u-") % (seq % saltBuckets) % seq);
+}
+
+/** Txs row: [Hex(LedgerSeq%16)][LedgerSeq]-[TxnType]-[TxnSeq] */
+inline
+std::string
+txsKey (LedgerIndex seq, int txnType, std::uint32_t txnSeq)
+{
+    return boost::str (boost::format ("%X%u-%u-%u") %
+        (seq % saltBuckets) % seq % txnType % txnSeq);
+}
+
+inline
+bool
+parseTxsKey (std::string const& key, LedgerIndex& seq, std::uint32_t& txnSeq)
+{
+    std::size_t pos = 1;
+    std::uint32_t type;
+    return key.size () > 1 &&
+        detail::parseNumber (key, pos, '-', false, seq) &&
+        detail::parseNumber (key, pos, '-', false, type) &&
+        detail::parseNumber (key, pos, '-', false, txnSeq) &&
+        pos == key.size () &&
+        key.substr (0, 1) == boost::str (
+            boost::format ("%X") % (seq % saltBuckets));
+}
+
+/** Prefix of the AccountTxs rows of an account: [Salt][Hex(Account)]- */
+inline
+std::string
+accountTxsPrefix (AccountID const& account)
+{
+    return boost::str (boost::format ("%X%s-") %
+        (account.data ()[0] % saltBuckets) %
+            strHex (account.data (), account.size ()));
+}
+
+/** AccountTxs row: [Salt][Hex(Account)]-[%08X LedgerSeq]-[%08X TxnSeq]
+    The fixed width fields keep an account's rows in ledger order.
+*/
+inline
+std::string
+accountTxsKey (AccountID const& account,
+    LedgerIndex seq, std::uint32_t txnSeq)
+{
+    return accountTxsPrefix (account) +
+        boost::str (boost::format ("%08X-%08X") % seq % txnSeq);
+}
+
+inline
+bool
+parseAccountTxsKey (std::string const& key,
+    LedgerIndex& seq, std::uint32_t& txnSeq)
+{
+    // Salt, account and the dash
+    std::size_t pos = 1 + 2 * AccountID::bytes + 1;
+    return key.size () == pos + 8 + 1 + 8 &&
+        detail::parseNumber (key, pos, '-', true, seq) &&
+        detail::parseNumber (key, pos, '-', true, txnSeq);
+}
+
+} // hbase
+
+} // ripple
+
+#endif
@@ -0,0 +1,430 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/main/Application.h>
+#include <ripple/app/misc/TxStore.h>
+#include <ripple/basics/Log.h>
+#include <ripple/core/ConfigSections.h>
+#include <ripple/protocol/HashPrefix.h>
+#include <ripple/protocol/Serializer.h>
+#include <ripple/thrift/HBaseConn.h>
+#include <ripple/thrift/HBaseSchema.h>
+#include <beast/module/core/thread/Workers.h>
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <mutex>
+
+namespace ripple
+{
+/** Serves transaction history from the tables HBaseLedgerSaver writes.
+
+    Enabled by serve_rpc=1 in [tx_db_hbase]. Connections are pooled so
+    that several scanners can run at once: tx_history scans the salted
+    Txs prefixes of consecutive ledgers in parallel, since consecutive
+    ledgers live in different salt buckets. The scans of all callers
+    share a fixed set of worker threads, and at most that many idle
+    connections are kept.
+*/
+class HBaseTxStore
+    : public TxStore
+    , Application::SetupListener<HBaseTxStore>
+    , private beast::Workers::Callback
+{
+public:
+    HBaseTxStore (Section const& section, beast::Journal journal)
+        : m_journal (journal)
+        , m_hbaseFactory (section, journal)
+        , m_scanners (std::max (1, get<int> (section, "scanners", 16)))
+        , m_workers (*this, "HBaseScan", static_cast<int> (m_scanners))
+    {
+    }
+
+    static bool onSetup (Application& app)
+    {
+        auto const& section = app.config ().section (SECTION_TX_DB_HBASE);
+        if (!app.config ().exists (SECTION_TX_DB_HBASE) ||
+            !get<bool> (section, "serve_rpc", false))
+            return true;
+
+        try
+        {
+            app.setTxStore (std::make_unique<HBaseTxStore> (
+                section, app.journal ("HBaseTxStore")));
+            JLOG (app.journal ("HBaseTxStore").info) << "serving RPC";
+        }
+        catch (const std::exception& e)
+        {
+            JLOG (app.journal ("HBaseTxStore").error) << e.what ();
+            return false;
+        }
+
+        return true;
+    }
+
+    boost::optional<Tx> getTx (uint256 const& id) override
+    {
+        using namespace apache::hadoop::hbase::thrift;
+
+        auto conn = acquire ();
+        auto& client = conn->getClient ();
+        std::map<Text, Text> attributes;
+
+        std::vector<TCell> cells;
+        client.get (cells, hbase::tableTxIndex, to_string (id),
+            hbase::columnValue, attributes);
+        if (cells.empty ())
+        {
+            release (std::move (conn));
+            return boost::none;
+        }
+
+        std::vector<TRowResult> rows;
+        client.getRow (rows, hbase::tableTxs, cells[0].value, attributes);
+        release (std::move (conn));
+
+        for (auto const& row : rows)
+        {
+            auto tx = makeTx (row, id);
+            if (tx)
+                return tx;
+        }
+        return boost::none;
+    }
+
+    std::vector<Tx> getAccountTxs (AccountID const& account,
+        LedgerIndex ledgerSeq, std::uint32_t txnSeq, LedgerIndex endLedger,
+            bool forward, std::size_t limit) override
+    {
+        using namespace apache::hadoop::hbase::thrift;
+
+        std::vector<Tx> result;
+        if (limit == 0)
+            return result;
+
+        auto conn = acquire ();
+        auto& client = conn->getClient ();
+        std::map<Text, Text> attributes;
+
+        // Locate the transactions in the account index
+        TScan scan;
+        scan.__set_startRow (hbase::accountTxsKey (account, ledgerSeq, txnSeq));
+        if (forward)
+        {
+            scan.__set_stopRow (hbase::accountTxsKey (
+                account, endLedger, 0xFFFFFFFF) + std::string (1, '\0'));
+        }
+        else
+        {
+            scan.__set_reversed (true);
+            scan.__set_stopRow (hbase::accountTxsPrefix (account));
+        }
+        scan.__set_columns ({hbase::columnValue, hbase::columnHash});
+        scan.__set_caching (static_cast<std::int32_t> (
+            std::min<std::size_t> (limit, fetchLimit ())));
+
+        {
+            Scanner const scanner (client, client.scannerOpenWithScan (
+                hbase::tableAccountTxs, scan, attributes));
+
+            // Missing and stale rows don't count, so the scan goes on until
+            // the page is full or the account has no more rows. Otherwise a
+            // short page would look like the end of the history.
+            std::vector<TRowResult> rows;
+            bool done = false;
+            while (!done && result.size () < limit)
+            {
+                client.scannerGetList (rows, scanner.id (), scan.caching);
+                if (rows.empty ())
+                    break;
+
+                std::vector<std::pair<Text, uint256>> positions;
+                for (auto const& row : rows)
+                {
+                    LedgerIndex seq;
+                    std::uint32_t index;
+                    if (!hbase::parseAccountTxsKey (row.row, seq, index))
+                        continue;
+                    if (!forward && seq < endLedger)
+                    {
+                        done = true;
+                        break;
+                    }
+
+                    auto const value = row.columns.find (hbase::columnValue);
+                    auto const hash = row.columns.find (hbase::columnHash);
+                    uint256 id;
+                    if (value == row.columns.end () || hash == row.columns.end () ||
+                        !id.SetHexExact (hash->second.value.c_str ()))
+                        continue;
+
+                    positions.emplace_back (value->second.value, id);
+                }
+                if (positions.empty ())
+                    continue;
+
+                // Fetch the transactions of this batch of positions
+                std::vector<Text> keys;
+                keys.reserve (positions.size ());
+                for (auto const& position : positions)
+                    keys.push_back (position.first);
+
+                std::vector<TRowResult> found;
+                client.getRows (found, hbase::tableTxs, keys, attributes);
+                std::map<Text, TRowResult> txs;
+                for (auto& row : found)
+                    txs[row.row] = std::move (row);
+
+                for (auto const& position : positions)
+                {
+                    if (result.size () >= limit)
+                        break;
+                    auto const iter = txs.find (position.first);
+                    if (iter == txs.end ())
+                        continue;
+                    if (auto tx = makeTx (iter->second, position.second))
+                        result.push_back (std::move (*tx));
+                }
+            }
+        }
+        release (std::move (conn));
+        return result;
+    }
+
+    std::vector<Tx> getTxHistory (LedgerIndex firstLedger,
+        LedgerIndex lastLedger, std::size_t startIndex,
+            std::size_t count) override
+    {
+        std::vector<Tx> result;
+        std::size_t skipped = 0;
+
+        for (auto seq = std::int64_t (lastLedger);
+            seq >= std::int64_t (firstLedger) && result.size () < count;)
+        {
+            // One scan for each of the next ledgers, newest first
+            std::vector<std::future<std::vector<Tx>>> scans;
+            for (std::size_t i = 0; i < m_scanners &&
+                seq >= std::int64_t (firstLedger); ++i, --seq)
+            {
+                scans.push_back (post (static_cast<LedgerIndex> (seq)));
+            }
+
+            // Wait for all of them, even when one throws
+            std::vector<std::vector<Tx>> ledgers;
+            for (auto& scan : scans)
+                scan.wait ();
+            for (auto& scan : scans)
+                ledgers.push_back (scan.get ());
+
+            for (auto& ledger : ledgers)
+            {
+                for (auto& tx : ledger)
+                {
+                    if (result.size () >= count)
+                        break;
+                    if (skipped < startIndex)
+                        ++skipped;
+                    else
+                        result.push_back (std::move (tx));
+                }
+            }
+        }
+        return result;
+    }
+
+private:
+    // Closes a scanner however the scan ends, so that a failed thrift
+    // call doesn't leave it open on the server
+    class Scanner
+    {
+    public:
+        Scanner (apache::hadoop::hbase::thrift::HbaseClient& client,
+                apache::hadoop::hbase::thrift::ScannerID id)
+            : m_client (client)
+            , m_id (id)
+        {
+        }
+
+        Scanner (Scanner const&) = delete;
+        Scanner& operator= (Scanner const&) = delete;
+
+        ~Scanner ()
+        {
+            try
+            {
+                m_client.scannerClose (m_id);
+            }
+            catch (std::exception const&)
+            {
+                // The scanner expires on the server
+            }
+        }
+
+        apache::hadoop::hbase::thrift::ScannerID id () const
+        {
+            return m_id;
+        }
+
+    private:
+        apache::hadoop::hbase::thrift::HbaseClient& m_client;
+        apache::hadoop::hbase::thrift::ScannerID const m_id;
+    };
+
+    // Queue the scan of a ledger for the workers
+    std::future<std::vector<Tx>> post (LedgerIndex seq)
+    {
+        std::packaged_task<std::vector<Tx>()> task (
+            [this, seq] { return scanLedger (seq); });
+        auto result = task.get_future ();
+        {
+            std::lock_guard<std::mutex> lock (m_mutex);
+            m_tasks.push_back (std::move (task));
+        }
+        m_workers.addTask ();
+        return result;
+    }
+
+    void processTask () override
+    {
+        std::packaged_task<std::vector<Tx>()> task;
+        {
+            std::lock_guard<std::mutex> lock (m_mutex);
+            task = std::move (m_tasks.front ());
+            m_tasks.pop_front ();
+        }
+        // Exceptions are stored in the future
+        task ();
+    }
+
+    // Transactions of one ledger, in ledger order
+    std::vector<Tx> scanLedger (LedgerIndex seq)
+    {
+        using namespace apache::hadoop::hbase::thrift;
+
+        std::vector<Tx> result;
+
+        auto conn = acquire ();
+        auto& client = conn->getClient ();
+        std::map<Text, Text> attributes;
+
+        {
+            Scanner const scanner (client, client.scannerOpenWithPrefix (
+                hbase::tableTxs, hbase::txsPrefix (seq),
+                    {hbase::columnRaw, hbase::columnMeta}, attributes));
+            std::vector<TRowResult> rows;
+            for (;;)
+            {
+                client.scannerGetList (rows, scanner.id (), fetchLimit ());
+                if (rows.empty ())
+                    break;
+                for (auto const& row : rows)
+                {
+                    if (auto tx = makeTx (row, boost::none))
+                        result.push_back (std::move (*tx));
+                }
+            }
+        }
+        release (std::move (conn));
+
+        // Row keys sort by transaction type first
+        std::sort (result.begin (), result.end (),
+            [](Tx const& a, Tx const& b)
+            {
+                return a.txnSeq < b.txnSeq;
+            });
+        return result;
+    }
+
+    // Decode a Txs row, checking that it holds the expected transaction
+    boost::optional<Tx> makeTx (
+        apache::hadoop::hbase::thrift::TRowResult const& row,
+            boost::optional<uint256> const& id)
+    {
+        Tx tx;
+        if (!hbase::parseTxsKey (row.row, tx.ledgerSeq, tx.txnSeq))
+            return boost::none;
+
+        auto const raw = row.columns.find (hbase::columnRaw);
+        if (raw == row.columns.end ())
+            return boost::none;
+        tx.rawTxn.assign (raw->second.value.begin (), raw->second.value.end ());
+
+        auto const meta = row.columns.find (hbase::columnMeta);
+        if (meta != row.columns.end ())
+            tx.rawMeta.assign (meta->second.value.begin (), meta->second.value.end ());
+
+        // A row left behind by a replaced ledger can point elsewhere
+        if (id)
+        {
+            Serializer s;
+            s.add32 (HashPrefix::transactionID);
+            s.addRaw (tx.rawTxn);
+            if (s.getSHA512Half () != *id)
+            {
+                JLOG (m_journal.warning) << "stale row " << row.row;
+                return boost::none;
+            }
+        }
+        return tx;
+    }
+
+    std::size_t fetchLimit ()
+    {
+        return m_hbaseFactory.getSetup ().fetchBatchLimit;
+    }
+
+    // A connection that failed is dropped rather than returned
+    std::unique_ptr<HBaseConn> acquire ()
+    {
+        {
+            std::lock_guard<std::mutex> lock (m_mutex);
+            if (!m_idle.empty ())
+            {
+                auto conn = std::move (m_idle.back ());
+                m_idle.pop_back ();
+                if (!conn->isOpen ())
+                    conn->open ();
+                return conn;
+            }
+        }
+        return std::make_unique<HBaseConn> (
+            m_hbaseFactory.getSetup (), m_journal);
+    }
+
+    // Connections past the idle limit are closed
+    void release (std::unique_ptr<HBaseConn> conn)
+    {
+        std::lock_guard<std::mutex> lock (m_mutex);
+        if (m_idle.size () < m_scanners)
+            m_idle.push_back (std::move (conn));
+    }
+
+private:
+    beast::Journal m_journal;
+    HBaseConnFactory m_hbaseFactory;
+    std::size_t const m_scanners;
+
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<HBaseConn>> m_idle;
+    std::deque<std::packaged_task<std::vector<Tx>()>> m_tasks;
+
+    // Last, so the threads stop before the rest is destroyed
+    beast::Workers m_workers;
+};
+}
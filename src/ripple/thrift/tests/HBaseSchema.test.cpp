@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/thrift/HBaseSchema.h>
+#include <beast/unit_test/suite.h>
+
+namespace ripple {
+
+class HBaseSchema_test : public beast::unit_test::suite
+{
+public:
+    void
+    testTxsKey()
+    {
+        testcase ("Txs key");
+
+        expect (hbase::txsKey (17, 0, 3) == "117-0-3");
+        expect (hbase::txsPrefix (17) == "117-");
+        expect (hbase::txsKey (31, 7, 0).compare (
+            0, hbase::txsPrefix (31).size (), hbase::txsPrefix (31)) == 0);
+
+        // One ledger's prefix is not the prefix of another's
+        expect (hbase::txsKey (117, 0, 0).compare (
+            0, hbase::txsPrefix (1).size (), hbase::txsPrefix (1)) != 0);
+
+        LedgerIndex seq;
+        std::uint32_t txnSeq;
+        expect (hbase::parseTxsKey (hbase::txsKey (4000000000, 20, 77),
+            seq, txnSeq));
+        expect (seq == 4000000000 && txnSeq == 77);
+
+        expect (! hbase::parseTxsKey ("", seq, txnSeq));
+        expect (! hbase::parseTxsKey ("117-0", seq, txnSeq));
+        expect (! hbase::parseTxsKey ("217-0-3", seq, txnSeq));
+        expect (! hbase::parseTxsKey ("117-0-3x", seq, txnSeq));
+    }
+
+    void
+    testAccountTxsKey()
+    {
+        testcase ("AccountTxs key");
+
+        AccountID a;
+        a.data ()[0] = 0x21;
+        a.data ()[19] = 0xAB;
+        auto const prefix = hbase::accountTxsPrefix (a);
+        expect (prefix.size () == 1 + 40 + 1);
+        expect (prefix[0] == '1');
+
+        // Rows of an account sort by ledger, then transaction
+        auto const k1 = hbase::accountTxsKey (a, 9, 5);
+        auto const k2 = hbase::accountTxsKey (a, 10, 0);
+        auto const k3 = hbase::accountTxsKey (a, 10, 1);
+        expect (k1 < k2 && k2 < k3);
+        expect (k1.compare (0, prefix.size (), prefix) == 0);
+
+        LedgerIndex seq;
+        std::uint32_t txnSeq;
+        expect (hbase::parseAccountTxsKey (k3, seq, txnSeq));
+        expect (seq == 10 && txnSeq == 1);
+        expect (hbase::parseAccountTxsKey (
+            hbase::accountTxsKey (a, 0xFFFFFFFF, 0xFFFFFFFF), seq, txnSeq));
+        expect (seq == 0xFFFFFFFF && txnSeq == 0xFFFFFFFF);
+
+        expect (! hbase::parseAccountTxsKey (prefix, seq, txnSeq));
+        expect (! hbase::parseAccountTxsKey (k3 + "0", seq, txnSeq));
+    }
+
+    void
+    run()
+    {
+        testTxsKey();
+        testAccountTxsKey();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(HBaseSchema,thrift,ripple);
+
+}
@@ -22,6 +22,7 @@
 #include <ripple/app/ledger/AcceptedLedger.cpp>
 #include <ripple/app/ledger/AcceptedLedgerTx.cpp>
 #include <ripple/app/ledger/AccountStateSF.cpp>
+#include <ripple/app/ledger/BookIndex.cpp>
 #include <ripple/app/ledger/BookListeners.cpp>
 #include <ripple/app/ledger/ConsensusTransSetSF.cpp>
 #include <ripple/app/ledger/Ledger.cpp>
@@ -41,6 +42,7 @@
 #include <ripple/app/ledger/impl/LedgerConsensusZk.cpp>
 #endif
 #include <ripple/app/ledger/impl/LedgerMaster.cpp>
+#include <ripple/app/ledger/impl/LedgerPersister.cpp>
 #include <ripple/app/ledger/impl/LedgerTiming.cpp>
 #include <ripple/app/ledger/impl/LocalTxs.cpp>
 #include <ripple/app/ledger/impl/OpenLedger.cpp>
@@ -29,6 +29,7 @@
 #include <ripple/app/misc/Validations.cpp>
 #include <ripple/app/misc/DividendMasterImpl.cpp>
 
+#include <ripple/app/misc/impl/AccountTxIndex.cpp>
 #include <ripple/app/misc/impl/AccountTxPaging.cpp>
 #include <ripple/app/misc/impl/Transaction.cpp>
 #include <ripple/app/misc/impl/TxQ.cpp>
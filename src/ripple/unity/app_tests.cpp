@@ -19,13 +19,16 @@
 
 #include <BeastConfig.h>
 
+#include <ripple/app/tests/AccountTxIndex.test.cpp>
 #include <ripple/app/tests/AccountTxPaging.test.cpp>
 #include <ripple/app/tests/Activate.test.cpp>
 #include <ripple/app/tests/AmendmentTable.test.cpp>
 #include <ripple/app/tests/Asset.test.cpp>
+#include <ripple/app/tests/BookIndex_test.cpp>
 #include <ripple/app/tests/CrossingLimits_test.cpp>
 #include <ripple/app/tests/DeliverMin.test.cpp>
 #include <ripple/app/tests/HashRouter_test.cpp>
+#include <ripple/app/tests/LedgerPersister.test.cpp>
 #include <ripple/app/tests/MultiSign.test.cpp>
 #include <ripple/app/tests/OfferStream.test.cpp>
 #include <ripple/app/tests/Offer.test.cpp>
@@ -35,4 +38,5 @@
 #include <ripple/app/tests/SetAuth_test.cpp>
 #include <ripple/app/tests/OversizeMeta_test.cpp>
 #include <ripple/app/tests/Taker.test.cpp>
+#include <ripple/app/tests/TxCheckCache_test.cpp>
 #include <ripple/app/tests/TxQ_test.cpp>
@@ -21,6 +21,8 @@
 
 #include <ripple/app/tx/impl/apply.cpp>
 #include <ripple/app/tx/impl/applySteps.cpp>
+#include <ripple/app/tx/impl/PreclaimCache.cpp>
+#include <ripple/app/tx/impl/TxCheckCache.cpp>
 #include <ripple/app/tx/impl/BookTip.cpp>
 #include <ripple/app/tx/impl/CancelOffer.cpp>
 #include <ripple/app/tx/impl/CancelTicket.cpp>
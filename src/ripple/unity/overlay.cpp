@@ -31,6 +31,8 @@
 
 #include <ripple/overlay/tests/cluster_test.cpp>
 #include <ripple/overlay/tests/manifest_test.cpp>
+#include <ripple/overlay/tests/ReduceRelay.test.cpp>
+#include <ripple/overlay/tests/SendQueue.test.cpp>
 #include <ripple/overlay/tests/short_read.test.cpp>
 #include <ripple/overlay/tests/TMHello.test.cpp>
 
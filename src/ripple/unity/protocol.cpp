@@ -39,7 +39,9 @@
 #include <ripple/protocol/impl/Serializer.cpp>
 #include <ripple/protocol/impl/SField.cpp>
 #include <ripple/protocol/impl/Sign.cpp>
+#include <ripple/protocol/impl/SLEView.cpp>
 #include <ripple/protocol/impl/SOTemplate.cpp>
+#include <ripple/protocol/impl/StreamEvent.cpp>
 #include <ripple/protocol/impl/TER.cpp>
 #include <ripple/protocol/impl/tokens.cpp>
 #include <ripple/protocol/impl/TxFormats.cpp>
@@ -48,6 +50,7 @@
 #include <ripple/protocol/impl/STAccount.cpp>
 #include <ripple/protocol/impl/STArray.cpp>
 #include <ripple/protocol/impl/STAmount.cpp>
+#include <ripple/protocol/impl/STArena.cpp>
 #include <ripple/protocol/impl/STBase.cpp>
 #include <ripple/protocol/impl/STBlob.cpp>
 #include <ripple/protocol/impl/STInteger.cpp>
@@ -71,10 +74,13 @@
 #include <ripple/protocol/tests/PublicKey_test.cpp>
 #include <ripple/protocol/tests/Quality.test.cpp>
 #include <ripple/protocol/tests/RippleAddress.test.cpp>
+#include <ripple/protocol/tests/SLEView.test.cpp>
 #include <ripple/protocol/tests/STAccount.test.cpp>
+#include <ripple/protocol/tests/STArena.test.cpp>
 #include <ripple/protocol/tests/STAmount.test.cpp>
 #include <ripple/protocol/tests/STObject.test.cpp>
 #include <ripple/protocol/tests/STTx.test.cpp>
+#include <ripple/protocol/tests/StreamEvent.test.cpp>
 #include <ripple/protocol/tests/types_test.cpp>
 #include <ripple/protocol/tests/XRPAmount.test.cpp>
 
@@ -86,6 +86,7 @@
 #include <ripple/rpc/handlers/TransactionEntry.cpp>
 #include <ripple/rpc/handlers/Tx.cpp>
 #include <ripple/rpc/handlers/TxHistory.cpp>
+#include <ripple/rpc/handlers/TxQueue.cpp>
 #include <ripple/rpc/handlers/UnlAdd.cpp>
 #include <ripple/rpc/handlers/UnlDelete.cpp>
 #include <ripple/rpc/handlers/UnlList.cpp>
@@ -101,15 +102,19 @@
 
 #include <ripple/rpc/impl/AccountFromString.cpp>
 #include <ripple/rpc/impl/Accounts.cpp>
+#include <ripple/rpc/impl/AsyncIO.cpp>
 #include <ripple/rpc/impl/GetAccountObjects.cpp>
 #include <ripple/rpc/impl/Handler.cpp>
 #include <ripple/rpc/impl/KeypairForSignature.cpp>
 #include <ripple/rpc/impl/LegacyPathFind.cpp>
 #include <ripple/rpc/impl/LookupLedger.cpp>
 #include <ripple/rpc/impl/ParseAccountIds.cpp>
+#include <ripple/rpc/impl/ResultCache.cpp>
 #include <ripple/rpc/impl/TransactionSign.cpp>
 #include <ripple/rpc/impl/RPCVersion.cpp>
 
+#include <ripple/rpc/tests/AsyncIO.test.cpp>
 #include <ripple/rpc/tests/JSONRPC.test.cpp>
 #include <ripple/rpc/tests/KeyGeneration.test.cpp>
+#include <ripple/rpc/tests/ResultCache.test.cpp>
 #include <ripple/rpc/tests/Status.test.cpp>
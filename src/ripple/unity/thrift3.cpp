@@ -20,5 +20,7 @@
 #include <ripple/thrift/gen-cpp/hbase_types.cpp>
 
 #include <ripple/thrift/HBaseLedgerSaver.cpp>
+#include <ripple/thrift/HBaseTxStore.cpp>
+#include <ripple/thrift/tests/HBaseSchema.test.cpp>
 
 #endif
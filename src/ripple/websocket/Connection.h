@@ -86,6 +86,11 @@ public:
 
     void send (Json::Value const& jvObj, bool broadcast);
 
+    void send (Json::Value const& jvObj, std::string const& sObj,
+        bool broadcast) override;
+
+    void sendBinary (std::string const& event, bool broadcast) override;
+
     void disconnect ();
     static void handle_disconnect(weak_connection_ptr c);
 
@@ -373,6 +378,27 @@ void ConnectionImpl <WebSocket>::send (Json::Value const& jvObj, bool broadcast)
         m_handler.send (ptr, jvObj, broadcast);
 }
 
+// The publisher serialized the message once for all its subscribers
+template <class WebSocket>
+void ConnectionImpl <WebSocket>::send (
+    Json::Value const& jvObj, std::string const& sObj, bool broadcast)
+{
+    connection_ptr ptr = m_connection.lock ();
+
+    if (ptr)
+        m_handler.send (ptr, sObj, broadcast);
+}
+
+template <class WebSocket>
+void ConnectionImpl <WebSocket>::sendBinary (
+    std::string const& event, bool broadcast)
+{
+    connection_ptr ptr = m_connection.lock ();
+
+    if (ptr)
+        m_handler.sendBinary (ptr, event, broadcast);
+}
+
 template <class WebSocket>
 void ConnectionImpl <WebSocket>::disconnect ()
 {
@@ -143,6 +143,23 @@ public:
         send (cpClient, to_string (jvObj), broadcast);
     }
 
+    void sendBinary (connection_ptr const& cpClient, std::string const& event,
+               bool broadcast)
+    {
+        try
+        {
+            auto& jm = broadcast ? j_.trace : j_.info;
+            JLOG (jm)
+                    << "Ws:: Sending " << event.size () << " binary bytes";
+
+            WebSocket::sendBinary (*cpClient, event);
+        }
+        catch (std::exception const&)
+        {
+            WebSocket::closeTooSlowClient (*cpClient, crTooSlow);
+        }
+    }
+
     void pingTimer (connection_ptr const& cpClient)
     {
         wsc_ptr ptr;
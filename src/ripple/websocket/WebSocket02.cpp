@@ -53,6 +53,11 @@ bool WebSocket02::isTextMessage (Message const& message)
     return message.get_opcode () == websocketpp_02::frame::opcode::TEXT;
 }
 
+void WebSocket02::sendBinary (Connection& connection, std::string const& data)
+{
+    connection.send (data, websocketpp_02::frame::opcode::BINARY);
+}
+
 using HandlerPtr02 = WebSocket02::HandlerPtr;
 using EndpointPtr02 = WebSocket02::EndpointPtr;
 
@@ -65,6 +65,10 @@ struct WebSocket02
     static
     bool isTextMessage (Message const&);
 
+    /** Send a BINARY message. */
+    static
+    void sendBinary (Connection&, std::string const&);
+
     /** Create a new Handler. */
     static
     HandlerPtr makeHandler (ServerDescription const&);
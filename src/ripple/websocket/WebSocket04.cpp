@@ -52,6 +52,11 @@ bool WebSocket04::isTextMessage (Message const& message)
     return message.get_opcode () == websocketpp::frame::opcode::text;
 }
 
+void WebSocket04::sendBinary (Connection& connection, std::string const& data)
+{
+    connection.send (data, websocketpp::frame::opcode::binary);
+}
+
 using HandlerPtr04 = WebSocket04::HandlerPtr;
 using EndpointPtr04 = WebSocket04::EndpointPtr;
 
@@ -90,6 +90,10 @@ struct WebSocket04
     static
     bool isTextMessage (Message const&);
 
+    /** Send a BINARY message. */
+    static
+    void sendBinary (Connection&, std::string const&);
+
     /** Create a new Handler. */
     static
     HandlerPtr makeHandler (ServerDescription const&);